@@ -220,9 +220,33 @@ bool runtime::event::Manager::is_event_tracing_enabled()
     return s_tracing_enabled;
 }
 
+void runtime::event::Manager::write_events(const vector<string>& events)
+{
+    if (Manager::is_tracing_enabled() && !events.empty())
+    {
+        lock_guard<mutex> lock(Manager::get_mutex());
+
+        ofstream& out = runtime::event::Manager::get_output_stream();
+        if (out.is_open() == false)
+        {
+            runtime::event::Manager::open();
+        }
+        else
+        {
+            out << ",\n";
+        }
+        for (size_t i = 0; i < events.size(); i++)
+        {
+            out << (i == 0 ? "" : ",\n") << events[i];
+        }
+    }
+}
+
 string runtime::event::Manager::get_thread_id()
 {
     thread::id tid = this_thread::get_id();
+    static mutex tid_mutex;
+    lock_guard<mutex> lock(tid_mutex);
     static map<thread::id, string> tid_map;
     auto it = tid_map.find(tid);
     string rc;
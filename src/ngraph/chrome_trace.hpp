@@ -22,6 +22,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 #ifdef _WIN32
 #include <windows.h>
 // windows.h must be before processthreadsapi.h so we need this comment
@@ -88,14 +89,20 @@ public:
     static void disable_event_tracing();
     static bool is_event_tracing_enabled();
 
-private:
-    static std::ofstream& get_output_stream();
-    static const std::string& get_process_id();
+    /// \brief Append events recorded outside of Duration and Object, each one a complete
+    /// chrome trace event object
+    static void write_events(const std::vector<std::string>& events);
+    /// \brief Timestamps of the trace, shared by everything that records events
     static size_t get_current_microseconds()
     {
         return std::chrono::high_resolution_clock::now().time_since_epoch().count() / 1000;
     }
+    static const std::string& get_process_id();
+    /// \brief The "tid" field value of events recorded on the calling thread
     static std::string get_thread_id();
+
+private:
+    static std::ofstream& get_output_stream();
     static std::mutex& get_mutex() { return s_file_mutex; }
     static std::ostream s_ostream;
     static std::mutex s_file_mutex;
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/coordinate.hpp"
 #include "ngraph/coordinate_diff.hpp"
@@ -94,6 +97,43 @@ namespace ngraph
 
         Iterator begin() noexcept { return Iterator(m_target_shape); }
         Iterator end() noexcept { return m_end_iterator; }
+        /// \brief Visits the target coordinates that have a source coordinate, in row-major
+        ///        target order, as runs along the innermost target axis.
+        ///
+        /// Calls f(target_index, source_index, count, source_step) for every run; the target
+        /// coordinates at row-major positions target_index, ..., target_index + count - 1 map
+        /// to the source buffer elements source_index + i * source_step. Offsets are computed
+        /// from per-axis strides and nothing is allocated while walking. Runs cover the whole
+        /// innermost axis unless it is dilated.
+        template <typename F>
+        void for_each_run(const F& f) const
+        {
+            if (m_n_axes == 0)
+            {
+                f(0, 0, 1, 1);
+            }
+            else if (shape_size(m_target_shape) != 0)
+            {
+                walk_axis(0, 0, 0, f);
+            }
+        }
+
+        /// \brief Calls f(target_index, source_index) for every target coordinate that has a
+        ///        source coordinate, in row-major target order.
+        template <typename F>
+        void for_each_offset(const F& f) const
+        {
+            for_each_run([&f](size_t target_index,
+                              size_t source_index,
+                              size_t count,
+                              size_t source_step) {
+                for (size_t i = 0; i < count; i++)
+                {
+                    f(target_index + i, source_index + i * source_step);
+                }
+            });
+        }
+
         size_t index_source(const Coordinate& c) const;
         static Strides default_strides(size_t n_axes);
         static CoordinateDiff default_padding(size_t n_axes);
@@ -113,5 +153,64 @@ namespace ngraph
         Shape m_target_shape;
         size_t m_n_axes;
         Iterator m_end_iterator;
+
+    private:
+        template <typename F>
+        void walk_axis(size_t target_axis,
+                       size_t target_index,
+                       size_t source_index,
+                       const F& f) const
+        {
+            size_t source_axis = m_source_axis_order[target_axis];
+            size_t length = m_target_shape[target_axis];
+            std::ptrdiff_t step = m_source_strides[source_axis];
+            std::ptrdiff_t dilation = m_target_dilation_strides[target_axis];
+            size_t buffer_stride = m_source_buffer_strides[source_axis];
+            bool innermost = target_axis + 1 == m_n_axes;
+
+            // Position in the dilated source axis, valid in [0, limit) on multiples of dilation
+            std::ptrdiff_t pos = static_cast<std::ptrdiff_t>(m_source_start_corner[source_axis]) -
+                                 m_target_padding_below[target_axis];
+            std::ptrdiff_t source_length = m_source_shape[source_axis];
+            std::ptrdiff_t limit = source_length == 0 ? 0 : (source_length - 1) * dilation + 1;
+            target_index *= length;
+
+            if (innermost && dilation == 1)
+            {
+                size_t first = pos < 0 ? static_cast<size_t>((step - 1 - pos) / step) : 0;
+                size_t last = 0;
+                if (pos < limit)
+                {
+                    last = std::min(length, static_cast<size_t>((limit - pos + step - 1) / step));
+                }
+                if (first < last)
+                {
+                    f(target_index + first,
+                      source_index + (pos + first * step) * buffer_stride,
+                      last - first,
+                      step * buffer_stride);
+                }
+                return;
+            }
+
+            for (size_t i = 0; i < length; i++, pos += step)
+            {
+                if (pos < 0 || pos >= limit || pos % dilation != 0)
+                {
+                    continue;
+                }
+                size_t source_offset = source_index + (pos / dilation) * buffer_stride;
+                if (innermost)
+                {
+                    f(target_index + i, source_offset, 1, 1);
+                }
+                else
+                {
+                    walk_axis(target_axis + 1, target_index + i, source_offset, f);
+                }
+            }
+        }
+
+        Strides m_source_buffer_strides;
     };
 }
@@ -14,12 +14,51 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstring>
+#include <limits>
+
 #include "ngraph/cpio.hpp"
 #include "ngraph/log.hpp"
 
 using namespace ngraph;
 using namespace std;
 
+static const char s_v2_magic[8] = {'\x89', 'C', 'P', 'I', 'O', 'v', '2', '\n'};
+static const uint32_t s_v2_version = 2;
+static const uint64_t s_v2_alignment = 4096;
+static const uint64_t s_v2_header_size = 16;
+static const uint64_t s_v2_footer_size = 24;
+
+/// \brief Forwards the data written to a stream to the file started with Writer::begin
+class ngraph::cpio::Writer::FileBuffer : public streambuf
+{
+public:
+    FileBuffer(Writer& writer)
+        : m_writer(writer)
+    {
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            char c = traits_type::to_char_type(ch);
+            m_writer.write(&c, 1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    streamsize xsputn(const char* s, streamsize n) override
+    {
+        m_writer.write(s, static_cast<size_t>(n));
+        return n;
+    }
+
+private:
+    Writer& m_writer;
+};
+
 static uint16_t read_u16(istream& stream, bool big_endian = false)
 {
     uint8_t ch[2];
@@ -50,6 +89,50 @@ static uint32_t read_u32(istream& stream, bool big_endian = false)
     return rc;
 }
 
+static void write_le_u32(ostream& stream, uint32_t value)
+{
+    char bytes[4];
+    for (size_t i = 0; i < sizeof(bytes); ++i)
+    {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    stream.write(bytes, sizeof(bytes));
+}
+
+static void write_le_u64(ostream& stream, uint64_t value)
+{
+    char bytes[8];
+    for (size_t i = 0; i < sizeof(bytes); ++i)
+    {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    stream.write(bytes, sizeof(bytes));
+}
+
+static uint64_t read_le(istream& stream, size_t size)
+{
+    uint8_t bytes[8] = {};
+    stream.read(reinterpret_cast<char*>(bytes), size);
+    uint64_t rc = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        rc |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return rc;
+}
+
+static bool is_v2(istream& in)
+{
+    auto offset = in.tellg();
+    in.seekg(0, ios_base::beg);
+    char magic[sizeof(s_v2_magic)];
+    in.read(magic, sizeof(magic));
+    bool rc = in.gcount() == sizeof(magic) && memcmp(magic, s_v2_magic, sizeof(magic)) == 0;
+    in.clear();
+    in.seekg(offset, ios_base::beg);
+    return rc;
+}
+
 static void write_u16(ostream& stream, uint16_t value)
 {
     const char* p = reinterpret_cast<const char*>(&value);
@@ -133,26 +216,50 @@ void cpio::Header::write(ostream& stream, const string& name, uint32_t size)
     stream.write(name.c_str(), namesize + (namesize % 2));
 }
 
-cpio::Writer::Writer()
+cpio::Writer::Writer(Version version)
     : m_stream(nullptr)
+    , m_version(version)
+    , m_position(0)
+    , m_in_file(false)
 {
 }
 
-cpio::Writer::Writer(ostream& out)
-    : Writer()
+cpio::Writer::Writer(ostream& out, Version version)
+    : Writer(version)
 {
     open(out);
 }
 
-cpio::Writer::Writer(const string& filename)
-    : Writer()
+cpio::Writer::Writer(const string& filename, Version version)
+    : Writer(version)
 {
     open(filename);
 }
 
 cpio::Writer::~Writer()
 {
-    write("TRAILER!!!", nullptr, 0);
+    if (m_version == Version::V1)
+    {
+        write("TRAILER!!!", nullptr, 0);
+    }
+    else if (m_stream)
+    {
+        if (m_in_file)
+        {
+            end();
+        }
+        uint64_t directory_offset = m_position;
+        for (const FileInfo& info : m_directory)
+        {
+            write_le_u64(*m_stream, info.get_offset());
+            write_le_u64(*m_stream, info.get_size());
+            write_le_u32(*m_stream, static_cast<uint32_t>(info.get_name().size()));
+            m_stream->write(info.get_name().data(), info.get_name().size());
+        }
+        write_le_u64(*m_stream, directory_offset);
+        write_le_u64(*m_stream, m_directory.size());
+        m_stream->write(s_v2_magic, sizeof(s_v2_magic));
+    }
     if (m_my_stream.is_open())
     {
         m_my_stream.close();
@@ -162,19 +269,41 @@ cpio::Writer::~Writer()
 void cpio::Writer::open(ostream& out)
 {
     m_stream = &out;
+    if (m_version == Version::V2)
+    {
+        m_stream->write(s_v2_magic, sizeof(s_v2_magic));
+        write_le_u32(*m_stream, s_v2_version);
+        write_le_u32(*m_stream, static_cast<uint32_t>(s_v2_alignment));
+        m_position = s_v2_header_size;
+    }
 }
 
 void cpio::Writer::open(const string& filename)
 {
-    m_stream = &m_my_stream;
     m_my_stream.open(filename, ios_base::binary | ios_base::out);
+    open(m_my_stream);
 }
 
-void cpio::Writer::write(const string& record_name, const void* data, uint32_t size_in_bytes)
+void cpio::Writer::write(const string& record_name, const void* data, size_t size_in_bytes)
 {
-    if (m_stream)
+    if (!m_stream)
     {
-        Header::write(*m_stream, record_name, size_in_bytes);
+        throw runtime_error("cpio writer output not set");
+    }
+    if (m_version == Version::V2)
+    {
+        begin(record_name);
+        write(data, size_in_bytes);
+        end();
+    }
+    else if (size_in_bytes > numeric_limits<uint32_t>::max())
+    {
+        throw runtime_error("cpio file '" + record_name +
+                            "' is larger than 4GB, which needs a version 2 archive");
+    }
+    else
+    {
+        Header::write(*m_stream, record_name, static_cast<uint32_t>(size_in_bytes));
         m_stream->write(static_cast<const char*>(data), size_in_bytes);
         if (size_in_bytes % 2)
         {
@@ -182,10 +311,65 @@ void cpio::Writer::write(const string& record_name, const void* data, uint32_t s
             m_stream->write(&ch, 1);
         }
     }
-    else
+}
+
+ostream& cpio::Writer::begin(const string& file_name)
+{
+    if (!m_stream)
     {
         throw runtime_error("cpio writer output not set");
     }
+    if (m_version != Version::V2)
+    {
+        throw runtime_error("cpio chunked writes need a version 2 archive");
+    }
+    if (m_in_file)
+    {
+        throw runtime_error("cpio file '" + m_directory.back().get_name() + "' not ended");
+    }
+    uint64_t remainder = m_position % s_v2_alignment;
+    write_padding(remainder == 0 ? 0 : s_v2_alignment - remainder);
+    m_directory.emplace_back(file_name, 0, m_position);
+    m_in_file = true;
+    if (!m_file_stream)
+    {
+        m_file_buffer.reset(new FileBuffer(*this));
+        m_file_stream.reset(new ostream(m_file_buffer.get()));
+    }
+    m_file_stream->clear();
+    return *m_file_stream;
+}
+
+void cpio::Writer::write(const void* data, size_t size_in_bytes)
+{
+    if (!m_in_file)
+    {
+        throw runtime_error("cpio write outside of a file");
+    }
+    m_stream->write(static_cast<const char*>(data), size_in_bytes);
+    m_position += size_in_bytes;
+}
+
+void cpio::Writer::end()
+{
+    if (!m_in_file)
+    {
+        throw runtime_error("cpio end outside of a file");
+    }
+    m_in_file = false;
+    FileInfo& info = m_directory.back();
+    info = FileInfo(info.get_name(), m_position - info.get_offset(), info.get_offset());
+}
+
+void cpio::Writer::write_padding(size_t size)
+{
+    static const char zeros[256] = {};
+    m_position += size;
+    for (; size > sizeof(zeros); size -= sizeof(zeros))
+    {
+        m_stream->write(zeros, sizeof(zeros));
+    }
+    m_stream->write(zeros, size);
 }
 
 cpio::Reader::Reader()
@@ -233,52 +417,100 @@ const vector<cpio::FileInfo>& cpio::Reader::get_file_info()
 {
     if (m_file_info.empty())
     {
-        while (*m_stream)
+        if (is_v2(*m_stream))
         {
-            Header header = Header::read(*m_stream);
-
-            auto buffer = new char[header.namesize];
-            m_stream->read(buffer, header.namesize);
-            // namesize includes the null string terminator so -1
-            string file_name = string(buffer, header.namesize - 1);
-            delete[] buffer;
-            // skip any pad characters
-            if (header.namesize % 2)
-            {
-                m_stream->seekg(1, ios_base::cur);
-            }
-
-            if (file_name == "TRAILER!!!")
+            read_directory();
+        }
+        else
+        {
+            while (*m_stream)
             {
-                break;
+                Header header = Header::read(*m_stream);
+
+                auto buffer = new char[header.namesize];
+                m_stream->read(buffer, header.namesize);
+                // namesize includes the null string terminator so -1
+                string file_name = string(buffer, header.namesize - 1);
+                delete[] buffer;
+                // skip any pad characters
+                if (header.namesize % 2)
+                {
+                    m_stream->seekg(1, ios_base::cur);
+                }
+
+                if (file_name == "TRAILER!!!")
+                {
+                    break;
+                }
+
+                size_t offset = m_stream->tellg();
+                m_file_info.emplace_back(file_name, header.filesize, offset);
+
+                m_stream->seekg((header.filesize % 2) + header.filesize, ios_base::cur);
             }
+        }
+        for (size_t i = 0; i < m_file_info.size(); ++i)
+        {
+            m_file_index.insert({m_file_info[i].get_name(), i});
+        }
+    }
 
-            size_t offset = m_stream->tellg();
-            m_file_info.emplace_back(file_name, header.filesize, offset);
+    return m_file_info;
+}
+void cpio::Reader::read_directory()
+{
+    m_stream->seekg(0, ios_base::end);
+    uint64_t size = m_stream->tellg();
+    if (size < s_v2_header_size + s_v2_footer_size)
+    {
+        throw runtime_error("CPIO invalid file");
+    }
+    m_stream->seekg(size - s_v2_footer_size, ios_base::beg);
+    uint64_t directory_offset = read_le(*m_stream, 8);
+    uint64_t count = read_le(*m_stream, 8);
+    char magic[sizeof(s_v2_magic)];
+    m_stream->read(magic, sizeof(magic));
+    if (!*m_stream || memcmp(magic, s_v2_magic, sizeof(magic)) != 0 ||
+        directory_offset > size - s_v2_footer_size)
+    {
+        throw runtime_error("CPIO invalid file");
+    }
 
-            m_stream->seekg((header.filesize % 2) + header.filesize, ios_base::cur);
+    m_stream->seekg(directory_offset, ios_base::beg);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        uint64_t offset = read_le(*m_stream, 8);
+        uint64_t file_size = read_le(*m_stream, 8);
+        string file_name(read_le(*m_stream, 4), '\0');
+        m_stream->read(&file_name[0], file_name.size());
+        if (!*m_stream || offset > directory_offset || file_size > directory_offset - offset)
+        {
+            throw runtime_error("CPIO invalid file");
         }
+        m_file_info.emplace_back(file_name, file_size, offset);
     }
+}
 
-    return m_file_info;
+const cpio::FileInfo* cpio::Reader::find(const string& file_name)
+{
+    get_file_info();
+    auto it = m_file_index.find(file_name);
+    return it == m_file_index.end() ? nullptr : &m_file_info[it->second];
 }
 
 bool cpio::Reader::read(const string& file_name, void* data, size_t size_in_bytes)
 {
     bool rc = false;
-    for (const FileInfo& info : get_file_info())
+    if (const FileInfo* info = find(file_name))
     {
-        if (info.get_name() == file_name)
+        if (size_in_bytes != info->get_size())
         {
-            if (size_in_bytes != info.get_size())
-            {
-                throw runtime_error("Buffer size does not match file size");
-            }
-            m_stream->seekg(info.get_offset(), ios_base::beg);
-            m_stream->read(reinterpret_cast<char*>(data), size_in_bytes);
-            rc = true;
-            break;
+            throw runtime_error("Buffer size does not match file size");
         }
+        m_stream->clear();
+        m_stream->seekg(info->get_offset(), ios_base::beg);
+        m_stream->read(reinterpret_cast<char*>(data), size_in_bytes);
+        rc = true;
     }
     return rc;
 }
@@ -298,6 +530,10 @@ bool cpio::is_cpio(const string& path)
 
 bool cpio::is_cpio(istream& in)
 {
+    if (is_v2(in))
+    {
+        return true;
+    }
     size_t offset = in.tellg();
     in.seekg(0, ios_base::beg);
     bool rc = false;
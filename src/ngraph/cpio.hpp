@@ -18,11 +18,19 @@
 
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // The CPIO file format can be found at
 // https://www.mkssoftware.com/docs/man4/cpio.4.asp
+//
+// Version 2 archives are not cpio compatible. They start with a 16 byte header, each file's
+// data starts on a 4096 byte boundary so a mapped archive can be used in place, and a
+// directory of 64-bit offsets and sizes at the end of the archive allows files of any size
+// and lookup by name without scanning the archive. The directory is written last, so files
+// can be written in chunks without knowing their size up front.
 
 namespace ngraph
 {
@@ -33,6 +41,12 @@ namespace ngraph
         class Writer;
         class Reader;
 
+        enum class Version
+        {
+            V1,
+            V2
+        };
+
         bool is_cpio(const std::string&);
         bool is_cpio(std::istream&);
     }
@@ -81,18 +95,37 @@ private:
 class ngraph::cpio::Writer
 {
 public:
-    Writer();
-    Writer(std::ostream& out);
-    Writer(const std::string& filename);
+    Writer(Version version = Version::V1);
+    Writer(std::ostream& out, Version version = Version::V1);
+    Writer(const std::string& filename, Version version = Version::V1);
     ~Writer();
 
     void open(std::ostream& out);
     void open(const std::string& filename);
-    void write(const std::string& file_name, const void* data, uint32_t size_in_bytes);
+    void write(const std::string& file_name, const void* data, size_t size_in_bytes);
+
+    /// \brief Start a file whose data is written in chunks, either with write(data, size) or
+    ///    through the returned stream, and ended with end(). Version 2 archives only.
+    /// \param file_name The name of the file in the archive
+    std::ostream& begin(const std::string& file_name);
+    /// \brief Append a chunk of data to the file started with begin()
+    void write(const void* data, size_t size_in_bytes);
+    /// \brief End the file started with begin()
+    void end();
 
 private:
+    class FileBuffer;
+
+    void write_padding(size_t size);
+
     std::ostream* m_stream;
     std::ofstream m_my_stream;
+    Version m_version;
+    uint64_t m_position;
+    std::vector<FileInfo> m_directory;
+    bool m_in_file;
+    std::unique_ptr<FileBuffer> m_file_buffer;
+    std::unique_ptr<std::ostream> m_file_stream;
 };
 
 class ngraph::cpio::Reader
@@ -107,11 +140,17 @@ public:
     void open(const std::string& filename);
     void close();
     const std::vector<FileInfo>& get_file_info();
+    /// \brief Find a file by name
+    /// \return The file's info or nullptr if the archive does not hold the file
+    const FileInfo* find(const std::string& file_name);
     bool read(const std::string& file_name, void* data, size_t size_in_bytes);
     std::vector<char> read(const FileInfo& info);
 
 private:
+    void read_directory();
+
     std::istream* m_stream;
     std::ifstream m_my_stream;
     std::vector<cpio::FileInfo> m_file_info;
+    std::unordered_map<std::string, size_t> m_file_index;
 };
@@ -299,6 +299,24 @@ op::Constant::Constant(const element::Type& type, const Shape& shape, const void
     m_all_elements_bitwise_identical = are_all_data_elements_bitwise_identical();
 }
 
+op::Constant::Constant(const element::Type& type,
+                       const Shape& shape,
+                       const shared_ptr<runtime::AlignedBuffer>& data)
+    : m_element_type(type)
+    , m_shape(shape)
+    , m_data(data)
+{
+    NGRAPH_CHECK(m_data->size() >= shape_size(m_shape) * m_element_type.size(),
+                 "Constant buffer of ",
+                 m_data->size(),
+                 " bytes is too small for ",
+                 m_element_type,
+                 " ",
+                 m_shape);
+    constructor_validate_and_infer_types();
+    m_all_elements_bitwise_identical = are_all_data_elements_bitwise_identical();
+}
+
 op::Constant::Constant(const Constant& other)
     : m_element_type(other.m_element_type)
     , m_shape(other.m_shape)
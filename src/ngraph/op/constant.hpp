@@ -93,6 +93,16 @@ namespace ngraph
                 /// \param data A void* to constant data.
                 Constant(const element::Type& type, const Shape& shape, const void* data);
 
+                /// \brief Constructs a tensor constant that refers to existing data rather than
+                ///        copying it, e.g. a runtime::SharedBuffer over a memory mapped file.
+                ///
+                /// \param type The element type of the tensor constant.
+                /// \param shape The shape of the tensor constant.
+                /// \param data The buffer holding the constant data.
+                Constant(const element::Type& type,
+                         const Shape& shape,
+                         const std::shared_ptr<runtime::AlignedBuffer>& data);
+
                 Constant(const Constant& other);
 
                 virtual ~Constant() override;
@@ -280,6 +290,12 @@ namespace ngraph
                 }
 
                 const void* get_data_ptr() const { return (m_data ? m_data->get_ptr() : nullptr); }
+                /// \brief The buffer holding the constant's data, which may be shared with other
+                ///        Constants. The data must not be modified.
+                const std::shared_ptr<runtime::AlignedBuffer>& get_data_buffer() const
+                {
+                    return m_data;
+                }
                 template <typename T>
                 const T* get_data_ptr() const
                 {
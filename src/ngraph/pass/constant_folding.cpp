@@ -14,7 +14,17 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
 #include "constant_folding.hpp"
+#include "ngraph/env_util.hpp"
+#include "ngraph/op/constant.hpp"
+#include "ngraph/op/parameter.hpp"
+#include "ngraph/op/result.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -31,3 +41,327 @@ bool ngraph::pass::revalidate_and_ensure_static(shared_ptr<Node> n)
     }
     return true;
 }
+
+size_t pass::ConstantFolding::get_default_max_folded_bytes()
+{
+    static const int32_t max_mb = getenv_int("NGRAPH_CONSTANT_FOLDING_MAX_MB", 0);
+    return max_mb > 0 ? static_cast<size_t>(max_mb) << 20 : 0;
+}
+
+size_t pass::ConstantFolding::get_default_num_threads()
+{
+    // The threads are started on every run, so by default only a few of them
+    static const size_t max_default_threads = 4;
+    static const size_t num_threads = []() -> size_t {
+        int32_t env_threads = getenv_int("NGRAPH_CONSTANT_FOLDING_THREADS");
+        if (env_threads >= 0)
+        {
+            return env_threads;
+        }
+        int32_t intra_op_threads = getenv_int("NGRAPH_INTRA_OP_PARALLELISM");
+        size_t available =
+            intra_op_threads > 0 ? intra_op_threads : thread::hardware_concurrency();
+        return max<size_t>(1, min(available, max_default_threads));
+    }();
+    return num_threads;
+}
+
+shared_ptr<pass::ConstantRegistry> pass::ConstantFolding::get_default_constant_registry()
+{
+    static shared_ptr<ConstantRegistry> registry = make_shared<ConstantRegistry>();
+    return registry;
+}
+
+void pass::ConstantFolding::add_matcher(const shared_ptr<pattern::Matcher>& m,
+                                        const graph_rewrite_callback& callback,
+                                        const PassPropertyMask& property)
+{
+    auto budgeted_callback = [this, callback](pattern::Matcher& matcher) {
+        if (m_max_folded_bytes > 0)
+        {
+            size_t folded_bytes = 0;
+            for (auto& output : matcher.get_match_root()->outputs())
+            {
+                if (output.get_partial_shape().is_static() &&
+                    output.get_element_type().is_static())
+                {
+                    folded_bytes +=
+                        shape_size(output.get_shape()) * output.get_element_type().size();
+                }
+            }
+            if (folded_bytes > m_max_folded_bytes)
+            {
+                NGRAPH_DEBUG << "Not folding " << matcher.get_match_root()->get_name()
+                             << ", its result needs " << folded_bytes << " bytes";
+                return false;
+            }
+        }
+        return callback(matcher);
+    };
+    GraphRewrite::add_matcher(m, budgeted_callback, property);
+}
+
+void pass::ConstantFolding::add_matcher(const shared_ptr<pattern::Matcher>& m,
+                                        const graph_rewrite_callback& callback)
+{
+    add_matcher(m, callback, {PassProperty::REQUIRE_STATIC_SHAPE});
+}
+
+bool pass::ConstantFolding::run_on_function(shared_ptr<Function> f)
+{
+    unordered_set<Node*> original_constants;
+    for (auto& node : f->get_ops())
+    {
+        if (node->is_constant())
+        {
+            original_constants.insert(node.get());
+        }
+    }
+
+    bool rewritten = fold_independent_subgraphs(f);
+    // Picks up whatever the subgraphs left, e.g. ShapeOf of non-constant values, and everything
+    // when folding in parallel is not worthwhile
+    rewritten = GraphRewrite::run_on_function(f) || rewritten;
+    share_folded_constants(f, original_constants);
+    return rewritten;
+}
+
+namespace
+{
+    // Nodes computed from constants only, which are connected through nodes of the same kind
+    struct FoldTask
+    {
+        NodeVector nodes;
+        // Outputs of nodes used outside the subgraph, and the Results they became in the clone
+        vector<Output<Node>> boundary;
+        ResultVector results;
+        shared_ptr<Function> clone;
+        bool failed = false;
+    };
+}
+
+// Independent subgraphs are cloned into Functions of their own and folded by separate
+// ConstantFolding instances, since matchers are stateful. Results that fold to a Constant are
+// then spliced back into f.
+bool pass::ConstantFolding::fold_independent_subgraphs(const shared_ptr<Function>& f)
+{
+    size_t num_threads = m_num_threads == 0 ? thread::hardware_concurrency() : m_num_threads;
+    if (num_threads <= 1)
+    {
+        return false;
+    }
+
+    NodeVector ops = f->get_ordered_ops();
+    unordered_map<Node*, size_t> candidate_index;
+    vector<size_t> parent;
+    auto find_root = [&](size_t i) {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    for (auto& node : ops)
+    {
+        if (node->is_constant() || node->is_parameter() || node->is_output() ||
+            node->get_input_size() == 0 || !node->get_control_dependencies().empty() ||
+            !node->get_control_dependents().empty())
+        {
+            continue;
+        }
+        vector<size_t> input_candidates;
+        bool foldable = true;
+        for (auto& input : node->input_values())
+        {
+            Node* input_node = input.get_node();
+            auto it = candidate_index.find(input_node);
+            if (it != candidate_index.end())
+            {
+                input_candidates.push_back(it->second);
+            }
+            else if (!input_node->is_constant())
+            {
+                foldable = false;
+                break;
+            }
+        }
+        if (foldable)
+        {
+            size_t index = parent.size();
+            parent.push_back(index);
+            candidate_index[node.get()] = index;
+            for (size_t input_index : input_candidates)
+            {
+                parent[find_root(input_index)] = find_root(index);
+            }
+        }
+    }
+
+    unordered_map<size_t, size_t> task_index;
+    vector<FoldTask> tasks;
+    for (auto& node : ops)
+    {
+        auto it = candidate_index.find(node.get());
+        if (it != candidate_index.end())
+        {
+            size_t root = find_root(it->second);
+            if (task_index.count(root) == 0)
+            {
+                task_index[root] = tasks.size();
+                tasks.emplace_back();
+            }
+            tasks[task_index[root]].nodes.push_back(node);
+        }
+    }
+    if (tasks.size() < 2)
+    {
+        return false;
+    }
+
+    for (FoldTask& task : tasks)
+    {
+        unordered_map<Node*, shared_ptr<Node>> clones;
+        for (auto& node : task.nodes)
+        {
+            OutputVector inputs;
+            for (auto& input : node->input_values())
+            {
+                Node* input_node = input.get_node();
+                if (clones.count(input_node) == 0)
+                {
+                    // Copies of a Constant share its data
+                    clones[input_node] =
+                        make_shared<op::Constant>(*static_cast<op::Constant*>(input_node));
+                    clones[input_node]->add_provenance_tags(input_node->get_provenance_tags());
+                }
+                inputs.push_back(Output<Node>(clones[input_node], input.get_index()));
+            }
+            // Tags are carried into the clone so that the folded constants collect them the
+            // way replace_node would have on f
+            shared_ptr<Node> clone = node->copy_with_new_inputs(inputs);
+            clone->add_provenance_tags(node->get_provenance_tags());
+            clones[node.get()] = clone;
+            for (auto& output : node->outputs())
+            {
+                for (auto& target : output.get_target_inputs())
+                {
+                    auto it = candidate_index.find(target.get_node());
+                    if (it == candidate_index.end() ||
+                        find_root(it->second) != find_root(candidate_index[node.get()]))
+                    {
+                        task.boundary.push_back(output);
+                        task.results.push_back(
+                            make_shared<op::Result>(Output<Node>(clone, output.get_index())));
+                        break;
+                    }
+                }
+            }
+        }
+        task.clone = make_shared<Function>(task.results, ParameterVector{});
+    }
+
+    atomic<size_t> next_task{0};
+    atomic<size_t> worker_rewrites{0};
+    auto fold_tasks = [&]() {
+        ConstantFolding folding(m_transformations, m_cfmap);
+        folding.m_enable_shape_inference = m_enable_shape_inference;
+        folding.m_max_folded_bytes = m_max_folded_bytes;
+        for (size_t i = next_task++; i < tasks.size(); i = next_task++)
+        {
+            try
+            {
+                folding.GraphRewrite::run_on_function(tasks[i].clone);
+            }
+            catch (...)
+            {
+                // Folded again on f by the caller, which reports the error where it belongs
+                tasks[i].failed = true;
+            }
+        }
+        worker_rewrites += folding.get_rewrite_count();
+    };
+    vector<thread> threads;
+    for (size_t i = 1; i < min(num_threads, tasks.size()); i++)
+    {
+        threads.emplace_back(fold_tasks);
+    }
+    fold_tasks();
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    count_rewrites(worker_rewrites);
+
+    bool rewritten = false;
+    for (FoldTask& task : tasks)
+    {
+        for (size_t i = 0; i < task.boundary.size() && !task.failed; i++)
+        {
+            auto folded = as_type_ptr<op::Constant>(task.results[i]->get_argument(0));
+            if (folded)
+            {
+                auto replacement = make_shared<op::Constant>(*folded);
+                replacement->merge_provenance_tags_from(folded);
+                task.boundary[i].replace(replacement->output(0));
+                rewritten = true;
+            }
+        }
+    }
+    return rewritten;
+}
+
+// Identical folded constants become one node within f, and share their data through the
+// registry with identical constants folded in other Functions, for as long as any of them lives.
+void pass::ConstantFolding::share_folded_constants(const shared_ptr<Function>& f,
+                                                   const unordered_set<Node*>& original_constants)
+{
+    unordered_multimap<size_t, shared_ptr<op::Constant>> folded;
+    for (auto& node : f->get_ordered_ops())
+    {
+        auto constant = as_type_ptr<op::Constant>(node);
+        if (!constant || original_constants.count(node.get()) != 0 ||
+            !constant->get_data_buffer())
+        {
+            continue;
+        }
+        size_t size = shape_size(constant->get_shape()) * constant->get_element_type().size();
+        if (size == 0)
+        {
+            continue;
+        }
+        size_t hash = ConstantRegistry::hash_data(*constant);
+
+        bool merged = false;
+        auto range = folded.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            const shared_ptr<op::Constant>& other = it->second;
+            if (other->get_element_type() == constant->get_element_type() &&
+                other->get_shape() == constant->get_shape() &&
+                memcmp(other->get_data_ptr(), constant->get_data_ptr(), size) == 0)
+            {
+                replace_node(constant, other);
+                merged = true;
+                break;
+            }
+        }
+        if (merged)
+        {
+            continue;
+        }
+
+        if (m_constant_registry)
+        {
+            auto buffer = m_constant_registry->intern(*constant, hash);
+            if (buffer != constant->get_data_buffer())
+            {
+                auto replacement = make_shared<op::Constant>(
+                    constant->get_element_type(), constant->get_shape(), buffer);
+                replace_node(constant, replacement);
+                constant = replacement;
+            }
+        }
+        folded.insert({hash, constant});
+    }
+}
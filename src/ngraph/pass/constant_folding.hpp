@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_set>
+
 #include "ngraph/log.hpp"
+#include "ngraph/pass/cse.hpp"
 #include "ngraph/pass/graph_rewrite.hpp"
-#include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/util.hpp"
 
 namespace ngraph
@@ -70,35 +73,38 @@ public:
     {
         m_cfmap = cfmap;
         m_enable_shape_inference = true;
-
-        construct_constant_split();
-        construct_constant_variadic_split();
-        construct_constant_reshape();
-        construct_constant_broadcast();
-        construct_constant_dyn_broadcast();
-        construct_constant_pad();
-        construct_constant_unary();
-        construct_constant_binary();
-        construct_constant_quantize();
-        construct_constant_dequantize();
-        construct_constant_convert();
-        construct_constant_shape_of();
-        construct_constant_reverse();
-        construct_constant_arithmetic_reduction();
-        construct_constant_logical_reduction();
-        construct_constant_concat();
-        construct_constant_gather();
-        construct_constant_slice();
-        construct_constant_dyn_slice();
-        construct_constant_strided_slice();
-        construct_constant_dyn_reshape();
-        construct_constant_transpose();
-        construct_constant_range();
-        construct_constant_select();
-        construct_constant_squeeze();
-        construct_constant_unsqueeze();
-        construct_constant_one_hot();
-        construct_constant_tile();
+        m_transformations = {CFTransformations::SPLIT,
+                             CFTransformations::VARIADIC_SPLIT,
+                             CFTransformations::RESHAPE,
+                             CFTransformations::BROADCAST,
+                             CFTransformations::DYN_BROADCAST,
+                             CFTransformations::PAD,
+                             CFTransformations::UNARY,
+                             CFTransformations::BINARY,
+                             CFTransformations::QUANTIZE,
+                             CFTransformations::DEQUANTIZE,
+                             CFTransformations::CONVERT,
+                             CFTransformations::SHAPE_OF,
+                             CFTransformations::REVERSE,
+                             CFTransformations::ARITHMETIC_REDUCTION,
+                             CFTransformations::LOGICAL_REDUCTION,
+                             CFTransformations::CONCAT,
+                             CFTransformations::GATHER,
+                             CFTransformations::SLICE,
+                             CFTransformations::DYN_SLICE,
+                             CFTransformations::STRIDED_SLICE,
+                             CFTransformations::DYN_RESHAPE,
+                             CFTransformations::TRANSPOSE,
+                             CFTransformations::RANGE,
+                             CFTransformations::SELECT,
+                             CFTransformations::SQUEEZE,
+                             CFTransformations::UNSQUEEZE,
+                             CFTransformations::ONE_HOT,
+                             CFTransformations::TILE};
+        for (auto cft : m_transformations)
+        {
+            construct_transformation(cft);
+        }
     }
 
     // this allows to specify the order in which matchers will be run
@@ -108,46 +114,83 @@ public:
         : GraphRewrite()
     {
         m_cfmap = cfmap;
-        for (auto cft : transformations)
+        m_transformations = transformations;
+        for (auto cft : m_transformations)
         {
-            switch (cft)
-            {
-            case CFTransformations::RESHAPE: construct_constant_reshape(); break;
-            case CFTransformations::BROADCAST: construct_constant_broadcast(); break;
-            case CFTransformations::DYN_BROADCAST: construct_constant_dyn_broadcast(); break;
-            case CFTransformations::PAD: construct_constant_pad(); break;
-            case CFTransformations::UNARY: construct_constant_unary(); break;
-            case CFTransformations::BINARY: construct_constant_binary(); break;
-            case CFTransformations::DEQUANTIZE: construct_constant_dequantize(); break;
-            case CFTransformations::QUANTIZE: construct_constant_quantize(); break;
-            case CFTransformations::CONVERT: construct_constant_convert(); break;
-            case CFTransformations::SHAPE_OF: construct_constant_shape_of(); break;
-            case CFTransformations::REVERSE: construct_constant_reverse(); break;
-            case CFTransformations::ARITHMETIC_REDUCTION:
-                construct_constant_arithmetic_reduction();
-                break;
-            case CFTransformations::LOGICAL_REDUCTION:
-                construct_constant_logical_reduction();
-                break;
-            case CFTransformations::CONCAT: construct_constant_concat(); break;
-            case CFTransformations::GATHER: construct_constant_gather(); break;
-            case CFTransformations::SLICE: construct_constant_slice(); break;
-            case CFTransformations::DYN_SLICE: construct_constant_dyn_slice(); break;
-            case CFTransformations::STRIDED_SLICE: construct_constant_strided_slice(); break;
-            case CFTransformations::DYN_RESHAPE: construct_constant_dyn_reshape(); break;
-            case CFTransformations::TRANSPOSE: construct_constant_transpose(); break;
-            case CFTransformations::RANGE: construct_constant_range(); break;
-            case CFTransformations::SELECT: construct_constant_select(); break;
-            case CFTransformations::SQUEEZE: construct_constant_squeeze(); break;
-            case CFTransformations::UNSQUEEZE: construct_constant_unsqueeze(); break;
-            case CFTransformations::SPLIT: construct_constant_split(); break;
-            case CFTransformations::VARIADIC_SPLIT: construct_constant_variadic_split(); break;
-            case CFTransformations::ONE_HOT: construct_constant_one_hot(); break;
-            case CFTransformations::TILE: construct_constant_tile(); break;
-            }
+            construct_transformation(cft);
         }
     }
 
+    /// \brief Folds whose results would need more than max_bytes are skipped, so that e.g. a
+    ///        broadcast to a huge shape stays a broadcast. 0, the default, means no limit.
+    ///        Defaults to NGRAPH_CONSTANT_FOLDING_MAX_MB megabytes when that is set.
+    void set_max_folded_bytes(size_t max_bytes) { m_max_folded_bytes = max_bytes; }
+    /// \brief Number of threads used to fold independent constant subgraphs. 1 folds
+    ///        everything on the calling thread and 0 uses one per core. Defaults to
+    ///        NGRAPH_CONSTANT_FOLDING_THREADS when that is set, and otherwise to
+    ///        NGRAPH_INTRA_OP_PARALLELISM or the number of cores, but at most 4.
+    void set_num_threads(size_t num_threads) { m_num_threads = num_threads; }
+    /// \brief Registry the data of folded constants is interned in, so identical folded
+    ///        constants of different Functions, e.g. on recompiles, share their data. Defaults
+    ///        to one registry for the whole process.
+    void set_constant_registry(const std::shared_ptr<ConstantRegistry>& registry)
+    {
+        m_constant_registry = registry;
+    }
+    bool run_on_function(std::shared_ptr<ngraph::Function> f) override;
+
+private:
+    void construct_transformation(CFTransformations cft)
+    {
+        switch (cft)
+        {
+        case CFTransformations::RESHAPE: construct_constant_reshape(); break;
+        case CFTransformations::BROADCAST: construct_constant_broadcast(); break;
+        case CFTransformations::DYN_BROADCAST: construct_constant_dyn_broadcast(); break;
+        case CFTransformations::PAD: construct_constant_pad(); break;
+        case CFTransformations::UNARY: construct_constant_unary(); break;
+        case CFTransformations::BINARY: construct_constant_binary(); break;
+        case CFTransformations::DEQUANTIZE: construct_constant_dequantize(); break;
+        case CFTransformations::QUANTIZE: construct_constant_quantize(); break;
+        case CFTransformations::CONVERT: construct_constant_convert(); break;
+        case CFTransformations::SHAPE_OF: construct_constant_shape_of(); break;
+        case CFTransformations::REVERSE: construct_constant_reverse(); break;
+        case CFTransformations::ARITHMETIC_REDUCTION:
+            construct_constant_arithmetic_reduction();
+            break;
+        case CFTransformations::LOGICAL_REDUCTION: construct_constant_logical_reduction(); break;
+        case CFTransformations::CONCAT: construct_constant_concat(); break;
+        case CFTransformations::GATHER: construct_constant_gather(); break;
+        case CFTransformations::SLICE: construct_constant_slice(); break;
+        case CFTransformations::DYN_SLICE: construct_constant_dyn_slice(); break;
+        case CFTransformations::STRIDED_SLICE: construct_constant_strided_slice(); break;
+        case CFTransformations::DYN_RESHAPE: construct_constant_dyn_reshape(); break;
+        case CFTransformations::TRANSPOSE: construct_constant_transpose(); break;
+        case CFTransformations::RANGE: construct_constant_range(); break;
+        case CFTransformations::SELECT: construct_constant_select(); break;
+        case CFTransformations::SQUEEZE: construct_constant_squeeze(); break;
+        case CFTransformations::UNSQUEEZE: construct_constant_unsqueeze(); break;
+        case CFTransformations::SPLIT: construct_constant_split(); break;
+        case CFTransformations::VARIADIC_SPLIT: construct_constant_variadic_split(); break;
+        case CFTransformations::ONE_HOT: construct_constant_one_hot(); break;
+        case CFTransformations::TILE: construct_constant_tile(); break;
+        }
+    }
+
+    // Hide GraphRewrite::add_matcher so every folding callback is checked against the budget
+    void add_matcher(const std::shared_ptr<pattern::Matcher>& m,
+                     const ngraph::graph_rewrite_callback& callback,
+                     const PassPropertyMask& property);
+    void add_matcher(const std::shared_ptr<pattern::Matcher>& m,
+                     const ngraph::graph_rewrite_callback& callback);
+
+    static size_t get_default_max_folded_bytes();
+    static size_t get_default_num_threads();
+    static std::shared_ptr<ConstantRegistry> get_default_constant_registry();
+    bool fold_independent_subgraphs(const std::shared_ptr<ngraph::Function>& f);
+    void share_folded_constants(const std::shared_ptr<ngraph::Function>& f,
+                                const std::unordered_set<Node*>& original_constants);
+
 private:
     void construct_constant_reshape();
     void construct_constant_broadcast();
@@ -179,4 +222,8 @@ private:
     void construct_constant_tile();
 
     ngraph::BuildNodeExecutorMap m_cfmap;
+    std::vector<CFTransformations> m_transformations;
+    size_t m_max_folded_bytes = get_default_max_folded_bytes();
+    size_t m_num_threads = get_default_num_threads();
+    std::shared_ptr<ConstantRegistry> m_constant_registry = get_default_constant_registry();
 };
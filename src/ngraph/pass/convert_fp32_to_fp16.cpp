@@ -35,12 +35,9 @@ void pass::ConvertFP32ToFP16::convert_constants_precision()
 
         if (constant->get_element_type() == element::f32)
         {
-            auto data = constant->get_vector<float>();
-            std::vector<ngraph::float16> new_data(data.size());
-            for (size_t i = 0; i < data.size(); ++i)
-            {
-                new_data[i] = ngraph::float16(data[i]);
-            }
+            std::vector<ngraph::float16> new_data(shape_size(constant->get_shape()));
+            ngraph::float16::from_float(
+                constant->get_data_ptr<float>(), new_data.data(), new_data.size());
             auto new_const = std::make_shared<ngraph::op::Constant>(
                 element::f16, constant->get_shape(), new_data);
             new_const->set_friendly_name(constant->get_friendly_name());
@@ -14,12 +14,16 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <typeinfo>
 #include <unordered_map>
 
 #include "cse.hpp"
+#include "ngraph/attribute_visitor.hpp"
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
@@ -60,6 +64,7 @@
 #include "ngraph/op/tan.hpp"
 #include "ngraph/op/tanh.hpp"
 #include "ngraph/pattern/matcher.hpp"
+#include "ngraph/util.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -321,3 +326,344 @@ bool ngraph::pass::CommonSubexpressionElimination::run_on_function(shared_ptr<ng
 
     return replaced;
 }
+
+static size_t get_data_size(const op::Constant& constant)
+{
+    return shape_size(constant.get_shape()) * constant.get_element_type().size();
+}
+
+size_t pass::ConstantRegistry::hash_data(const op::Constant& constant)
+{
+    // Weights can be large, so mix eight bytes at a time
+    const char* data = static_cast<const char*>(constant.get_data_ptr());
+    size_t size = get_data_size(constant);
+    uint64_t hash = 0x9e3779b97f4a7c15ULL ^ size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; ++i)
+    {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 0x100000001b3ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+shared_ptr<runtime::AlignedBuffer> pass::ConstantRegistry::intern(const op::Constant& constant,
+                                                                  size_t content_hash)
+{
+    const shared_ptr<runtime::AlignedBuffer>& own_buffer = constant.get_data_buffer();
+    size_t size = get_data_size(constant);
+    lock_guard<mutex> guard(m_mutex);
+    auto range = m_entries.equal_range(content_hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        shared_ptr<runtime::AlignedBuffer> buffer = it->second.m_buffer.lock();
+        if (buffer && it->second.m_size == size &&
+            (buffer == own_buffer || memcmp(buffer->get_ptr(), own_buffer->get_ptr(), size) == 0))
+        {
+            return buffer;
+        }
+    }
+
+    // Drop the entries of buffers that died, amortized over the insertions
+    if (m_entries.size() >= m_next_sweep)
+    {
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            it = it->second.m_buffer.expired() ? m_entries.erase(it) : next(it);
+        }
+        m_next_sweep = max<size_t>(64, 2 * m_entries.size());
+    }
+    m_entries.insert({content_hash, Entry{own_buffer, size}});
+    return own_buffer;
+}
+
+size_t pass::ConstantRegistry::size() const
+{
+    lock_guard<mutex> guard(m_mutex);
+    size_t count = 0;
+    for (auto& entry : m_entries)
+    {
+        if (!entry.second.m_buffer.expired())
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+namespace
+{
+    /// \brief Flattens the attributes of a node into a string that is equal for two nodes
+    ///        exactly when their attributes are.
+    class AttributeRecorder : public AttributeVisitor
+    {
+    public:
+        AttributeRecorder(Node& node)
+        {
+            // visit_attributes returns false for ops that do not describe their attributes
+            m_complete = node.visit_attributes(*this) && m_complete;
+        }
+
+        bool is_complete() const { return m_complete; }
+        const string& get_record() const { return m_record; }
+        void on_attribute(const string& name, string& value) override { record(name, value); }
+        void on_attribute(const string& name, bool& value) override
+        {
+            record(name, value ? "1" : "0");
+        }
+        void on_adapter(const string& name, ValueAccessor<void>& adapter) override
+        {
+            const DiscreteTypeInfo& type_info = adapter.get_type_info();
+            stringstream ss;
+            if (type_info == AttributeAdapter<element::Type>::type_info)
+            {
+                ss << static_cast<element::Type&>(
+                    static_cast<AttributeAdapter<element::Type>&>(adapter));
+            }
+            else if (type_info == AttributeAdapter<PartialShape>::type_info)
+            {
+                ss << static_cast<PartialShape&>(
+                    static_cast<AttributeAdapter<PartialShape>&>(adapter));
+            }
+            else if (type_info == AttributeAdapter<op::AutoBroadcastSpec>::type_info)
+            {
+                const op::AutoBroadcastSpec& spec = static_cast<op::AutoBroadcastSpec&>(
+                    static_cast<AttributeAdapter<op::AutoBroadcastSpec>&>(adapter));
+                ss << static_cast<int>(spec.m_type) << "," << spec.m_axis;
+            }
+            else
+            {
+                m_complete = false;
+            }
+            record(name, ss.str());
+        }
+        void on_adapter(const string& name, ValueAccessor<string>& adapter) override
+        {
+            record(name, adapter.get());
+        }
+        void on_adapter(const string& name, ValueAccessor<vector<int64_t>>& adapter) override
+        {
+            stringstream ss;
+            for (int64_t value : adapter.get())
+            {
+                ss << value << ",";
+            }
+            record(name, ss.str());
+        }
+        void on_adapter(const string& name, ValueAccessor<int64_t>& adapter) override
+        {
+            record(name, to_string(adapter.get()));
+        }
+        void on_adapter(const string& name, ValueAccessor<double>& adapter) override
+        {
+            // Compare the bits so that the record round trips exactly
+            double value = adapter.get();
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            record(name, to_string(bits));
+        }
+
+    private:
+        void record(const string& name, const string& value)
+        {
+            m_record.append(name).append("=").append(to_string(value.size()));
+            m_record.append(":").append(value);
+        }
+
+        bool m_complete = true;
+        string m_record;
+    };
+
+    struct NodeSignature
+    {
+        size_t m_hash;
+        bool m_mergeable;
+        // Whether m_attributes describes the node, or a CSE handler has to compare them
+        bool m_recorded;
+        string m_attributes;
+        size_t m_data_hash;
+    };
+}
+
+static NodeSignature make_signature(Node& node,
+                                    const unordered_map<const Node*, NodeSignature>& signatures)
+{
+    NodeSignature signature{0, true, false, "", 0};
+    const NodeTypeInfo& type_info = node.get_type_info();
+    vector<size_t> parts{hash<string>()(type_info.name), type_info.version};
+    for (const Output<Node>& output : node.outputs())
+    {
+        parts.push_back(output.get_element_type().hash());
+        const PartialShape& shape = output.get_partial_shape();
+        if (shape.is_static())
+        {
+            for (size_t dim : shape.to_shape())
+            {
+                parts.push_back(dim);
+            }
+        }
+        else
+        {
+            stringstream ss;
+            ss << shape;
+            parts.push_back(hash<string>()(ss.str()));
+        }
+    }
+
+    vector<size_t> input_keys;
+    for (const Input<Node>& input : node.inputs())
+    {
+        Output<Node> source = input.get_source_output();
+        input_keys.push_back(
+            hash_combine({signatures.at(source.get_node()).m_hash, source.get_index()}));
+    }
+    if (node.is_commutative())
+    {
+        sort(input_keys.begin(), input_keys.end());
+    }
+    parts.insert(parts.end(), input_keys.begin(), input_keys.end());
+
+    if (node.is_parameter() || node.is_output() || node.has_state() ||
+        !node.get_control_dependencies().empty() || !node.get_control_dependents().empty())
+    {
+        signature.m_mergeable = false;
+    }
+    else if (auto constant = as_type<op::Constant>(&node))
+    {
+        signature.m_recorded = true;
+        signature.m_data_hash = pass::ConstantRegistry::hash_data(*constant);
+        parts.push_back(signature.m_data_hash);
+    }
+    else
+    {
+        AttributeRecorder recorder(node);
+        if (recorder.is_complete())
+        {
+            signature.m_recorded = true;
+            signature.m_attributes = recorder.get_record();
+            parts.push_back(hash<string>()(signature.m_attributes));
+        }
+        else
+        {
+            signature.m_mergeable = ops_to_cse_handlers.count(TI(node)) != 0;
+        }
+    }
+
+    if (!signature.m_mergeable)
+    {
+        parts.push_back(node.get_instance_id());
+    }
+    signature.m_hash = hash_combine(parts);
+    return signature;
+}
+
+static bool is_equivalent(const shared_ptr<Node>& a,
+                          const NodeSignature& signature_a,
+                          const shared_ptr<Node>& b,
+                          const NodeSignature& signature_b)
+{
+    if (a->get_type_info() != b->get_type_info() || a->get_output_size() != b->get_output_size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a->get_output_size(); ++i)
+    {
+        if (a->get_output_element_type(i) != b->get_output_element_type(i) ||
+            !a->get_output_partial_shape(i).same_scheme(b->get_output_partial_shape(i)))
+        {
+            return false;
+        }
+    }
+
+    // Inputs are already merged, so equivalent inputs are the very same outputs
+    vector<Output<Node>> inputs_a = a->input_values();
+    vector<Output<Node>> inputs_b = b->input_values();
+    if (a->is_commutative())
+    {
+        sort(inputs_a.begin(), inputs_a.end());
+        sort(inputs_b.begin(), inputs_b.end());
+    }
+    if (inputs_a != inputs_b)
+    {
+        return false;
+    }
+
+    auto constant_a = as_type_ptr<op::Constant>(a);
+    if (constant_a)
+    {
+        auto constant_b = static_pointer_cast<op::Constant>(b);
+        return signature_a.m_data_hash == signature_b.m_data_hash &&
+               memcmp(constant_a->get_data_ptr(),
+                      constant_b->get_data_ptr(),
+                      get_data_size(*constant_a)) == 0;
+    }
+    if (signature_a.m_recorded && signature_b.m_recorded)
+    {
+        return signature_a.m_attributes == signature_b.m_attributes;
+    }
+    return ops_to_cse_handlers.at(TI(*a))(a, b);
+}
+
+pass::StructuralCSE::StructuralCSE(const shared_ptr<ConstantRegistry>& registry)
+    : FunctionPass()
+    , m_registry(registry)
+{
+    set_property(PassProperty::REQUIRE_STATIC_SHAPE, true);
+}
+
+bool pass::StructuralCSE::run_on_function(shared_ptr<Function> f)
+{
+    bool replaced = false;
+    unordered_map<const Node*, NodeSignature> signatures;
+    unordered_multimap<size_t, shared_ptr<Node>> expressions;
+
+    // ops keeps the replaced nodes alive, so no new node can reuse an address in signatures
+    vector<shared_ptr<Node>> ops = f->get_ordered_ops();
+    for (shared_ptr<Node> n : ops)
+    {
+        NodeSignature signature = make_signature(*n, signatures);
+        if (signature.m_mergeable)
+        {
+            shared_ptr<Node> match;
+            auto range = expressions.equal_range(signature.m_hash);
+            for (auto it = range.first; it != range.second && !match; ++it)
+            {
+                if (is_equivalent(n, signature, it->second, signatures.at(it->second.get())))
+                {
+                    match = it->second;
+                }
+            }
+            if (match)
+            {
+                NGRAPH_DEBUG << "StructuralCSE replacing " << n->get_name() << " with "
+                             << match->get_name();
+                replace_node(n, match);
+                replaced = true;
+                continue;
+            }
+
+            auto constant = as_type_ptr<op::Constant>(n);
+            if (constant && m_registry)
+            {
+                auto buffer = m_registry->intern(*constant, signature.m_data_hash);
+                if (buffer != constant->get_data_buffer())
+                {
+                    n = make_shared<op::Constant>(
+                        constant->get_element_type(), constant->get_shape(), buffer);
+                    replace_node(constant, n);
+                    replaced = true;
+                }
+            }
+            expressions.insert({signature.m_hash, n});
+        }
+        signatures.insert({n.get(), move(signature)});
+    }
+
+    return replaced;
+}
@@ -16,13 +16,20 @@
 
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
+#include "ngraph/op/constant.hpp"
 #include "ngraph/pass/pass.hpp"
+#include "ngraph/runtime/aligned_buffer.hpp"
 
 namespace ngraph
 {
     namespace pass
     {
         class CommonSubexpressionElimination;
+        class ConstantRegistry;
+        class StructuralCSE;
     }
 }
 
@@ -51,3 +58,55 @@ public:
 
     virtual bool run_on_function(std::shared_ptr<ngraph::Function> f);
 };
+
+/// \brief Content-addressed store of constant data, shared by every Function a backend
+///        compiles so that identical weights are held in memory once.
+///
+/// Buffers are held weakly and live only as long as some Constant refers to them.
+class NGRAPH_API ngraph::pass::ConstantRegistry
+{
+public:
+    /// \brief Hashes the bytes of a constant's data.
+    static size_t hash_data(const op::Constant& constant);
+
+    /// \brief Returns a registered buffer holding the same bytes as `constant`, registering
+    ///        the constant's own buffer if there is none.
+    /// \param content_hash The value of hash_data(constant)
+    std::shared_ptr<runtime::AlignedBuffer> intern(const op::Constant& constant,
+                                                   size_t content_hash);
+
+    /// \brief Returns the number of distinct buffers still alive.
+    size_t size() const;
+
+private:
+    struct Entry
+    {
+        std::weak_ptr<runtime::AlignedBuffer> m_buffer;
+        size_t m_size;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_multimap<size_t, Entry> m_entries;
+    size_t m_next_sweep = 64;
+};
+
+/// \brief Merges structurally identical subgraphs.
+///
+/// Nodes are keyed bottom up by a hash of their op type, attributes, output types, the keys
+/// of their inputs and, for constants, the content of their data. Attributes come from
+/// Node::visit_attributes; ops that do not describe their attributes fall back on the
+/// handlers of CommonSubexpressionElimination and are left alone otherwise, as are
+/// stateful ops, parameters, results and nodes with control dependencies.
+///
+/// When given a ConstantRegistry, the data of every surviving constant is interned in it,
+/// so a registry shared by all the Functions a backend compiles stores each weight once.
+class NGRAPH_API ngraph::pass::StructuralCSE : public FunctionPass
+{
+public:
+    StructuralCSE(const std::shared_ptr<ConstantRegistry>& registry = nullptr);
+
+    bool run_on_function(std::shared_ptr<ngraph::Function> f) override;
+
+private:
+    std::shared_ptr<ConstantRegistry> m_registry;
+};
@@ -15,14 +15,18 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <deque>
 #include <iostream>
+#include <limits>
 #include <regex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "graph_rewrite.hpp"
 #include "ngraph/env_util.hpp"
 #include "ngraph/log.hpp"
+#include "ngraph/pattern/op/branch.hpp"
 
 using namespace std;
 using namespace ngraph;
@@ -53,7 +57,8 @@ using namespace ngraph;
 // In this case, you should be able to request another pass of GraphRewrite.
 // To request another pass, you will need to register fusions in a callback:
 // i.e. you will need to pass `this` into a callback and then call `this->construct_X`
-// This will schedule another pass of GraphRewrite with the following fusion.
+// This will schedule another pass of GraphRewrite with the following fusion. That pass only
+// visits the nodes close enough to a rewrite from the previous pass to be part of a new match.
 // This approach should only be used if you are either:
 // a) need more than one fusion occur on the same node
 // b) you are modifying nodes after the current node in the topological order
@@ -61,9 +66,101 @@ using namespace ngraph;
 //    the correct final fusion. i.e. the same fusion needs to occur before and after some other
 //    fusion
 
+// Matchers are indexed by the type of their root pattern. A root that is a regular op only
+// matches nodes of exactly that type (see Node::match_value), so a node is offered just the
+// matchers for its own type plus those whose root is a pattern op (Label, Skip, Any, ...).
+//
+// Rounds after the first only run the matchers registered by callbacks, and only on the nodes
+// a rewrite could have affected: new nodes, the nodes around each rewrite and anything
+// downstream of those that is close enough to fall inside one of the patterns.
+
+static const size_t s_unbounded_pattern_depth = numeric_limits<size_t>::max();
+
+// Longest chain of pattern nodes below (and including) pattern
+static size_t get_pattern_depth(const shared_ptr<Node>& pattern,
+                                unordered_map<Node*, size_t>& depths)
+{
+    auto it = depths.find(pattern.get());
+    if (it != depths.end())
+    {
+        return it->second;
+    }
+    // Branches loop back into the pattern so their depth is not bounded; a node still being
+    // visited acts the same way.
+    depths[pattern.get()] = s_unbounded_pattern_depth;
+    if (pattern->get_type_info() == pattern::op::Branch::type_info)
+    {
+        return s_unbounded_pattern_depth;
+    }
+    size_t depth = 0;
+    for (auto& input : pattern->input_values())
+    {
+        depth = max(depth, get_pattern_depth(input.get_node_shared_ptr(), depths));
+        if (depth == s_unbounded_pattern_depth)
+        {
+            return depth;
+        }
+    }
+    depths[pattern.get()] = depth + 1;
+    return depth + 1;
+}
+
+// The nodes of ordered_ops within depth - 1 edges below a node that is new since previous_ops
+// or that was next to a rewrite, in topological order
+static NodeVector get_rewrite_neighbourhood(const NodeVector& ordered_ops,
+                                            const unordered_set<Node*>& previous_ops,
+                                            const NodeVector& rewritten_neighbours,
+                                            size_t depth)
+{
+    unordered_map<Node*, size_t> distances;
+    deque<Node*> frontier;
+    for (auto& node : ordered_ops)
+    {
+        if (previous_ops.count(node.get()) == 0)
+        {
+            distances[node.get()] = 0;
+            frontier.push_back(node.get());
+        }
+    }
+    for (auto& node : rewritten_neighbours)
+    {
+        if (distances.insert({node.get(), 0}).second)
+        {
+            frontier.push_back(node.get());
+        }
+    }
+    while (!frontier.empty())
+    {
+        Node* node = frontier.front();
+        frontier.pop_front();
+        size_t distance = distances[node] + 1;
+        if (distance < depth)
+        {
+            for (auto& user : node->get_users())
+            {
+                if (distances.insert({user.get(), distance}).second)
+                {
+                    frontier.push_back(user.get());
+                }
+            }
+        }
+    }
+
+    NodeVector neighbourhood;
+    for (auto& node : ordered_ops)
+    {
+        if (distances.count(node.get()) != 0)
+        {
+            neighbourhood.push_back(node);
+        }
+    }
+    return neighbourhood;
+}
+
 bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
 {
     bool rewritten = false;
+    bool transformed = false;
     const size_t NUM_TRIES = 10;
     size_t tries = NUM_TRIES;
     vector<MatchClosure> original_matchers{m_matchers};
@@ -71,6 +168,9 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
     // it behind an environment variable for now. TODO: Find a less expensive way to handle this.
     static bool s_rerun_dynamic_check = getenv_bool("NGRAPH_GRAPH_REWRITE_RERUN_DYNAMIC_CHECK");
     bool is_dyn_func = s_rerun_dynamic_check && f->is_dynamic();
+    bool first_round = true;
+    unordered_set<Node*> previous_ops;
+    NodeVector rewritten_neighbours;
     do
     {
         rewritten = false;
@@ -78,14 +178,66 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
         // that need multiple passes. See comments above.
         vector<MatchClosure> matchers_to_run{m_matchers};
         m_matchers.clear();
-        for (auto node : f->get_ordered_ops())
+
+        unordered_map<NodeTypeInfo, vector<size_t>> typed_matchers;
+        vector<size_t> untyped_matchers;
+        unordered_map<Node*, size_t> pattern_depths;
+        size_t pattern_depth = 0;
+        for (size_t i = 0; i < matchers_to_run.size(); i++)
+        {
+            shared_ptr<Node> pattern = matchers_to_run[i].matcher->get_pattern();
+            if (pattern->is_pattern())
+            {
+                untyped_matchers.push_back(i);
+            }
+            else
+            {
+                typed_matchers[pattern->get_type_info()].push_back(i);
+            }
+            pattern_depth = max(pattern_depth, get_pattern_depth(pattern, pattern_depths));
+        }
+        // Candidates per node type, in registration order
+        unordered_map<NodeTypeInfo, vector<size_t>> candidate_matchers;
+        auto get_candidates = [&](const Node& node) -> const vector<size_t>& {
+            auto it = candidate_matchers.find(node.get_type_info());
+            if (it == candidate_matchers.end())
+            {
+                vector<size_t> candidates{untyped_matchers};
+                auto typed = typed_matchers.find(node.get_type_info());
+                if (typed != typed_matchers.end())
+                {
+                    candidates.insert(candidates.end(), typed->second.begin(), typed->second.end());
+                    sort(candidates.begin(), candidates.end());
+                }
+                it = candidate_matchers.insert({node.get_type_info(), move(candidates)}).first;
+            }
+            return it->second;
+        };
+
+        NodeVector ordered_ops = f->get_ordered_ops();
+        NodeVector nodes = ordered_ops;
+        if (!first_round && pattern_depth != s_unbounded_pattern_depth)
+        {
+            nodes = get_rewrite_neighbourhood(
+                ordered_ops, previous_ops, rewritten_neighbours, pattern_depth);
+        }
+        first_round = false;
+        previous_ops.clear();
+        for (auto& node : ordered_ops)
+        {
+            previous_ops.insert(node.get());
+        }
+        rewritten_neighbours.clear();
+
+        for (auto node : nodes)
         {
             if (m_enable_shape_inference)
             {
                 node->revalidate_and_infer_types();
             }
-            for (auto& closure : matchers_to_run)
+            for (size_t index : get_candidates(*node))
             {
+                auto& closure = matchers_to_run[index];
                 if (is_dyn_func && closure.property[PassProperty::REQUIRE_STATIC_SHAPE])
                 {
                     NGRAPH_DEBUG << "matcher callback requires static shape but the "
@@ -101,9 +253,20 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
                 {
                     NGRAPH_DEBUG << "Matcher " << closure.matcher << closure.matcher->get_name()
                                  << " matched " << node->get_name();
+                    // Captured before the callback since it may disconnect the matched nodes
+                    NodeVector neighbours = node->get_users();
+                    for (auto& matched : closure.matcher->get_matched_nodes())
+                    {
+                        NodeVector arguments = matched->get_arguments();
+                        neighbours.insert(neighbours.end(), arguments.begin(), arguments.end());
+                    }
                     if (closure.callback(*closure.matcher.get()))
                     {
+                        count_rewrites();
                         rewritten = true;
+                        transformed = true;
+                        rewritten_neighbours.insert(
+                            rewritten_neighbours.end(), neighbours.begin(), neighbours.end());
                         // If call back may change function's is_dynamic state, we need to
                         // update the cached value.
                         if (closure.property.is_set(PassProperty::CHANGE_DYNAMIC_STATE))
@@ -119,7 +282,7 @@ bool pass::GraphRewrite::run_on_function(shared_ptr<Function> f)
     } while (rewritten && m_matchers.size() > 0 && tries--);
 
     m_matchers.assign(original_matchers.begin(), original_matchers.end());
-    return (NUM_TRIES - tries) > 1; // this means a graph was transformed
+    return transformed;
 }
 
 static vector<regex> initialize_fusion_regexes()
@@ -232,6 +395,7 @@ bool pass::RecurrentGraphRewrite::run_on_function(shared_ptr<Function> f)
                                  << node->get_name();
                     if (closure.callback(*closure.matcher.get()))
                     {
+                        count_rewrites();
                         // If call back may change function's is_dynamic state, we need to
                         // update the cached value.
                         if (closure.property.is_set(PassProperty::CHANGE_DYNAMIC_STATE))
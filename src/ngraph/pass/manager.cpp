@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include <algorithm>
+#include <cstdlib>
 #ifdef _WIN32
 #else
 #include <cxxabi.h>
@@ -22,7 +23,11 @@
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 
+#include "ngraph/chrome_trace.hpp"
 #include "ngraph/env_util.hpp"
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
@@ -39,7 +44,7 @@ using namespace ngraph;
 pass::Manager::Manager()
     : m_visualize(getenv_bool("NGRAPH_ENABLE_VISUALIZE_TRACING"))
     , m_serialize(getenv_bool("NGRAPH_ENABLE_SERIALIZE_TRACING"))
-
+    , m_profile(getenv_bool("NGRAPH_PROFILE_PASS_ENABLE"))
 {
 }
 
@@ -47,9 +52,52 @@ pass::Manager::~Manager()
 {
 }
 
+static string get_pass_name(pass::PassBase& pass)
+{
+    string name = typeid(pass).name();
+#ifndef _WIN32
+    int status;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (demangled != nullptr)
+    {
+        name = demangled;
+        free(demangled);
+    }
+#endif
+    return name;
+}
+
+// Bytes currently allocated from the C heap, or 0 where the C library can't report it
+static int64_t get_heap_in_use()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<int64_t>(info.uordblks + info.hblkhd);
+#elif defined(__GLIBC__)
+    // mallinfo's fields are int and wrap past 2GB, unsigned arithmetic keeps deltas right
+    struct mallinfo info = mallinfo();
+    return static_cast<int64_t>(static_cast<unsigned>(info.uordblks) +
+                                static_cast<unsigned>(info.hblkhd));
+#else
+    return 0;
+#endif
+}
+
+static size_t count_nodes(const vector<shared_ptr<Function>>& fs)
+{
+    size_t count = 0;
+    for (auto& f : fs)
+    {
+        count += f->get_ops().size();
+    }
+    return count;
+}
+
 void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
 {
     static bool profile_enabled = getenv_bool("NGRAPH_PROFILE_PASS_ENABLE");
+    bool tracing = runtime::event::Manager::is_tracing_enabled();
+    runtime::event::Duration run_event("run_passes", "Compile");
 
     get_state().set_function(func);
     vector<std::pair<shared_ptr<Function>, bool>> fs{std::make_pair(func, func->is_dynamic())};
@@ -59,8 +107,21 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
     stopwatch pass_timer;
     stopwatch overall_timer;
     overall_timer.start();
+    m_profile_data.clear();
     for (shared_ptr<PassBase> pass : m_pass_list)
     {
+        PassProfile profile{};
+        if (m_profile || profile_enabled || tracing)
+        {
+            profile.name = get_pass_name(*pass);
+        }
+        if (m_profile)
+        {
+            profile.nodes_before = count_nodes(f_array);
+            profile.heap_growth = -get_heap_in_use();
+        }
+        size_t rewrites_before = pass->get_rewrite_count();
+        runtime::event::Duration pass_event(profile.name, "Pass");
         pass_timer.start();
         pass->set_state(get_state());
         auto module_pass = dynamic_pointer_cast<ModulePass>(pass);
@@ -73,7 +134,7 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
             {
                 vt_pass->set_ops_to_details(get_state().get_visualize_tree_ops_map());
             }
-            module_pass->run_on_module(f_array);
+            profile.functions_modified += module_pass->run_on_module(f_array) ? 1 : 0;
         }
         else if (function_pass)
         {
@@ -89,6 +150,7 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
                     continue;
                 }
                 bool function_modified = function_pass->run_on_function(f);
+                profile.functions_modified += function_modified ? 1 : 0;
                 // If the pass may change the function's is_dynamic property, we need to
                 // update the cached value.
                 if (function_modified &&
@@ -107,10 +169,12 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
                 {
                     continue;
                 }
+                bool function_modified = false;
                 for (shared_ptr<Node> n : f->get_ops())
                 {
-                    node_pass->run_on_node(n);
+                    function_modified = node_pass->run_on_node(n) || function_modified;
                 }
+                profile.functions_modified += function_modified ? 1 : 0;
             }
         }
         else if (call_graph_pass)
@@ -124,6 +188,7 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
                     continue;
                 }
                 bool function_modified = call_graph_pass->run_on_call_graph(f->get_ordered_ops());
+                profile.functions_modified += function_modified ? 1 : 0;
                 f_pair.second = (function_modified == true) ? f->is_dynamic() : f_pair.second;
             }
         }
@@ -154,15 +219,18 @@ void pass::Manager::run_passes(shared_ptr<Function> func, bool /* transitive */)
         }
         index++;
         pass_timer.stop();
+        pass_event.stop();
+        if (m_profile)
+        {
+            profile.microseconds = pass_timer.get_microseconds();
+            profile.nodes_after = count_nodes(f_array);
+            profile.heap_growth += get_heap_in_use();
+            profile.rewrites = pass->get_rewrite_count() - rewrites_before;
+            m_profile_data.push_back(profile);
+        }
         if (profile_enabled)
         {
-            PassBase* p = pass.get();
-            string name = typeid(*p).name();
-#ifndef _WIN32
-            int status;
-            name = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
-#endif
-            cout << setw(7) << pass_timer.get_milliseconds() << "ms " << name << "\n";
+            cout << setw(7) << pass_timer.get_milliseconds() << "ms " << profile.name << "\n";
         }
     }
     if (profile_enabled)
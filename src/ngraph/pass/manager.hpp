@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <list>
 #include <memory>
+#include <string>
 #include <typeinfo>
 #include <vector>
 
@@ -32,9 +34,28 @@ namespace ngraph
     {
         class Manager;
         class ManagerState;
+        struct PassProfile;
     }
 }
 
+/// \brief What one pass cost during the last pass::Manager::run_passes
+struct ngraph::pass::PassProfile
+{
+    std::string name;
+    /// Wall time of the pass, including any visualization or serialization it triggered
+    size_t microseconds;
+    /// Ops reachable from the function's results before and after the pass
+    size_t nodes_before;
+    size_t nodes_after;
+    /// Matcher callbacks that rewrote the graph, for passes built on GraphRewrite
+    size_t rewrites;
+    /// Functions the pass reported as modified
+    size_t functions_modified;
+    /// Growth of the process heap while the pass ran, which also includes allocations made
+    /// by other threads. Zero where the C library can't report heap usage.
+    int64_t heap_growth;
+};
+
 class NGRAPH_API ngraph::pass::Manager
 {
 public:
@@ -60,6 +81,12 @@ public:
     void set_pass_visualization(bool new_state) { m_visualize = new_state; }
     void set_pass_serialization(bool new_state) { m_serialize = new_state; }
     void set_per_pass_validation(bool new_state) { m_per_pass_validation = new_state; }
+    /// \brief Record a PassProfile for every pass run by run_passes. Defaults to the
+    /// NGRAPH_PROFILE_PASS_ENABLE environment variable.
+    void set_pass_profiling(bool new_state) { m_profile = new_state; }
+    /// \brief Per-pass profile of the last run_passes, in run order. Empty unless profiling
+    /// was enabled for that run.
+    const std::vector<PassProfile>& get_profile() const { return m_profile_data; }
 private:
     template <typename T, class... Args>
     std::shared_ptr<T> push_pass(Args&&... args)
@@ -86,9 +113,11 @@ private:
 
     std::vector<std::string> m_pass_names;
     std::vector<std::shared_ptr<PassBase>> m_pass_list;
+    std::vector<PassProfile> m_profile_data;
     ManagerState m_state;
     PassConfig m_pass_config;
     bool m_visualize = false;
     bool m_serialize = false;
     bool m_per_pass_validation = true;
+    bool m_profile = false;
 };
@@ -0,0 +1,425 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <stack>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ngraph/function.hpp"
+#include "ngraph/graph_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/pass/memory_aware_scheduling.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Tensors that Liveness never assigns to the memory pool
+static bool is_persistent(const Node* producer)
+{
+    return producer->is_parameter() || producer->is_constant() || producer->is_output();
+}
+
+static size_t get_tensor_bytes(const descriptor::Tensor& tensor)
+{
+    if (tensor.get_partial_shape().is_dynamic() || tensor.get_element_type().is_dynamic())
+    {
+        return 0;
+    }
+    return shape_size(tensor.get_shape()) * tensor.get_element_type().size();
+}
+
+size_t pass::MemoryAwareScheduling::estimate_peak_bytes(const vector<shared_ptr<Node>>& ordered_ops)
+{
+    vector<size_t> live_bytes = estimate_live_bytes(ordered_ops);
+    return live_bytes.empty() ? 0 : *max_element(live_bytes.begin(), live_bytes.end());
+}
+
+vector<size_t>
+    pass::MemoryAwareScheduling::estimate_live_bytes(const vector<shared_ptr<Node>>& ordered_ops)
+{
+    unordered_map<descriptor::Tensor*, size_t> remaining_uses;
+    for (const shared_ptr<Node>& node : ordered_ops)
+    {
+        for (auto& input : node->inputs())
+        {
+            remaining_uses[&input.get_tensor()]++;
+        }
+    }
+
+    size_t live = 0;
+    vector<size_t> live_bytes;
+    live_bytes.reserve(ordered_ops.size());
+    for (const shared_ptr<Node>& node : ordered_ops)
+    {
+        if (!is_persistent(node.get()))
+        {
+            for (auto& output : node->outputs())
+            {
+                live += get_tensor_bytes(output.get_tensor());
+            }
+        }
+        live_bytes.push_back(live);
+        if (!is_persistent(node.get()))
+        {
+            for (auto& output : node->outputs())
+            {
+                if (remaining_uses.count(&output.get_tensor()) == 0)
+                {
+                    live -= get_tensor_bytes(output.get_tensor());
+                }
+            }
+        }
+        for (auto& input : node->inputs())
+        {
+            descriptor::Tensor* tensor = &input.get_tensor();
+            if (!is_persistent(input.get_source_output().get_node()) &&
+                --remaining_uses.at(tensor) == 0)
+            {
+                live -= get_tensor_bytes(*tensor);
+            }
+        }
+    }
+    return live_bytes;
+}
+
+// Repeatedly runs the ready op that grows the live bytes the least
+static vector<shared_ptr<Node>> greedy_order(const vector<shared_ptr<Node>>& default_order)
+{
+    size_t node_count = default_order.size();
+
+    // Ties are broken by the default order, so without memory differences it is kept
+    unordered_map<Node*, size_t> node_index;
+    for (size_t i = 0; i < node_count; i++)
+    {
+        node_index[default_order[i].get()] = i;
+    }
+
+    vector<vector<size_t>> successors(node_count);
+    vector<size_t> pending_predecessors(node_count);
+    vector<int64_t> allocated_bytes(node_count, 0);
+    unordered_map<descriptor::Tensor*, size_t> remaining_uses;
+    for (size_t i = 0; i < node_count; i++)
+    {
+        Node* node = default_order[i].get();
+        vector<size_t> predecessors;
+        for (auto& input : node->inputs())
+        {
+            predecessors.push_back(node_index.at(input.get_source_output().get_node()));
+            remaining_uses[&input.get_tensor()]++;
+        }
+        for (auto& dependency : node->get_control_dependencies())
+        {
+            predecessors.push_back(node_index.at(dependency.get()));
+        }
+        sort(predecessors.begin(), predecessors.end());
+        predecessors.erase(unique(predecessors.begin(), predecessors.end()), predecessors.end());
+        pending_predecessors[i] = predecessors.size();
+        for (size_t predecessor : predecessors)
+        {
+            successors[predecessor].push_back(i);
+        }
+    }
+    for (size_t i = 0; i < node_count; i++)
+    {
+        Node* node = default_order[i].get();
+        if (is_persistent(node))
+        {
+            continue;
+        }
+        for (auto& output : node->outputs())
+        {
+            // Outputs nobody reads are freed right away
+            if (remaining_uses.count(&output.get_tensor()) != 0)
+            {
+                allocated_bytes[i] += get_tensor_bytes(output.get_tensor());
+            }
+        }
+    }
+
+    // Bytes of the inputs that scheduling node next would free
+    auto get_freed_bytes = [&](size_t i) {
+        int64_t freed = 0;
+        vector<pair<descriptor::Tensor*, size_t>> uses;
+        for (auto& input : default_order[i]->inputs())
+        {
+            if (is_persistent(input.get_source_output().get_node()))
+            {
+                continue;
+            }
+            descriptor::Tensor* tensor = &input.get_tensor();
+            auto it = find_if(uses.begin(),
+                              uses.end(),
+                              [tensor](const pair<descriptor::Tensor*, size_t>& use) {
+                                  return use.first == tensor;
+                              });
+            if (it == uses.end())
+            {
+                uses.push_back({tensor, 1});
+            }
+            else
+            {
+                it->second++;
+            }
+        }
+        for (auto& use : uses)
+        {
+            if (remaining_uses.at(use.first) == use.second)
+            {
+                freed += get_tensor_bytes(*use.first);
+            }
+        }
+        return freed;
+    };
+
+    vector<size_t> ready;
+    for (size_t i = 0; i < node_count; i++)
+    {
+        if (pending_predecessors[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
+
+    vector<shared_ptr<Node>> result;
+    result.reserve(node_count);
+    while (!ready.empty())
+    {
+        size_t best = 0;
+        int64_t best_delta = numeric_limits<int64_t>::max();
+        for (size_t r = 0; r < ready.size(); r++)
+        {
+            int64_t delta = allocated_bytes[ready[r]] - get_freed_bytes(ready[r]);
+            if (delta < best_delta || (delta == best_delta && ready[r] < ready[best]))
+            {
+                best = r;
+                best_delta = delta;
+            }
+        }
+        size_t next = ready[best];
+        ready.erase(ready.begin() + best);
+        result.push_back(default_order[next]);
+        for (auto& input : default_order[next]->inputs())
+        {
+            remaining_uses.at(&input.get_tensor())--;
+        }
+        for (size_t successor : successors[next])
+        {
+            if (--pending_predecessors[successor] == 0)
+            {
+                ready.push_back(successor);
+            }
+        }
+    }
+    return result;
+}
+
+// Depth first order that, like Sethi-Ullman numbering, visits the inputs needing the most
+// memory beyond their own result first. Shared subgraphs are costed once per use.
+static vector<shared_ptr<Node>> subtree_order(const vector<shared_ptr<Node>>& root_nodes,
+                                              const vector<shared_ptr<Node>>& default_order)
+{
+    // Peak bytes to compute each node from scratch, and its inputs in visiting order
+    unordered_map<Node*, size_t> need;
+    unordered_map<Node*, vector<Node*>> input_order;
+    for (const shared_ptr<Node>& node : default_order)
+    {
+        vector<pair<Node*, size_t>> inputs;
+        for (auto& input : node->inputs())
+        {
+            Node* producer = input.get_source_output().get_node();
+            size_t bytes = is_persistent(producer) ? 0 : get_tensor_bytes(input.get_tensor());
+            auto it = find_if(
+                inputs.begin(), inputs.end(), [producer](const pair<Node*, size_t>& p) {
+                    return p.first == producer;
+                });
+            if (it == inputs.end())
+            {
+                inputs.push_back({producer, bytes});
+            }
+        }
+        stable_sort(inputs.begin(),
+                    inputs.end(),
+                    [&need](const pair<Node*, size_t>& a, const pair<Node*, size_t>& b) {
+                        return need.at(a.first) - min(need.at(a.first), a.second) >
+                               need.at(b.first) - min(need.at(b.first), b.second);
+                    });
+
+        size_t held = 0;
+        size_t node_need = 0;
+        vector<Node*>& order = input_order[node.get()];
+        for (auto& input : inputs)
+        {
+            node_need = max(node_need, held + need.at(input.first));
+            held += input.second;
+            order.push_back(input.first);
+        }
+        size_t output_bytes = 0;
+        if (!is_persistent(node.get()))
+        {
+            for (auto& output : node->outputs())
+            {
+                output_bytes += get_tensor_bytes(output.get_tensor());
+            }
+        }
+        need[node.get()] = max(node_need, held + output_bytes);
+    }
+
+    // Same traversal as topological_sort with the inputs pushed in the order found above
+    stack<Node*, vector<Node*>> nodes_to_do;
+    unordered_set<Node*> nodes_done;
+    vector<shared_ptr<Node>> result;
+    for (auto& node : root_nodes)
+    {
+        nodes_to_do.push(node.get());
+    }
+    while (nodes_to_do.size() > 0)
+    {
+        Node* node = nodes_to_do.top();
+        if (nodes_done.count(node) == 0)
+        {
+            bool can_add = true;
+            const vector<Node*>& inputs = input_order.at(node);
+            for (auto it = inputs.rbegin(); it != inputs.rend(); ++it)
+            {
+                if (nodes_done.count(*it) == 0)
+                {
+                    can_add = false;
+                    nodes_to_do.push(*it);
+                }
+            }
+            for (auto& depptr : node->get_control_dependencies())
+            {
+                Node* dep = depptr.get();
+                if (nodes_done.count(dep) == 0)
+                {
+                    can_add = false;
+                    nodes_to_do.push(dep);
+                }
+            }
+            if (can_add)
+            {
+                result.push_back(node->shared_from_this());
+                nodes_to_do.pop();
+                nodes_done.insert(node);
+            }
+        }
+        else
+        {
+            nodes_to_do.pop();
+        }
+    }
+    return result;
+}
+
+vector<shared_ptr<Node>>
+    pass::MemoryAwareScheduling::schedule(const vector<shared_ptr<Node>>& root_nodes)
+{
+    vector<shared_ptr<Node>> best = topological_sort<vector<shared_ptr<Node>>>(root_nodes);
+    size_t best_peak = estimate_peak_bytes(best);
+    for (auto candidate : {greedy_order(best), subtree_order(root_nodes, best)})
+    {
+        size_t peak = estimate_peak_bytes(candidate);
+        if (peak < best_peak)
+        {
+            best = candidate;
+            best_peak = peak;
+        }
+    }
+    return best;
+}
+
+namespace
+{
+    // Sorter installed on the function. Scheduling is much more expensive than a topological
+    // sort and get_ordered_ops is called many times by later passes, so the schedule is kept
+    // and only recomputed when the graph no longer has the same ops or the kept order no
+    // longer respects an edge.
+    class CachedSchedule
+    {
+    public:
+        vector<shared_ptr<Node>> operator()(const vector<shared_ptr<Node>>& root_nodes)
+        {
+            vector<shared_ptr<Node>> ops =
+                topological_sort<vector<shared_ptr<Node>>>(root_nodes);
+            lock_guard<mutex> lock(m_mutex);
+            if (!is_valid(ops))
+            {
+                m_order = pass::MemoryAwareScheduling::schedule(root_nodes);
+                m_position.clear();
+                for (size_t i = 0; i < m_order.size(); i++)
+                {
+                    m_position[m_order[i].get()] = i;
+                }
+            }
+            return m_order;
+        }
+
+    private:
+        bool is_valid(const vector<shared_ptr<Node>>& ops) const
+        {
+            if (ops.size() != m_order.size())
+            {
+                return false;
+            }
+            for (auto& op : ops)
+            {
+                auto it = m_position.find(op.get());
+                if (it == m_position.end())
+                {
+                    return false;
+                }
+                for (auto& input : op->inputs())
+                {
+                    auto source = m_position.find(input.get_source_output().get_node());
+                    if (source == m_position.end() || source->second >= it->second)
+                    {
+                        return false;
+                    }
+                }
+                for (auto& dep : op->get_control_dependencies())
+                {
+                    auto source = m_position.find(dep.get());
+                    if (source == m_position.end() || source->second >= it->second)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        mutex m_mutex;
+        vector<shared_ptr<Node>> m_order;
+        unordered_map<Node*, size_t> m_position;
+    };
+}
+
+bool pass::MemoryAwareScheduling::run_on_function(shared_ptr<Function> function)
+{
+    m_original_peak_bytes = estimate_peak_bytes(function->get_ordered_ops());
+    auto cached_schedule = make_shared<CachedSchedule>();
+    function->set_topological_sort(
+        [cached_schedule](const vector<shared_ptr<Node>>& root_nodes) {
+            return (*cached_schedule)(root_nodes);
+        });
+    m_peak_bytes = estimate_peak_bytes(function->get_ordered_ops());
+    NGRAPH_DEBUG << "MemoryAwareScheduling: peak live bytes of " << function->get_name()
+                 << " reduced from " << m_original_peak_bytes << " to " << m_peak_bytes;
+    return false;
+}
@@ -0,0 +1,64 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class MemoryAwareScheduling;
+    }
+}
+
+/// \brief Replaces the function's topological sort with one that orders ops to keep the
+///        bytes of live intermediate tensors low.
+///
+/// Two orders are tried against the default depth first order: a greedy list schedule that
+/// runs the ready op growing the live bytes the least, and a depth first order that visits
+/// the most memory hungry inputs first. The one with the lowest estimated peak is used. It is
+/// kept for later calls to get_ordered_ops until the graph changes.
+/// Liveness and memory assignment must run after this pass to see the new order.
+class NGRAPH_API ngraph::pass::MemoryAwareScheduling : public FunctionPass
+{
+public:
+    bool run_on_function(std::shared_ptr<ngraph::Function>) override;
+
+    /// \brief Peak live intermediate bytes of the function's order before this pass ran
+    size_t get_original_peak_bytes() const { return m_original_peak_bytes; }
+    /// \brief Peak live intermediate bytes of the function's order after this pass ran
+    size_t get_peak_bytes() const { return m_peak_bytes; }
+    /// \brief Topological sort of the graph above root_nodes that keeps live bytes low
+    static std::vector<std::shared_ptr<Node>>
+        schedule(const std::vector<std::shared_ptr<Node>>& root_nodes);
+
+    /// \brief Peak bytes of intermediate tensors live at once when running ordered_ops in
+    ///        order, ignoring parameters, constants and results as Liveness does.
+    static size_t estimate_peak_bytes(const std::vector<std::shared_ptr<Node>>& ordered_ops);
+    /// \brief Bytes of intermediate tensors live while each op of ordered_ops runs, counted
+    ///        as estimate_peak_bytes does. The peak is the largest entry.
+    static std::vector<size_t>
+        estimate_live_bytes(const std::vector<std::shared_ptr<Node>>& ordered_ops);
+
+private:
+    size_t m_original_peak_bytes = 0;
+    size_t m_peak_bytes = 0;
+};
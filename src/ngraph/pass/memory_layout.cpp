@@ -14,9 +14,12 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
 #include <exception>
+#include <iostream>
 #include <sstream>
 
+#include "ngraph/env_util.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/op/concat.hpp"
@@ -30,9 +33,12 @@
 using namespace std;
 using namespace ngraph;
 
-pass::MemoryLayout::MemoryLayout(size_t alignment, bool disable_memory_sharing)
+pass::MemoryLayout::MemoryLayout(size_t alignment,
+                                 bool disable_memory_sharing,
+                                 MemoryManager::allocation_scheme scheme)
     : m_alignment(alignment)
     , m_disable_memory_sharing(disable_memory_sharing)
+    , m_scheme(disable_memory_sharing ? MemoryManager::allocation_scheme::NO_REUSE : scheme)
 {
     if (m_alignment == 0)
     {
@@ -42,7 +48,8 @@ pass::MemoryLayout::MemoryLayout(size_t alignment, bool disable_memory_sharing)
 
 bool pass::MemoryLayout::run_on_function(shared_ptr<Function> function)
 {
-    MemoryManager mm(m_alignment, m_disable_memory_sharing);
+    MemoryManager mm(m_alignment, m_scheme);
+    vector<descriptor::Tensor*> allocated_tensors;
     for (shared_ptr<Node> node : function->get_ordered_ops())
     {
         std::map<descriptor::Tensor*, descriptor::Tensor*> in_place_outputs;
@@ -87,6 +94,7 @@ bool pass::MemoryLayout::run_on_function(shared_ptr<Function> function)
                                 ? in_place_outputs.at(tensor)->get_pool_offset()
                                 : mm.allocate(tensor->size());
             tensor->set_pool_offset(offset);
+            allocated_tensors.push_back(tensor);
         }
 
         if (!m_disable_memory_sharing)
@@ -100,8 +108,20 @@ bool pass::MemoryLayout::run_on_function(shared_ptr<Function> function)
             }
         }
     }
+    // Offline schemes hand out buffer ids above, resolve them to offsets
+    mm.plan();
+    for (descriptor::Tensor* tensor : allocated_tensors)
+    {
+        tensor->set_pool_offset(mm.get_offset(tensor->get_pool_offset()));
+    }
     function->set_temporary_pool_size(mm.max_allocated());
 
+    if (getenv_bool("NGRAPH_MEMORY_PLAN_REPORT"))
+    {
+        cout << "MemoryLayout " << function->get_name() << "\n";
+        mm.dump_plan_report(cout);
+    }
+
     return false;
 }
 
@@ -112,9 +132,17 @@ pass::MemoryManager::node::node(size_t size, block_state state)
 }
 
 pass::MemoryManager::MemoryManager(size_t alignment, bool disable_memory_reuse)
+    : MemoryManager(alignment,
+                    disable_memory_reuse ? allocation_scheme::NO_REUSE
+                                         : allocation_scheme::FIRST_FIT)
+{
+}
+
+pass::MemoryManager::MemoryManager(size_t alignment, allocation_scheme scheme)
     : m_alignment{alignment}
-    , m_scheme{disable_memory_reuse ? allocation_scheme::NO_REUSE : allocation_scheme::FIRST_FIT}
+    , m_scheme{scheme}
     , m_max_allocated{0}
+    , m_clock{0}
 {
     if (m_alignment == 0)
     {
@@ -131,7 +159,15 @@ size_t pass::MemoryManager::allocate(size_t size)
     case allocation_scheme::FIRST_FIT: rc = first_fit(size); break;
     case allocation_scheme::BEST_FIT: rc = best_fit(size); break;
     case allocation_scheme::NO_REUSE: rc = no_reuse_allocator(size); break;
+    case allocation_scheme::GREEDY_BY_SIZE:
+    case allocation_scheme::OPTIMAL: rc = m_buffers.size(); break;
+    }
+    if (!is_offline())
+    {
+        m_live_buffers[rc] = m_buffers.size();
     }
+    m_buffers.push_back(
+        buffer{align(size, m_alignment), m_clock++, numeric_limits<size_t>::max(), rc});
     return rc;
 }
 
@@ -220,6 +256,20 @@ size_t pass::MemoryManager::first_fit(size_t size)
 
 void pass::MemoryManager::free(size_t offset)
 {
+    if (is_offline())
+    {
+        if (offset >= m_buffers.size())
+        {
+            throw runtime_error("bad free");
+        }
+        // Buffers shared by several tensors may be freed through each of them
+        if (m_buffers[offset].m_end == numeric_limits<size_t>::max())
+        {
+            m_buffers[offset].m_end = m_clock++;
+        }
+        return;
+    }
+
     size_t search_offset = 0;
     bool found = false;
     for (auto it = m_node_list.begin(); it != m_node_list.end(); ++it)
@@ -258,6 +308,198 @@ void pass::MemoryManager::free(size_t offset)
     {
         throw runtime_error("bad free");
     }
+    auto live = m_live_buffers.find(offset);
+    if (live != m_live_buffers.end())
+    {
+        m_buffers[live->second].m_end = m_clock++;
+        m_live_buffers.erase(live);
+    }
+}
+
+bool pass::MemoryManager::is_offline() const
+{
+    return m_scheme == allocation_scheme::GREEDY_BY_SIZE || m_scheme == allocation_scheme::OPTIMAL;
+}
+
+size_t pass::MemoryManager::get_offset(size_t allocation) const
+{
+    return is_offline() ? m_buffers.at(allocation).m_offset : allocation;
+}
+
+bool pass::MemoryManager::overlaps(const buffer& a, const buffer& b)
+{
+    return a.m_begin < b.m_end && b.m_begin < a.m_end;
+}
+
+size_t pass::MemoryManager::place(vector<buffer>& buffers,
+                                  const vector<size_t>& order,
+                                  bool best_fit,
+                                  size_t limit)
+{
+    size_t peak = 0;
+    vector<const buffer*> conflicts;
+    for (size_t i = 0; i < order.size() && peak < limit; i++)
+    {
+        buffer& current = buffers[order[i]];
+        conflicts.clear();
+        for (size_t j = 0; j < i; j++)
+        {
+            const buffer& placed = buffers[order[j]];
+            if (overlaps(current, placed))
+            {
+                conflicts.push_back(&placed);
+            }
+        }
+        sort(conflicts.begin(), conflicts.end(), [](const buffer* a, const buffer* b) {
+            return a->m_offset < b->m_offset;
+        });
+
+        // Scan the gaps between the conflicting buffers from the bottom up
+        size_t gap_begin = 0;
+        size_t offset = numeric_limits<size_t>::max();
+        size_t best_gap = numeric_limits<size_t>::max();
+        for (const buffer* conflict : conflicts)
+        {
+            if (conflict->m_offset >= gap_begin + current.m_size)
+            {
+                size_t gap = conflict->m_offset - gap_begin;
+                if (!best_fit)
+                {
+                    offset = gap_begin;
+                    break;
+                }
+                if (gap < best_gap)
+                {
+                    best_gap = gap;
+                    offset = gap_begin;
+                }
+            }
+            gap_begin = max(gap_begin, conflict->m_offset + conflict->m_size);
+        }
+        if (offset == numeric_limits<size_t>::max())
+        {
+            offset = gap_begin;
+        }
+        current.m_offset = offset;
+        peak = max(peak, offset + current.m_size);
+    }
+    return peak;
+}
+
+void pass::MemoryManager::plan_greedy_by_size()
+{
+    vector<size_t> order(m_buffers.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    // Largest first, ties broken by the longest live interval
+    stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        const buffer& lhs = m_buffers[a];
+        const buffer& rhs = m_buffers[b];
+        if (lhs.m_size != rhs.m_size)
+        {
+            return lhs.m_size > rhs.m_size;
+        }
+        return lhs.m_end - lhs.m_begin > rhs.m_end - rhs.m_begin;
+    });
+    m_max_allocated = place(m_buffers, order, true);
+}
+
+void pass::MemoryManager::plan_optimal()
+{
+    plan_greedy_by_size();
+    if (m_buffers.size() > s_optimal_max_buffers)
+    {
+        return;
+    }
+
+    // Some placement order packs every buffer at its lowest free offset optimally, so
+    // search all orders, keeping the greedy plan unless an order beats it
+    vector<size_t> order(m_buffers.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    vector<buffer> candidate = m_buffers;
+    do
+    {
+        size_t peak = place(candidate, order, false, m_max_allocated);
+        if (peak < m_max_allocated)
+        {
+            m_max_allocated = peak;
+            m_buffers = candidate;
+        }
+    } while (next_permutation(order.begin(), order.end()));
+}
+
+void pass::MemoryManager::plan()
+{
+    switch (m_scheme)
+    {
+    case allocation_scheme::FIRST_FIT:
+    case allocation_scheme::BEST_FIT:
+    case allocation_scheme::NO_REUSE: break;
+    case allocation_scheme::GREEDY_BY_SIZE: plan_greedy_by_size(); break;
+    case allocation_scheme::OPTIMAL: plan_optimal(); break;
+    }
+}
+
+map<pass::MemoryManager::allocation_scheme, size_t> pass::MemoryManager::get_peak_by_scheme() const
+{
+    // Replay the allocations and frees in their original order under every scheme
+    vector<pair<size_t, size_t>> events;
+    for (size_t i = 0; i < m_buffers.size(); i++)
+    {
+        events.push_back({m_buffers[i].m_begin, i});
+        if (m_buffers[i].m_end != numeric_limits<size_t>::max())
+        {
+            events.push_back({m_buffers[i].m_end, i});
+        }
+    }
+    sort(events.begin(), events.end());
+
+    map<allocation_scheme, size_t> rc;
+    for (allocation_scheme scheme : {allocation_scheme::FIRST_FIT,
+                                     allocation_scheme::BEST_FIT,
+                                     allocation_scheme::NO_REUSE,
+                                     allocation_scheme::GREEDY_BY_SIZE,
+                                     allocation_scheme::OPTIMAL})
+    {
+        MemoryManager mm(m_alignment, scheme);
+        vector<size_t> handles(m_buffers.size());
+        for (const pair<size_t, size_t>& event : events)
+        {
+            const buffer& b = m_buffers[event.second];
+            if (event.first == b.m_begin)
+            {
+                handles[event.second] = mm.allocate(b.m_size);
+            }
+            else if (scheme != allocation_scheme::NO_REUSE)
+            {
+                mm.free(handles[event.second]);
+            }
+        }
+        mm.plan();
+        rc[scheme] = mm.max_allocated();
+    }
+    return rc;
+}
+
+void pass::MemoryManager::dump_plan_report(ostream& out) const
+{
+    static const map<allocation_scheme, string> names{
+        {allocation_scheme::FIRST_FIT, "FIRST_FIT"},
+        {allocation_scheme::BEST_FIT, "BEST_FIT"},
+        {allocation_scheme::NO_REUSE, "NO_REUSE"},
+        {allocation_scheme::GREEDY_BY_SIZE, "GREEDY_BY_SIZE"},
+        {allocation_scheme::OPTIMAL, "OPTIMAL"}};
+    out << "buffers=" << m_buffers.size() << "\n";
+    for (const pair<allocation_scheme, size_t>& peak : get_peak_by_scheme())
+    {
+        out << names.at(peak.first) << (peak.first == m_scheme ? "*" : "")
+            << " peak=" << peak.second << "\n";
+    }
 }
 
 void pass::MemoryManager::dump(ostream& out)
@@ -18,7 +18,9 @@
 
 #include <limits>
 #include <list>
+#include <map>
 #include <sstream>
+#include <vector>
 
 #include "ngraph/pass/pass.hpp"
 
@@ -32,17 +34,6 @@ namespace ngraph
     }
 }
 
-class ngraph::pass::MemoryLayout : public FunctionPass
-{
-public:
-    MemoryLayout(size_t alignment = 1, bool disable_memory_sharing = false);
-    bool run_on_function(std::shared_ptr<ngraph::Function>) override;
-
-private:
-    size_t m_alignment;
-    bool m_disable_memory_sharing;
-};
-
 class ngraph::pass::MemoryManager
 {
 public:
@@ -56,7 +47,11 @@ public:
     {
         FIRST_FIT,
         BEST_FIT,
-        NO_REUSE
+        NO_REUSE,
+        // Offline schemes place every buffer once all allocations and frees are known.
+        // allocate() returns a buffer id which plan() maps to an offset.
+        GREEDY_BY_SIZE,
+        OPTIMAL
     };
 
     class node
@@ -70,11 +65,26 @@ public:
     };
 
     MemoryManager(size_t alignment = 1, bool disable_reuse = false);
+    MemoryManager(size_t alignment, allocation_scheme scheme);
     // memory_manager& alignment(size_t a);
 
+    /// \brief Returns the offset of the new buffer, or its id for offline schemes
     size_t allocate(size_t size);
+    /// \brief Frees the buffer at offset, or with that id for offline schemes
     void free(size_t offset);
 
+    /// \brief Assigns offsets to the buffers of an offline scheme from their live intervals.
+    ///        Does nothing for online schemes.
+    void plan();
+    /// \brief Returns the offset of the buffer returned by allocate(). Offline schemes must
+    ///        call plan() first.
+    size_t get_offset(size_t allocation) const;
+    bool is_offline() const;
+
+    /// \brief Peak bytes each scheme needs for the allocations and frees made so far
+    std::map<allocation_scheme, size_t> get_peak_by_scheme() const;
+    void dump_plan_report(std::ostream& out) const;
+
     void dump(std::ostream&);
 
     static size_t align(size_t x, size_t alignment);
@@ -85,13 +95,54 @@ public:
     std::list<node>::const_iterator end() const { return m_node_list.cend(); }
     const std::list<node>& get_node_list() const { return m_node_list; }
     size_t max_allocated() const { return m_max_allocated; }
+    /// The OPTIMAL scheme falls back to GREEDY_BY_SIZE above this many buffers
+    static const size_t s_optimal_max_buffers = 8;
+
 private:
+    // The live interval of an allocation in allocate/free call order. m_end is max() while
+    // the buffer is live.
+    struct buffer
+    {
+        size_t m_size;
+        size_t m_begin;
+        size_t m_end;
+        size_t m_offset;
+    };
+
     size_t first_fit(size_t size);
     size_t best_fit(size_t size);
     size_t no_reuse_allocator(size_t size);
+    static bool overlaps(const buffer& a, const buffer& b);
+    // Places buffers in order at the lowest (or tightest, if best_fit) gap free of the
+    // buffers they overlap, stopping early once the peak reaches limit. Returns the peak.
+    static size_t place(std::vector<buffer>& buffers,
+                        const std::vector<size_t>& order,
+                        bool best_fit,
+                        size_t limit = std::numeric_limits<size_t>::max());
+    void plan_greedy_by_size();
+    void plan_optimal();
 
     std::list<node> m_node_list;
     size_t m_alignment;
     allocation_scheme m_scheme;
     size_t m_max_allocated;
+    std::vector<buffer> m_buffers;
+    // Online schemes: offset of each live buffer -> index in m_buffers
+    std::map<size_t, size_t> m_live_buffers;
+    size_t m_clock;
+};
+
+class ngraph::pass::MemoryLayout : public FunctionPass
+{
+public:
+    MemoryLayout(size_t alignment = 1,
+                 bool disable_memory_sharing = false,
+                 MemoryManager::allocation_scheme scheme =
+                     MemoryManager::allocation_scheme::FIRST_FIT);
+    bool run_on_function(std::shared_ptr<ngraph::Function>) override;
+
+private:
+    size_t m_alignment;
+    bool m_disable_memory_sharing;
+    MemoryManager::allocation_scheme m_scheme;
 };
@@ -78,14 +78,18 @@ public:
     virtual ~PassBase() {}
     /// Check if this pass has all the pass properties.
     bool get_property(const PassPropertyMask& prop_mask) const;
+    /// Number of rewrites this pass has applied since it was constructed
+    size_t get_rewrite_count() const { return m_rewrite_count; }
 
 protected:
     ManagerState& get_state();
     void set_state(ManagerState&);
     void set_property(const PassPropertyMask& prop, bool value);
+    void count_rewrites(size_t count = 1) { m_rewrite_count += count; }
 
 private:
     PassPropertyMask m_property;
+    size_t m_rewrite_count{0};
     ManagerState* m_state{nullptr};
 };
 
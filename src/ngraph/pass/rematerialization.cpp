@@ -0,0 +1,280 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ngraph/function.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/op/get_output_element.hpp"
+#include "ngraph/pass/memory_aware_scheduling.hpp"
+#include "ngraph/pass/rematerialization.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Tensors that Liveness never assigns to the memory pool
+static bool is_persistent(const Node* node)
+{
+    return node->is_parameter() || node->is_constant() || node->is_output();
+}
+
+static bool can_recompute(const Node* node)
+{
+    return !is_persistent(node) && node->get_output_size() == 1 && !node->has_state() &&
+           node->get_control_dependencies().empty() && !is_type<op::GetOutputElement>(node);
+}
+
+// Elements an op reads and writes, standing in for the cost of running it again
+static size_t get_elements(const Node* node)
+{
+    size_t elements = shape_size(node->get_output_shape(0));
+    for (auto& input : node->inputs())
+    {
+        elements += shape_size(input.get_shape());
+    }
+    return elements;
+}
+
+// Inputs that are no longer live when a copy runs are recomputed as well, this many levels deep
+static const size_t max_chain_depth = 2;
+
+namespace
+{
+    struct Candidate
+    {
+        shared_ptr<Node> m_node;
+        // Ops to copy in order, ending with m_node, with the input each copy reads. Inputs
+        // produced by an earlier op of the chain read its copy.
+        vector<pair<shared_ptr<Node>, OutputVector>> m_chain;
+        vector<Input<Node>> m_late_inputs;
+        shared_ptr<Node> m_anchor;
+        size_t m_bytes;
+        size_t m_elements;
+    };
+}
+
+pass::Rematerialization::Rematerialization(size_t memory_budget)
+    : m_memory_budget(memory_budget)
+{
+    set_property(PassProperty::REQUIRE_STATIC_SHAPE, true);
+}
+
+bool pass::Rematerialization::run_on_function(shared_ptr<Function> function)
+{
+    // Copies made of each op, and the ops that must not be picked again: those already
+    // recomputed, the copies themselves, and those that copies are ordered after.
+    unordered_map<Node*, vector<shared_ptr<Node>>> copies;
+    unordered_set<Node*> excluded;
+    m_recomputed_op_count = 0;
+    m_recomputed_elements = 0;
+
+    vector<shared_ptr<Node>> ops = function->get_ordered_ops();
+    vector<size_t> live_bytes = MemoryAwareScheduling::estimate_live_bytes(ops);
+    m_original_peak_bytes =
+        live_bytes.empty() ? 0 : *max_element(live_bytes.begin(), live_bytes.end());
+    m_peak_bytes = m_original_peak_bytes;
+    while (m_peak_bytes > m_memory_budget)
+    {
+        size_t peak = max_element(live_bytes.begin(), live_bytes.end()) - live_bytes.begin();
+        unordered_map<const Node*, size_t> position;
+        unordered_map<const descriptor::Tensor*, size_t> last_use;
+        for (size_t i = 0; i < ops.size(); i++)
+        {
+            position[ops[i].get()] = i;
+            for (auto& input : ops[i]->inputs())
+            {
+                last_use[&input.get_tensor()] = i;
+            }
+        }
+        // True if value is computed before the op at index at runs and kept until it has run
+        auto is_live_at = [&](const Output<Node>& value, size_t at) {
+            const Node* producer = value.get_node();
+            auto producer_position = position.find(producer);
+            auto last = last_use.find(&value.get_tensor());
+            return producer_position != position.end() &&
+                   (is_persistent(producer) || (producer_position->second < at &&
+                                                last != last_use.end() && last->second >= at));
+        };
+
+        bool found = false;
+        Candidate best;
+        for (size_t i = 0; i < peak; i++)
+        {
+            shared_ptr<Node> node = ops[i];
+            if (!can_recompute(node.get()) || excluded.count(node.get()) != 0)
+            {
+                continue;
+            }
+
+            // Reads after the peak go to the copy, the value must not be read by the peak op
+            vector<Input<Node>> late_inputs;
+            size_t first_late = ops.size();
+            bool read_at_peak = false;
+            for (auto& input : node->output(0).get_target_inputs())
+            {
+                auto it = position.find(input.get_node());
+                if (it == position.end() || it->second < peak)
+                {
+                    continue;
+                }
+                if (it->second == peak)
+                {
+                    read_at_peak = true;
+                    break;
+                }
+                late_inputs.push_back(input);
+                first_late = min(first_late, it->second);
+            }
+            if (read_at_peak || late_inputs.empty())
+            {
+                continue;
+            }
+
+            // Each copy reads the original of an input, or a copy of it, that is live when the
+            // copy runs, or a copy of its own made just before
+            vector<pair<shared_ptr<Node>, OutputVector>> chain;
+            unordered_set<Node*> in_chain;
+            std::function<bool(const shared_ptr<Node>&, size_t)> add_to_chain =
+                [&](const shared_ptr<Node>& op, size_t depth) {
+                    OutputVector inputs;
+                    for (auto& input : op->inputs())
+                    {
+                        Output<Node> source = input.get_source_output();
+                        vector<Output<Node>> sources{source};
+                        auto it = copies.find(source.get_node());
+                        if (it != copies.end())
+                        {
+                            for (auto& copy : it->second)
+                            {
+                                sources.push_back(copy->output(0));
+                            }
+                        }
+                        auto live =
+                            find_if(sources.begin(), sources.end(), [&](const Output<Node>& s) {
+                                return is_live_at(s, first_late);
+                            });
+                        if (live != sources.end())
+                        {
+                            inputs.push_back(*live);
+                        }
+                        else if (in_chain.count(source.get_node()) != 0 ||
+                                 (depth < max_chain_depth && can_recompute(source.get_node()) &&
+                                  excluded.count(source.get_node()) == 0 &&
+                                  add_to_chain(source.get_node_shared_ptr(), depth + 1)))
+                        {
+                            inputs.push_back(source);
+                        }
+                        else
+                        {
+                            return false;
+                        }
+                    }
+                    chain.push_back(make_pair(op, inputs));
+                    in_chain.insert(op.get());
+                    return true;
+                };
+            if (!add_to_chain(node, 0))
+            {
+                continue;
+            }
+
+            size_t bytes =
+                shape_size(node->get_output_shape(0)) * node->get_output_element_type(0).size();
+            size_t elements = 0;
+            for (auto& link : chain)
+            {
+                elements += get_elements(link.first.get());
+            }
+            elements = max(elements, size_t(1));
+            if (found && bytes * best.m_elements < best.m_bytes * elements)
+            {
+                continue;
+            }
+            if (found && bytes * best.m_elements == best.m_bytes * elements &&
+                bytes <= best.m_bytes)
+            {
+                continue;
+            }
+
+            // Order the copy right before the first late read, after the peak
+            shared_ptr<Node> anchor = ops[peak];
+            for (size_t a = first_late - 1; a > peak; a--)
+            {
+                if (!is_persistent(ops[a].get()))
+                {
+                    anchor = ops[a];
+                    break;
+                }
+            }
+            best = Candidate{node, chain, late_inputs, anchor, bytes, elements};
+            found = true;
+        }
+        if (!found)
+        {
+            break;
+        }
+
+        unordered_map<Node*, shared_ptr<Node>> chain_copies;
+        for (auto& link : best.m_chain)
+        {
+            OutputVector inputs;
+            for (auto& input : link.second)
+            {
+                auto it = chain_copies.find(input.get_node());
+                inputs.push_back(it == chain_copies.end() ? input
+                                                          : it->second->output(input.get_index()));
+            }
+            auto copy = link.first->copy_with_new_inputs(inputs, {best.m_anchor});
+            // Backends that run this pass after choosing kernels and layouts, like the CPU
+            // backend, need the copy to keep those choices
+            copy->set_op_annotations(link.first->get_op_annotations());
+            for (size_t i = 0; i < copy->get_output_size(); i++)
+            {
+                auto& layout = link.first->output(i).get_tensor().get_tensor_layout();
+                if (layout)
+                {
+                    copy->output(i).get_tensor().set_tensor_layout(layout);
+                }
+            }
+            chain_copies[link.first.get()] = copy;
+            excluded.insert(copy.get());
+            m_recomputed_op_count++;
+        }
+        auto copy = chain_copies.at(best.m_node.get());
+        for (auto& input : best.m_late_inputs)
+        {
+            input.replace_source_output(copy->output(0));
+        }
+        copies[best.m_node.get()].push_back(copy);
+        excluded.insert(best.m_node.get());
+        excluded.insert(best.m_anchor.get());
+        m_recomputed_elements += best.m_elements;
+
+        ops = function->get_ordered_ops();
+        live_bytes = MemoryAwareScheduling::estimate_live_bytes(ops);
+        m_peak_bytes = *max_element(live_bytes.begin(), live_bytes.end());
+    }
+
+    NGRAPH_INFO << "Rematerialization: peak live bytes of " << function->get_name()
+                 << " reduced from " << m_original_peak_bytes << " to " << m_peak_bytes
+                 << " (budget " << m_memory_budget << ") by recomputing "
+                 << m_recomputed_op_count << " ops reading and writing "
+                 << m_recomputed_elements << " elements";
+    return m_recomputed_op_count > 0;
+}
@@ -0,0 +1,69 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <memory>
+
+#include "ngraph/pass/pass.hpp"
+
+namespace ngraph
+{
+    namespace pass
+    {
+        class Rematerialization;
+    }
+}
+
+/// \brief Recomputes intermediate values instead of keeping them live, until the peak bytes of
+///        live intermediate tensors fit a budget.
+///
+/// Backprop graphs built by autodiff::Adjoints keep every forward activation live until the
+/// backward ops that read it. While the peak is over the budget, this pass picks a value that
+/// is live across the peak op but not read by it, and gives its reads after the peak to a copy
+/// of its op that runs right before the first of them, ordered there by a control dependency.
+/// Values are picked by bytes saved per element the copies read and write. A copy reads values
+/// that are live at that point anyway, or copies of inputs that are not, recomputed just before
+/// it up to two levels deep, so no other lifetime is extended. Ops with state, such as random
+/// number generators, are never copied.
+///
+/// The peak is estimated like MemoryAwareScheduling does, in the function's current order, so
+/// Liveness and MemoryLayout run after this pass see the smaller peak. The interpreter and CPU
+/// backends run it when NGRAPH_REMATERIALIZATION_BUDGET_MB is set, and every run logs the
+/// peak before and after and the recomputation it added at INFO level.
+class NGRAPH_API ngraph::pass::Rematerialization : public FunctionPass
+{
+public:
+    /// \param memory_budget Peak live intermediate bytes to reach. With 0 every value that can
+    ///        be recomputed to lower the peak is.
+    Rematerialization(size_t memory_budget);
+    bool run_on_function(std::shared_ptr<ngraph::Function>) override;
+
+    /// \brief Peak live intermediate bytes before this pass ran
+    size_t get_original_peak_bytes() const { return m_original_peak_bytes; }
+    /// \brief Peak live intermediate bytes after this pass ran
+    size_t get_peak_bytes() const { return m_peak_bytes; }
+    /// \brief Number of ops added to recompute values
+    size_t get_recomputed_op_count() const { return m_recomputed_op_count; }
+    /// \brief Elements read and written by the added ops, a proxy for the extra compute
+    size_t get_recomputed_elements() const { return m_recomputed_elements; }
+private:
+    size_t m_memory_budget;
+    size_t m_original_peak_bytes = 0;
+    size_t m_peak_bytes = 0;
+    size_t m_recomputed_op_count = 0;
+    size_t m_recomputed_elements = 0;
+};
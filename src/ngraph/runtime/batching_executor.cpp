@@ -0,0 +1,240 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <cstring>
+
+#include "ngraph/runtime/batching_executor.hpp"
+#include "ngraph/specialize_function.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+runtime::BatchingExecutor::BatchingExecutor(const shared_ptr<Backend>& backend,
+                                            const shared_ptr<Function>& function,
+                                            const vector<size_t>& batch_sizes,
+                                            chrono::microseconds timeout)
+    : m_backend(backend)
+    , m_function(function)
+    , m_timeout(timeout)
+{
+    NGRAPH_CHECK(!batch_sizes.empty(), "BatchingExecutor needs at least one batch size");
+
+    const ParameterVector& parameters = m_function->get_parameters();
+    vector<element::Type> element_types;
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+        const PartialShape& shape = parameters[i]->get_output_partial_shape(0);
+        NGRAPH_CHECK(shape.rank().is_static() && shape.rank().get_length() > 0 &&
+                         shape[0].is_dynamic(),
+                     "BatchingExecutor parameter ",
+                     i,
+                     " must have a dynamic batch axis 0 but has shape ",
+                     shape);
+        element_types.push_back(parameters[i]->get_element_type());
+    }
+
+    for (size_t batch : batch_sizes)
+    {
+        NGRAPH_CHECK(batch > 0, "BatchingExecutor batch sizes must be positive");
+        vector<PartialShape> shapes;
+        for (auto& parameter : parameters)
+        {
+            const PartialShape& shape = parameter->get_output_partial_shape(0);
+            vector<Dimension> dimensions;
+            for (size_t axis = 0; axis < shape.rank().get_length(); axis++)
+            {
+                dimensions.push_back(shape[axis]);
+            }
+            dimensions[0] = batch;
+            shapes.push_back(PartialShape(dimensions));
+        }
+        auto specialized = specialize_function(
+            m_function, element_types, shapes, vector<void*>(parameters.size(), nullptr));
+        for (auto& result : specialized->get_results())
+        {
+            const PartialShape& shape = result->get_output_partial_shape(0);
+            NGRAPH_CHECK(shape.is_static() && shape.rank().get_length() > 0 &&
+                             shape[0].get_length() == batch,
+                         "BatchingExecutor results must have the batch along axis 0 but ",
+                         *result,
+                         " has shape ",
+                         shape);
+        }
+        m_executables[batch] = m_backend->compile(specialized);
+    }
+
+    m_thread = thread(&BatchingExecutor::run, this);
+}
+
+runtime::BatchingExecutor::~BatchingExecutor()
+{
+    {
+        lock_guard<mutex> guard(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+future<runtime::BatchingExecutor::Result>
+    runtime::BatchingExecutor::submit(const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    // Every compiled variant has the same parameter shapes apart from the batch
+    const ParameterVector& parameters = m_executables.begin()->second->get_parameters();
+    NGRAPH_CHECK(inputs.size() == parameters.size(),
+                 "BatchingExecutor expected ",
+                 parameters.size(),
+                 " inputs but got ",
+                 inputs.size());
+
+    unique_ptr<Request> request(new Request());
+    request->m_batch = inputs[0]->get_shape().empty() ? 0 : inputs[0]->get_shape()[0];
+    NGRAPH_CHECK(request->m_batch > 0 && request->m_batch <= get_max_batch_size(),
+                 "BatchingExecutor request batch must be between 1 and ",
+                 get_max_batch_size());
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        Shape shape = inputs[i]->get_shape();
+        Shape expected = parameters[i]->get_shape();
+        NGRAPH_CHECK(!shape.empty() && shape[0] == request->m_batch,
+                     "BatchingExecutor inputs must all have the same batch");
+        shape[0] = expected[0];
+        NGRAPH_CHECK(shape == expected &&
+                         inputs[i]->get_element_type() == parameters[i]->get_element_type(),
+                     "BatchingExecutor input ",
+                     i,
+                     " does not match parameter ",
+                     *parameters[i]);
+    }
+    request->m_inputs = inputs;
+    request->m_arrival = chrono::steady_clock::now();
+    future<Result> result = request->m_promise.get_future();
+
+    {
+        lock_guard<mutex> guard(m_mutex);
+        NGRAPH_CHECK(!m_stopping, "BatchingExecutor is shutting down");
+        m_queued_batch += request->m_batch;
+        m_queue.push_back(move(request));
+    }
+    m_condition.notify_all();
+    return result;
+}
+
+size_t runtime::BatchingExecutor::get_call_count() const
+{
+    lock_guard<mutex> guard(m_mutex);
+    return m_call_count;
+}
+
+void runtime::BatchingExecutor::run()
+{
+    unique_lock<mutex> lock(m_mutex);
+    while (true)
+    {
+        m_condition.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+        if (m_queue.empty())
+        {
+            break;
+        }
+
+        // Wait for a full batch, but not past the oldest request's deadline
+        auto deadline = m_queue.front()->m_arrival + m_timeout;
+        m_condition.wait_until(lock, deadline, [this]() {
+            return m_stopping || m_queued_batch >= get_max_batch_size();
+        });
+
+        vector<unique_ptr<Request>> requests;
+        size_t batch = 0;
+        while (!m_queue.empty() && batch + m_queue.front()->m_batch <= get_max_batch_size())
+        {
+            batch += m_queue.front()->m_batch;
+            requests.push_back(move(m_queue.front()));
+            m_queue.pop_front();
+        }
+        m_queued_batch -= batch;
+
+        lock.unlock();
+        run_batch(requests, batch);
+        lock.lock();
+        m_call_count++;
+    }
+}
+
+void runtime::BatchingExecutor::run_batch(vector<unique_ptr<Request>>& requests, size_t batch)
+{
+    // The smallest compiled batch that holds every request, the remaining rows are zero
+    auto executable = m_executables.lower_bound(batch)->second;
+    vector<Result> results(requests.size());
+    try
+    {
+        vector<shared_ptr<runtime::Tensor>> inputs;
+        const ParameterVector& parameters = executable->get_parameters();
+        for (size_t i = 0; i < parameters.size(); i++)
+        {
+            auto tensor = m_backend->create_tensor(parameters[i]->get_element_type(),
+                                                   parameters[i]->get_shape());
+            vector<char> data(tensor->get_size_in_bytes(), 0);
+            size_t offset = 0;
+            for (auto& request : requests)
+            {
+                const shared_ptr<runtime::Tensor>& input = request->m_inputs[i];
+                input->read(data.data() + offset, input->get_size_in_bytes());
+                offset += input->get_size_in_bytes();
+            }
+            tensor->write(data.data(), data.size());
+            inputs.push_back(tensor);
+        }
+
+        vector<shared_ptr<runtime::Tensor>> outputs;
+        for (auto& result : executable->get_results())
+        {
+            outputs.push_back(
+                m_backend->create_tensor(result->get_element_type(), result->get_shape()));
+        }
+
+        executable->call(outputs, inputs);
+
+        for (auto& output : outputs)
+        {
+            vector<char> data(output->get_size_in_bytes());
+            output->read(data.data(), data.size());
+            size_t row_bytes = data.size() / output->get_shape()[0];
+            size_t offset = 0;
+            for (size_t i = 0; i < requests.size(); i++)
+            {
+                Shape shape = output->get_shape();
+                shape[0] = requests[i]->m_batch;
+                auto tensor = m_backend->create_tensor(output->get_element_type(), shape);
+                tensor->write(data.data() + offset, row_bytes * requests[i]->m_batch);
+                offset += row_bytes * requests[i]->m_batch;
+                results[i].push_back(tensor);
+            }
+        }
+    }
+    catch (...)
+    {
+        for (auto& request : requests)
+        {
+            request->m_promise.set_exception(current_exception());
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < requests.size(); i++)
+    {
+        requests[i]->m_promise.set_value(results[i]);
+    }
+}
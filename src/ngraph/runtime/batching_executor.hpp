@@ -0,0 +1,99 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ngraph/function.hpp"
+#include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/executable.hpp"
+#include "ngraph/runtime/tensor.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class BatchingExecutor;
+    }
+}
+
+/// \brief Coalesces requests for a Function into batched calls.
+///
+/// Every parameter and result of the function has its batch along axis 0, and the batch
+/// dimension must be dynamic. One Executable is compiled up front for each of the given batch
+/// sizes, so backends without dynamic shape support can be used. Queued requests are
+/// concatenated along axis 0 until the largest batch size is reached or the oldest request
+/// has waited for the timeout. The batch is padded with zeros up to the smallest compiled batch
+/// size that holds it, run with a single call, and each request receives its rows of the
+/// results through its future.
+class NGRAPH_API ngraph::runtime::BatchingExecutor
+{
+public:
+    using Result = std::vector<std::shared_ptr<runtime::Tensor>>;
+
+    BatchingExecutor(const std::shared_ptr<Backend>& backend,
+                     const std::shared_ptr<Function>& function,
+                     const std::vector<size_t>& batch_sizes,
+                     std::chrono::microseconds timeout);
+    /// \brief Runs the requests still queued, then stops the batching thread
+    ~BatchingExecutor();
+
+    BatchingExecutor(const BatchingExecutor&) = delete;
+    BatchingExecutor& operator=(const BatchingExecutor&) = delete;
+
+    /// \brief Queue a request. All inputs must have the same number of samples along axis 0,
+    ///        at most get_max_batch_size().
+    /// \returns The result tensors, each holding the request's samples along axis 0
+    std::future<Result> submit(const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+
+    size_t get_max_batch_size() const { return m_executables.rbegin()->first; }
+    /// \brief The number of batched calls made so far
+    size_t get_call_count() const;
+
+private:
+    struct Request
+    {
+        std::vector<std::shared_ptr<runtime::Tensor>> m_inputs;
+        size_t m_batch;
+        std::promise<Result> m_promise;
+        std::chrono::steady_clock::time_point m_arrival;
+    };
+
+    void run();
+    void run_batch(std::vector<std::unique_ptr<Request>>& requests, size_t batch);
+
+    std::shared_ptr<Backend> m_backend;
+    std::shared_ptr<Function> m_function;
+    std::map<size_t, std::shared_ptr<Executable>> m_executables;
+    std::chrono::microseconds m_timeout;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::unique_ptr<Request>> m_queue;
+    size_t m_queued_batch = 0;
+    size_t m_call_count = 0;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
@@ -31,17 +31,21 @@ runtime::LRUCache::LRUCache()
     {
         m_cache_size = atoi(cache_size);
     }
-
-    m_map = {};
-    m_list = {};
 }
 
 // Destructor
 runtime::LRUCache::~LRUCache()
 {
-    m_list.clear();
-    m_map.clear();
-    m_clone_function_map.clear();
+}
+
+size_t runtime::LRUCache::ShapeHash::operator()(const vector<int>& shape) const
+{
+    size_t seed = shape.size();
+    for (int dim : shape)
+    {
+        seed ^= std::hash<int>()(dim) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
 }
 
 void runtime::LRUCache::convert_shape_to_string(const vector<int>& shape, ostringstream& key)
@@ -52,79 +56,213 @@ void runtime::LRUCache::convert_shape_to_string(const vector<int>& shape, ostrin
     }
 }
 
-void runtime::LRUCache::add_entry(const vector<int>& shape,
-                                  shared_ptr<runtime::Executable> exec,
-                                  shared_ptr<Function> func)
+size_t runtime::LRUCache::get_entry_bytes(const Entry& entry)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    ostringstream key;
-    // check if the list is empty
-    if (m_list.size() == m_cache_size)
+    size_t bytes = 0;
+    if (entry.second == nullptr)
+    {
+        return bytes;
+    }
+    for (auto& node : entry.second->get_ops())
     {
-        ostringstream key;
-        convert_shape_to_string(m_list.back(), key);
-        m_list.pop_back();
-        m_map.erase(key.str());
+        // A result shares the tensor it returns
+        if (node->is_output())
+        {
+            continue;
+        }
+        for (auto& output : node->outputs())
+        {
+            if (output.get_partial_shape().is_static() && output.get_element_type().is_static())
+            {
+                bytes += shape_size(output.get_shape()) * output.get_element_type().size();
+            }
+        }
     }
+    return bytes;
+}
 
-    convert_shape_to_string(shape, key);
-    m_map.insert({key.str(), exec});
-    m_list.push_front(shape);
-    m_clone_function_map.insert({key.str(), func});
+runtime::LRUCache::Shard& runtime::LRUCache::get_shard(const vector<int>& shape)
+{
+    // Mix the high bits in so that keys differing only in their last dimension spread out
+    size_t hash = ShapeHash()(shape);
+    return m_shards[(hash ^ (hash >> 16)) % s_num_shards];
 }
 
-bool runtime::LRUCache::is_cached(const vector<int>& shape)
+size_t runtime::LRUCache::get_shard_capacity() const
+{
+    return (m_cache_size + s_num_shards - 1) / s_num_shards;
+}
+
+void runtime::LRUCache::evict(Shard& shard, size_t max_entries)
 {
-    for (auto itr = m_list.begin(); itr != m_list.end(); itr++)
+    while (shard.m_list.size() > max_entries)
     {
-        if (*itr == shape)
+        erase_lru(shard);
+    }
+}
+
+void runtime::LRUCache::erase_lru(Shard& shard)
+{
+    auto it = shard.m_map.find(shard.m_list.back());
+    m_size_bytes -= it->second.m_bytes;
+    shard.m_map.erase(it);
+    shard.m_list.pop_back();
+}
+
+void runtime::LRUCache::evict_bytes(const vector<int>& keep)
+{
+    for (Shard& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        while (m_size_bytes > m_cache_size_bytes && !shard.m_list.empty() &&
+               shard.m_list.back() != keep)
+        {
+            erase_lru(shard);
+        }
+        if (m_size_bytes <= m_cache_size_bytes)
         {
-            return true;
+            return;
         }
     }
-    return false;
 }
 
-shared_ptr<runtime::Executable> runtime::LRUCache::get_cached_entry(const vector<int>& shape)
+void runtime::LRUCache::touch(Shard& shard, Slot& slot)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    ostringstream key;
-    convert_shape_to_string(shape, key);
+    shard.m_list.splice(shard.m_list.begin(), shard.m_list, slot.m_lru_position);
+}
 
-    // find the entry and return the function
-    auto it = m_map.find(key.str());
-    if (it == m_map.end())
+runtime::LRUCache::Entry runtime::LRUCache::get_or_compile(const vector<int>& shape,
+                                                           const CompileFunction& compile,
+                                                           bool* was_cached)
+{
+    Shard& shard = get_shard(shape);
+    shared_future<Entry> entry;
+    unique_ptr<promise<Entry>> compiling;
+    size_t id = 0;
     {
-        throw ngraph_error("Entry not found in cache");
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        auto it = shard.m_map.find(shape);
+        if (it != shard.m_map.end())
+        {
+            touch(shard, it->second);
+            entry = it->second.m_entry;
+        }
+        else
+        {
+            compiling.reset(new promise<Entry>());
+            entry = compiling->get_future().share();
+            size_t capacity = get_shard_capacity();
+            if (capacity > 0)
+            {
+                evict(shard, capacity - 1);
+                shard.m_list.push_front(shape);
+                id = shard.m_next_id++;
+                shard.m_map.insert({shape, Slot{entry, shard.m_list.begin(), id, 0}});
+            }
+        }
     }
-    else
+    if (was_cached)
     {
-        // update list to push this reference to the front
-        for (auto itr = m_list.begin(); itr != m_list.end(); itr++)
+        *was_cached = (compiling == nullptr);
+    }
+    if (compiling == nullptr)
+    {
+        // Blocks if another caller is still compiling this entry
+        return entry.get();
+    }
+
+    // Compile outside the shard lock so hits on other keys are not held up
+    try
+    {
+        Entry compiled = compile();
+        size_t bytes = get_entry_bytes(compiled);
         {
-            if (*itr == shape)
+            std::lock_guard<std::mutex> guard(shard.m_mutex);
+            auto it = shard.m_map.find(shape);
+            if (it != shard.m_map.end() && it->second.m_id == id)
             {
-                m_list.remove(shape);
-                m_list.push_front(shape);
-                break;
+                it->second.m_bytes = bytes;
+                m_size_bytes += bytes;
             }
         }
-        return it->second;
+        compiling->set_value(compiled);
+    }
+    catch (...)
+    {
+        compiling->set_exception(current_exception());
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        auto it = shard.m_map.find(shape);
+        if (it != shard.m_map.end() && it->second.m_id == id)
+        {
+            shard.m_list.erase(it->second.m_lru_position);
+            shard.m_map.erase(it);
+        }
+    }
+    if (m_cache_size_bytes > 0 && m_size_bytes > m_cache_size_bytes)
+    {
+        evict_bytes(shape);
+    }
+    return entry.get();
+}
+
+void runtime::LRUCache::add_entry(const vector<int>& shape,
+                                  shared_ptr<runtime::Executable> exec,
+                                  shared_ptr<Function> func)
+{
+    get_or_compile(shape, [&]() { return Entry(exec, func); });
+}
+
+void runtime::LRUCache::set_cache_size(size_t cache_size)
+{
+    m_cache_size = cache_size;
+    for (Shard& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        evict(shard, get_shard_capacity());
     }
 }
 
+void runtime::LRUCache::set_cache_size_bytes(size_t cache_size_bytes)
+{
+    m_cache_size_bytes = cache_size_bytes;
+    if (m_cache_size_bytes > 0 && m_size_bytes > m_cache_size_bytes)
+    {
+        evict_bytes(vector<int>());
+    }
+}
+
+bool runtime::LRUCache::is_cached(const vector<int>& shape)
+{
+    Shard& shard = get_shard(shape);
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    return shard.m_map.find(shape) != shard.m_map.end();
+}
+
+runtime::LRUCache::Entry runtime::LRUCache::get_ready_entry(const vector<int>& shape)
+{
+    shared_future<Entry> entry;
+    {
+        Shard& shard = get_shard(shape);
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        auto it = shard.m_map.find(shape);
+        if (it == shard.m_map.end())
+        {
+            throw ngraph_error("Entry not found in cache");
+        }
+        touch(shard, it->second);
+        entry = it->second.m_entry;
+    }
+    return entry.get();
+}
+
+shared_ptr<runtime::Executable> runtime::LRUCache::get_cached_entry(const vector<int>& shape)
+{
+    return get_ready_entry(shape).first;
+}
+
 // Need the clone function to get the output shape so that
 // storage can be allocated for output
 shared_ptr<Function> runtime::LRUCache::get_cloned_function(const vector<int>& shape)
 {
-    std::lock_guard<std::mutex> guard(m_mutex);
-    ostringstream key;
-    convert_shape_to_string(shape, key);
-    // find the entry and return the function
-    auto it = m_clone_function_map.find(key.str());
-    if (it == m_clone_function_map.end())
-    {
-        throw ngraph_error("Cloned function not found");
-    }
-    return it->second;
+    return get_ready_entry(shape).second;
 }
@@ -17,6 +17,9 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <iterator>
 #include <list>
@@ -24,6 +27,7 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include "ngraph/function.hpp"
 #include "ngraph/runtime/executable.hpp"
 #include "ngraph/shape.hpp"
@@ -32,16 +36,33 @@ namespace ngraph
 {
     namespace runtime
     {
+        /// \brief Cache of compiled executables keyed on the flattened input shapes (and
+        ///        shape-relevant input values) they were specialized for.
+        ///
+        /// Keys are hashed into independently locked shards, so lookups of different shapes
+        /// do not contend on a single mutex and no string key is built per lookup. The
+        /// least recently used entries of a shard are evicted once the shard is full.
         class LRUCache : public std::enable_shared_from_this<LRUCache>
         {
         public:
-            using GraphCache = std::unordered_map<std::string, std::shared_ptr<Executable>>;
-            using ClonedFunctionMap = std::unordered_map<std::string, std::shared_ptr<Function>>;
+            using Entry = std::pair<std::shared_ptr<Executable>, std::shared_ptr<Function>>;
+            using CompileFunction = std::function<Entry()>;
 
             LRUCache();
 
             virtual ~LRUCache();
 
+            /// \brief Returns the entry for shape, calling compile to create it on a miss.
+            ///        Concurrent callers that miss on the same shape wait for the first
+            ///        caller's compilation instead of compiling it again. If compile throws,
+            ///        the exception is passed to every waiter and nothing is cached.
+            /// \param shape The cache key
+            /// \param compile Creates the entry on a miss
+            /// \param was_cached If not null, set to false if this call ran compile
+            Entry get_or_compile(const std::vector<int>& shape,
+                                 const CompileFunction& compile,
+                                 bool* was_cached = nullptr);
+
             void add_entry(const std::vector<int>& shape,
                            std::shared_ptr<Executable> exec,
                            std::shared_ptr<Function> func);
@@ -49,13 +70,65 @@ namespace ngraph
             std::shared_ptr<Executable> get_cached_entry(const std::vector<int>& shape);
             void convert_shape_to_string(const std::vector<int>& shape, std::ostringstream& key);
             std::shared_ptr<Function> get_cloned_function(const std::vector<int>& shape);
+            /// \brief Set the maximum number of entries, evicting the least recently used
+            ///        entries beyond it. Defaults to NGRAPH_CACHE_SIZE or 1024. The limit is
+            ///        split evenly across the shards.
+            void set_cache_size(size_t cache_size);
+            size_t get_cache_size() const { return m_cache_size; }
+            /// \brief Set the maximum total size of the entries, evicting the least recently
+            ///        used entries of each shard in turn beyond it. 0, the default, means no
+            ///        limit. The size of an entry is estimated as the bytes of all the tensors
+            ///        of its function, what its executable needs without reusing memory. The
+            ///        most recently compiled entry is kept even if it alone is larger.
+            void set_cache_size_bytes(size_t cache_size_bytes);
+            size_t get_cache_size_bytes() const { return m_cache_size_bytes; }
+            /// \brief Returns the estimated total size of the compiled entries.
+            size_t get_size_bytes() const { return m_size_bytes; }
 
         private:
-            int m_cache_size;
-            GraphCache m_map;
-            ClonedFunctionMap m_clone_function_map;
-            std::list<std::vector<int>> m_list;
-            std::mutex m_mutex;
+            struct ShapeHash
+            {
+                size_t operator()(const std::vector<int>& shape) const;
+            };
+
+            struct Slot
+            {
+                std::shared_future<Entry> m_entry;
+                std::list<std::vector<int>>::iterator m_lru_position;
+                // Distinguishes this slot from a later one for the same key
+                size_t m_id;
+                // Estimated size of the entry, 0 until it is compiled
+                size_t m_bytes;
+            };
+
+            struct Shard
+            {
+                std::mutex m_mutex;
+                std::unordered_map<std::vector<int>, Slot, ShapeHash> m_map;
+                // Most recently used first
+                std::list<std::vector<int>> m_list;
+                size_t m_next_id = 0;
+            };
+
+            static const size_t s_num_shards = 16;
+
+            static size_t get_entry_bytes(const Entry& entry);
+            Shard& get_shard(const std::vector<int>& shape);
+            size_t get_shard_capacity() const;
+            // Requires the shard's mutex to be held
+            void evict(Shard& shard, size_t max_entries);
+            // Requires the shard's mutex to be held
+            void erase_lru(Shard& shard);
+            // Evicts entries other than keep, shard by shard, until the total size fits
+            void evict_bytes(const std::vector<int>& keep);
+            // Requires the shard's mutex to be held
+            void touch(Shard& shard, Slot& slot);
+            Entry get_ready_entry(const std::vector<int>& shape);
+
+            std::atomic<size_t> m_cache_size;
+            std::atomic<size_t> m_cache_size_bytes{0};
+            std::atomic<size_t> m_size_bytes{0};
+            Shard m_shards[s_num_shards];
         };
     }
 }
@@ -20,16 +20,21 @@
 
 #include "cpu_backend_visibility.h"
 
+#include "ngraph/chrome_trace.hpp"
 #include "ngraph/component_manager.hpp"
+#include "ngraph/cpio.hpp"
 #include "ngraph/graph_util.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder_registry.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
+#include "ngraph/runtime/cpu/cpu_hardware_counters.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/static_initialize.hpp"
+#include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 
 #ifdef NGRAPH_MLIR_ENABLE
@@ -40,6 +45,8 @@
 using namespace ngraph;
 using namespace std;
 
+static const string s_cpu_save_info = "CPU Save File 1.0";
+
 extern "C" CPU_BACKEND_API void ngraph_register_cpu_backend()
 {
     runtime::BackendManager::register_backend("CPU", [](const std::string& /* config */) {
@@ -116,8 +123,15 @@ shared_ptr<runtime::Executable>
             return rc;
         }
     }
-    rc = make_shared<CPU_Executable>(
-        func, pass_config, get_host_memory_allocator(), performance_counters_enabled);
+    {
+        runtime::event::Duration compile_event("compile", "CPU");
+        rc = make_shared<CPU_Executable>(func,
+                                         pass_config,
+                                         get_host_memory_allocator(),
+                                         performance_counters_enabled,
+                                         m_numa_node,
+                                         m_constant_registry);
+    }
     {
         std::lock_guard<std::mutex> guard(m_exec_map_mutex);
         m_exec_map.insert({func, rc});
@@ -128,19 +142,72 @@ shared_ptr<runtime::Executable>
 runtime::cpu::CPU_Executable::CPU_Executable(shared_ptr<Function> func,
                                              ngraph::pass::PassConfig& pass_config,
                                              Allocator* allocator,
-                                             bool performance_counters_enabled)
+                                             bool performance_counters_enabled,
+                                             int numa_node,
+                                             const shared_ptr<ngraph::pass::ConstantRegistry>&
+                                                 constant_registry)
 {
+    // Compilation rewrites func in place so the source graph must be captured up front
+    if (pass_config.get_pass_attribute("CPU_Executable::Saveable"))
+    {
+        m_saved_model = serialize(func, 0);
+        m_saved_pass_config = pass_config;
+    }
+
     FunctionInstance& instance = m_function_instance;
     if (instance.m_external_function == nullptr)
     {
         instance.m_external_function = make_shared<CPU_ExternalFunction>(func);
         instance.m_external_function->m_emit_timing = performance_counters_enabled;
+        instance.m_external_function->m_emit_hw_counters =
+            performance_counters_enabled && HardwareCounters::is_enabled();
+        instance.m_external_function->m_numa_node = numa_node;
+        instance.m_external_function->m_constant_registry = constant_registry;
         auto cf = instance.m_external_function->make_call_frame(pass_config, allocator);
         instance.m_call_frame = dynamic_pointer_cast<CPU_CallFrame>(cf);
     }
     set_parameters_and_results(*func);
 }
 
+void runtime::cpu::CPU_Executable::save(ostream& out)
+{
+    if (m_saved_model.empty())
+    {
+        throw ngraph_error(
+            "CPU_Executable::save requires compiling with the CPU_Executable::Saveable pass "
+            "attribute");
+    }
+    cpio::Writer writer(out, cpio::Version::V2);
+    writer.write("save_info", s_cpu_save_info.data(), s_cpu_save_info.size());
+    writer.write("model", m_saved_model.data(), m_saved_model.size());
+
+    // One "<kind> <name> <value>" record per line
+    stringstream ss;
+    for (auto& p : m_saved_pass_config.get_enables())
+    {
+        ss << "enable " << p.first << " " << p.second << "\n";
+    }
+    for (auto& p : m_saved_pass_config.get_pass_attributes())
+    {
+        ss << "attribute " << p.first << " " << p.second << "\n";
+    }
+    string pass_config = ss.str();
+    writer.write("pass_config", pass_config.data(), pass_config.size());
+}
+
+runtime::cpu::CPU_Executable::~CPU_Executable()
+{
+    {
+        lock_guard<mutex> guard(m_async_mutex);
+        m_async_stopping = true;
+    }
+    m_async_condition.notify_all();
+    if (m_async_thread.joinable())
+    {
+        m_async_thread.join();
+    }
+}
+
 std::shared_ptr<ngraph::runtime::cpu::CPU_CallFrame> runtime::cpu::CPU_Executable::get_call_frame()
 {
     FunctionInstance& instance = m_function_instance;
@@ -164,6 +231,140 @@ bool runtime::cpu::CPU_Executable::call(const vector<shared_ptr<runtime::Tensor>
     return rc;
 }
 
+future<bool>
+    runtime::cpu::CPU_Executable::call_async(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                             const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    vector<shared_ptr<runtime::cpu::CPUTensorView>> tensors;
+    for (auto& tensor : inputs)
+    {
+        tensors.push_back(static_pointer_cast<runtime::cpu::CPUTensorView>(tensor));
+    }
+    for (auto& tensor : outputs)
+    {
+        tensors.push_back(static_pointer_cast<runtime::cpu::CPUTensorView>(tensor));
+    }
+    // Taken before queueing so that a later write or read of the same tensor waits for us
+    for (auto& tensor : tensors)
+    {
+        tensor->begin_async_use();
+    }
+
+    auto result = make_shared<promise<bool>>();
+    future<bool> future_result = result->get_future();
+    auto task = [this, outputs, inputs, tensors, result]() {
+        try
+        {
+            result->set_value(call(outputs, inputs));
+        }
+        catch (...)
+        {
+            result->set_exception(current_exception());
+        }
+        for (auto& tensor : tensors)
+        {
+            tensor->end_async_use();
+        }
+    };
+
+    {
+        lock_guard<mutex> guard(m_async_mutex);
+        if (!m_async_thread.joinable())
+        {
+            m_async_thread = thread(&CPU_Executable::run_async_calls, this);
+        }
+        m_async_calls.push_back(task);
+    }
+    m_async_condition.notify_one();
+    return future_result;
+}
+
+void runtime::cpu::CPU_Executable::run_async_calls()
+{
+    unique_lock<mutex> lock(m_async_mutex);
+    while (true)
+    {
+        m_async_condition.wait(lock,
+                               [this]() { return m_async_stopping || !m_async_calls.empty(); });
+        if (m_async_calls.empty())
+        {
+            break;
+        }
+        function<void()> task = move(m_async_calls.front());
+        m_async_calls.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+shared_ptr<runtime::Executable> runtime::cpu::CPU_Backend::load(istream& in)
+{
+    cpio::Reader reader(in);
+    auto read_entry = [&reader](const string& name) {
+        vector<char> buffer;
+        if (const cpio::FileInfo* info = reader.find(name))
+        {
+            buffer = reader.read(*info);
+        }
+        return buffer;
+    };
+    vector<char> save_info = read_entry("save_info");
+    if (string(save_info.data(), save_info.size()) != s_cpu_save_info)
+    {
+        throw ngraph_error("CPU_Backend::load expects a \"" + s_cpu_save_info +
+                           "\" but the stream holds \"" +
+                           string(save_info.data(), save_info.size()) + "\"");
+    }
+
+    ngraph::pass::PassConfig pass_config;
+    vector<char> saved_pass_config = read_entry("pass_config");
+    stringstream ss(string(saved_pass_config.data(), saved_pass_config.size()));
+    string kind;
+    string name;
+    bool value;
+    while (ss >> kind >> name >> value)
+    {
+        if (kind == "enable")
+        {
+            pass_config.set_pass_enable(name, value);
+        }
+        else if (kind == "attribute")
+        {
+            pass_config.set_pass_attribute(name, value);
+        }
+        else
+        {
+            throw ngraph_error("Unexpected pass config record in CPU save file: " + kind);
+        }
+    }
+    // The compiled functors and memory plan are not saved, the graph is compiled again
+    vector<char> model = read_entry("model");
+    shared_ptr<Function> func = deserialize(model.data(), model.size());
+    return make_shared<CPU_Executable>(
+        func, pass_config, get_host_memory_allocator(), false, m_numa_node, m_constant_registry);
+}
+
+bool runtime::cpu::CPU_Executable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                        const vector<shared_ptr<runtime::Tensor>>& inputs,
+                                        size_t stream)
+{
+    FunctionInstance& instance = m_function_instance;
+    if (instance.m_external_function == nullptr)
+    {
+        throw runtime_error("compile() must be called before call().");
+    }
+
+    instance.m_call_frame->call(outputs, inputs, stream);
+
+    return true;
+}
+
+size_t runtime::cpu::CPU_Executable::get_num_streams()
+{
+    return m_function_instance.m_call_frame->get_num_streams();
+}
+
 void runtime::cpu::CPU_Backend::remove_compiled_function(shared_ptr<Executable> exec)
 {
     std::lock_guard<std::mutex> guard(m_exec_map_mutex);
@@ -336,3 +537,32 @@ bool runtime::cpu::CPU_Backend::is_supported_property(const Property prop) const
 
     return false;
 }
+
+bool runtime::cpu::CPU_Backend::set_config(const map<string, string>& config, string& error)
+{
+    error = "";
+    auto it = config.find("numa_node");
+    if (it == config.end() || config.size() != 1)
+    {
+        error = "CPU Backend: only the numa_node configuration is supported";
+        return false;
+    }
+    int numa_node;
+    try
+    {
+        numa_node = stoi(it->second);
+    }
+    catch (const exception&)
+    {
+        error = "CPU Backend: invalid numa_node '" + it->second + "'";
+        return false;
+    }
+    if (numa_node >= 0 && executor::GetCPUExecutor().get_numa_pools(numa_node).empty())
+    {
+        error = "CPU Backend: no thread pool is bound to NUMA node " + it->second +
+                ", see NGRAPH_CPU_NUMA_AWARE";
+        return false;
+    }
+    m_numa_node = numa_node < 0 ? -1 : numa_node;
+    return true;
+}
@@ -16,11 +16,18 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
 
 #include "cpu_backend_visibility.h"
+#include "ngraph/pass/cse.hpp"
 #include "ngraph/pass/pass_config.hpp"
 #include "ngraph/runtime/allocator.hpp"
 #include "ngraph/runtime/backend.hpp"
@@ -63,6 +70,14 @@ namespace ngraph
                             ngraph::pass::PassConfig& pass_config,
                             bool enable_performance_counters = false) override;
 
+                /// \brief Loads a model and pass configuration saved with CPU_Executable::save
+                ///        and compiles it. This is not a compiled-executable cache: every pass,
+                ///        the memory assignment and the MKLDNN primitives run again, so loading
+                ///        costs as much as compiling and does not shorten a cold start.
+                /// \throws ngraph_error if the stream is not a CPU save file of this version
+                std::shared_ptr<ngraph::runtime::Executable>
+                    load(std::istream& input_stream) override;
+
                 void remove_compiled_function(std::shared_ptr<Executable> exec) override;
 
                 Allocator* get_host_memory_allocator() override;
@@ -71,6 +86,12 @@ namespace ngraph
                 bool is_supported(const Node& node) const override;
                 bool is_supported_property(const Property prop) const override;
 
+                /// \brief Supports "numa_node", the NUMA node that executables compiled from
+                ///        now on run and allocate their intermediates on, or "-1" for any.
+                ///        Requires NGRAPH_CPU_NUMA_AWARE.
+                bool set_config(const std::map<std::string, std::string>& config,
+                                std::string& error) override;
+
             private:
                 // this mutex will be used to protect the addition and deletion
                 // of function to m_exec_map across multiple threads
@@ -78,6 +99,10 @@ namespace ngraph
                 std::unordered_map<std::shared_ptr<Function>, std::shared_ptr<Executable>>
                     m_exec_map;
                 Allocator* m_allocator;
+                int m_numa_node = -1;
+                // Constant data shared by every function this backend compiles
+                std::shared_ptr<ngraph::pass::ConstantRegistry> m_constant_registry =
+                    std::make_shared<ngraph::pass::ConstantRegistry>();
             };
 
             class CPU_BACKEND_API CPU_Executable : public runtime::Executable
@@ -86,10 +111,37 @@ namespace ngraph
                 CPU_Executable(std::shared_ptr<Function> func,
                                ngraph::pass::PassConfig& pass_config,
                                Allocator* allocator,
-                               bool performance_counters_enabled);
+                               bool performance_counters_enabled,
+                               int numa_node = -1,
+                               const std::shared_ptr<ngraph::pass::ConstantRegistry>&
+                                   constant_registry = nullptr);
+                ~CPU_Executable() override;
+
                 bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                           const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
 
+                /// \brief Queues the call on a worker thread owned by this executable. The
+                ///        tensors block reads and writes until the call is done with them, so
+                ///        the next stage's inputs can be written while this one runs.
+                std::future<bool> call_async(
+                    const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
+
+                /// \brief Runs the executable on one of its streams. See CPU_CallFrame::call.
+                bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                          const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                          size_t stream);
+
+                size_t get_num_streams();
+
+                /// \brief Saves the model this executable was compiled from and its pass
+                ///        configuration, not its compiled form. The post-pass graph holds CPU
+                ///        ops and MKLDNN layouts that have no serialized form, so the buffer
+                ///        offsets and layout descriptors are not saved either. Only available
+                ///        if compiled with the "CPU_Executable::Saveable" pass attribute,
+                ///        since compilation rewrites the graph in place.
+                void save(std::ostream& output_stream) override;
+
                 std::shared_ptr<CPU_CallFrame> get_call_frame();
 
                 std::vector<PerformanceCounter> get_performance_data() const override;
@@ -123,6 +175,8 @@ namespace ngraph
             private:
                 std::shared_ptr<ngraph::op::Parameter> get_parameter(size_t index) const;
                 std::shared_ptr<ngraph::op::Result> get_result(size_t index) const;
+                void run_async_calls();
+
                 class FunctionInstance
                 {
                 public:
@@ -130,6 +184,14 @@ namespace ngraph
                     std::shared_ptr<CPU_CallFrame> m_call_frame = nullptr;
                     bool m_performance_counters_enabled = false;
                 } m_function_instance;
+                std::string m_saved_model;
+                ngraph::pass::PassConfig m_saved_pass_config;
+
+                std::mutex m_async_mutex;
+                std::condition_variable m_async_condition;
+                std::deque<std::function<void()>> m_async_calls;
+                bool m_async_stopping = false;
+                std::thread m_async_thread;
             };
         }
     }
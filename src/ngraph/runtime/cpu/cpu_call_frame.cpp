@@ -17,8 +17,10 @@
 #include <algorithm>
 #include <thread>
 
+#include "ngraph/chrome_trace.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/cpu_tracing.hpp"
@@ -72,6 +74,9 @@ void runtime::cpu::CPU_CallFrame::inner_call(
     const size_t id,
     const bool disable_caching)
 {
+    runtime::event::Duration call_event("call", "CPU");
+    // Also flush when tracing is turned off mid-call, so no op span outlives the call
+    bool trace_ops = runtime::event::Manager::is_tracing_enabled();
     vector<void*> inputs;
     vector<void*> outputs;
 
@@ -104,7 +109,25 @@ void runtime::cpu::CPU_CallFrame::inner_call(
     }
     else
     {
-        m_external_function->get_executor()(m_ctx_vec[id], inputs, outputs);
+        try
+        {
+            m_external_function->get_executor()(m_ctx_vec[id], inputs, outputs);
+        }
+        catch (...)
+        {
+            // Recorded op spans point at the external function's op attributes
+            if (trace_ops || runtime::event::Manager::is_tracing_enabled())
+            {
+                FlushOpTraceEvents();
+            }
+            throw;
+        }
+    }
+    call_event.stop();
+
+    if (trace_ops || runtime::event::Manager::is_tracing_enabled())
+    {
+        FlushOpTraceEvents();
     }
 
     if (runtime::cpu::IsTracingEnabled())
@@ -148,9 +171,18 @@ void runtime::cpu::CPU_CallFrame::call(
         m_num_ctx_available--;
     }
 
-    m_ctx_vec[id]->pc = 0;
-    propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
-    inner_call(output_tvs, input_tvs, id, disable_caching);
+    {
+        std::lock_guard<std::mutex> ctx_lock(*m_ctx_mutexes[id]);
+        if (m_ctx_used_by_stream[id])
+        {
+            // Staleness hints describe the per-stream call's inputs, not ours
+            disable_caching = true;
+            m_ctx_used_by_stream[id] = false;
+        }
+        m_ctx_vec[id]->pc = 0;
+        propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
+        inner_call(output_tvs, input_tvs, id, disable_caching);
+    }
 
     m_mutex.lock();
     m_id_pool[id] = true;
@@ -159,6 +191,28 @@ void runtime::cpu::CPU_CallFrame::call(
     m_cv.notify_one();
 }
 
+void runtime::cpu::CPU_CallFrame::call(
+    const std::vector<std::shared_ptr<runtime::Tensor>>& output_tvs,
+    const std::vector<std::shared_ptr<runtime::Tensor>>& input_tvs,
+    size_t stream)
+{
+    if (stream >= m_num_ctx)
+    {
+        throw ngraph_error("Stream " + std::to_string(stream) + " out of range, " +
+                           std::to_string(m_num_ctx) +
+                           " streams are configured through NGRAPH_CPU_CONCURRENCY");
+    }
+
+    std::lock_guard<std::mutex> ctx_lock(*m_ctx_mutexes[stream]);
+    // Caching hints are only valid across calls made through the same path, so the first
+    // per-stream call after a pooled call recomputes everything
+    bool disable_caching = !m_ctx_used_by_stream[stream];
+    m_ctx_used_by_stream[stream] = true;
+    m_ctx_vec[stream]->pc = 0;
+    propagate_layouts(output_tvs, m_external_function->get_result_layout_descriptors());
+    inner_call(output_tvs, input_tvs, stream, disable_caching);
+}
+
 void runtime::cpu::CPU_CallFrame::propagate_layouts(
     const std::vector<std::shared_ptr<runtime::Tensor>>& tvs,
     const LayoutDescriptorPtrs& layouts) const
@@ -181,13 +235,32 @@ void runtime::cpu::CPU_CallFrame::propagate_layouts(
 
 void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
 {
+    auto& cpu_executor = executor::GetCPUExecutor();
+    // Pools of the NUMA node the executable is bound to, whose threads also first touch the
+    // intermediate buffers so that they are allocated on that node
+    std::vector<int> numa_pools;
+    if (m_external_function->m_numa_node >= 0)
+    {
+        numa_pools = cpu_executor.get_numa_pools(m_external_function->m_numa_node);
+    }
     for (size_t i = 0; i < m_num_ctx; i++)
     {
         m_id_pool[i] = true;
         auto ctx = new CPURuntimeContext;
         m_ctx_vec.push_back(ctx);
+        m_ctx_mutexes.emplace_back(new std::mutex);
+        m_ctx_used_by_stream.push_back(false);
 
         ctx->pc = 0;
+        // Spread the streams over the thread pools configured by NGRAPH_INTER_OP_PARALLELISM
+        if (numa_pools.empty())
+        {
+            ctx->arena = static_cast<int>(i) % cpu_executor.get_num_thread_pools();
+        }
+        else
+        {
+            ctx->arena = numa_pools[i % numa_pools.size()];
+        }
         ctx->op_durations = nullptr;
         if (runtime::cpu::IsTracingEnabled())
         {
@@ -204,6 +277,7 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
         for (auto buffer_size : m_external_function->get_memory_buffer_sizes())
         {
             auto buffer = new AlignedBuffer(buffer_size, alignment, allocator);
+            cpu_executor.first_touch(ctx->arena, buffer->get_ptr(), buffer_size);
             ctx->memory_buffers.push_back(buffer);
         }
         const auto& mkldnn_emitter = m_external_function->get_mkldnn_emitter();
@@ -220,6 +294,8 @@ void runtime::cpu::CPU_CallFrame::setup_runtime_context(Allocator* allocator)
             if (scratchpad_size > 0)
             {
                 ctx->scratchpad_buffer = new AlignedBuffer(scratchpad_size, alignment, allocator);
+                cpu_executor.first_touch(
+                    ctx->arena, ctx->scratchpad_buffer->get_ptr(), scratchpad_size);
             }
             else
             {
@@ -304,5 +380,7 @@ void runtime::cpu::CPU_CallFrame::cleanup_runtime_context()
 #endif
         delete ctx;
     }
+    m_ctx_mutexes.clear();
+    m_ctx_used_by_stream.clear();
     m_num_ctx_available = 0;
 }
@@ -70,6 +70,18 @@ namespace ngraph
                 void call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                           const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
 
+                /// \brief Invoke the function on a specific stream.
+                ///
+                /// Each of the NGRAPH_CPU_CONCURRENCY streams owns a runtime context with its
+                /// own memory buffers, bound to one of the CPUExecutor thread pools. Calls on
+                /// different streams run concurrently without going through the shared
+                /// context pool.
+                void call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                          const std::vector<std::shared_ptr<runtime::Tensor>>& inputs,
+                          size_t stream);
+
+                size_t get_num_streams() const { return m_num_ctx; }
+
                 void propagate_layouts(const std::vector<std::shared_ptr<runtime::Tensor>>& tvs,
                                        const LayoutDescriptorPtrs& layouts) const;
 
@@ -96,6 +108,10 @@ namespace ngraph
                 size_t m_num_ctx = 1;
                 std::unordered_map<size_t, bool> m_id_pool;
                 std::vector<CPURuntimeContext*> m_ctx_vec;
+                // Serializes use of each context between pooled and per-stream calls
+                std::vector<std::unique_ptr<std::mutex>> m_ctx_mutexes;
+                // Set when a per-stream call last used the context, guarded by m_ctx_mutexes
+                std::vector<bool> m_ctx_used_by_stream;
 
                 // Codegen specific
 
@@ -0,0 +1,428 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "ngraph/check.hpp"
+#include "ngraph/env_util.hpp"
+#include "ngraph/runtime/cpu/cpu_dex_scheduler.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    // Accesses of earlier ops to one memory space, keyed by the first byte touched. An access
+    // fully covered by a later write is dropped: anything overlapping it also overlaps the
+    // write, which is already ordered after it.
+    class AccessMap
+    {
+    public:
+        template <typename F>
+        void for_each_overlap(size_t begin, size_t end, F f) const
+        {
+            auto it = m_accesses.lower_bound(begin > m_max_length ? begin - m_max_length : 0);
+            for (; it != m_accesses.end() && it->first < end; ++it)
+            {
+                if (it->second.end > begin)
+                {
+                    f(it->second);
+                }
+            }
+        }
+
+        void add(size_t begin, size_t end, size_t op, bool write)
+        {
+            if (write)
+            {
+                auto it = m_accesses.lower_bound(begin);
+                while (it != m_accesses.end() && it->first < end)
+                {
+                    it = (it->second.end <= end ? m_accesses.erase(it) : next(it));
+                }
+            }
+            m_accesses.emplace(begin, Access{end, op, write});
+            m_max_length = max(m_max_length, end - begin);
+        }
+
+        struct Access
+        {
+            size_t end;
+            size_t op;
+            bool write;
+        };
+
+    private:
+        multimap<size_t, Access> m_accesses;
+        size_t m_max_length = 0;
+    };
+
+    // Threads that help callers of DEXScheduler::run, created on demand and shared by all
+    // schedulers in the process
+    class WorkerPool
+    {
+    public:
+        static WorkerPool& get()
+        {
+            static WorkerPool s_pool;
+            return s_pool;
+        }
+
+        ~WorkerPool()
+        {
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_all();
+            for (auto& t : m_threads)
+            {
+                t.join();
+            }
+        }
+
+        void submit(const function<void()>& job, size_t count)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            while (m_threads.size() < count)
+            {
+                m_threads.emplace_back(&WorkerPool::work, this);
+            }
+            m_jobs.insert(m_jobs.end(), count, job);
+            m_cv.notify_all();
+        }
+
+    private:
+        WorkerPool() = default;
+
+        void work()
+        {
+            // Ops already run in parallel here, so the reference kernels must not add threads
+            runtime::reference::fast::set_serial_on_this_thread(true);
+            unique_lock<mutex> lock(m_mutex);
+            while (true)
+            {
+                m_cv.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+                if (m_jobs.empty())
+                {
+                    return;
+                }
+                function<void()> job = move(m_jobs.front());
+                m_jobs.pop_front();
+                lock.unlock();
+                job();
+                lock.lock();
+            }
+        }
+
+        mutex m_mutex;
+        condition_variable m_cv;
+        deque<function<void()>> m_jobs;
+        vector<thread> m_threads;
+        bool m_stop = false;
+    };
+
+    // Ready tasks of one thread. The owner pushes and pops at the back, so it keeps working on
+    // the data it just produced, while other threads steal the oldest tasks from the front.
+    struct ReadyQueue
+    {
+        mutex m_mutex;
+        deque<size_t> m_tasks;
+    };
+
+    struct RunState
+    {
+        RunState(const vector<runtime::cpu::DEXScheduler::Task>& tasks,
+                 const function<void(size_t)>& run_op,
+                 size_t num_threads)
+            : m_tasks(tasks)
+            , m_run_op(run_op)
+            , m_pending(new atomic<size_t>[tasks.size()])
+            , m_queues(num_threads)
+            , m_remaining(tasks.size())
+        {
+            for (size_t i = 0; i < tasks.size(); i++)
+            {
+                m_pending[i] = tasks[i].predecessors;
+            }
+        }
+
+        bool finished() const { return m_remaining == 0 || m_failed; }
+        void push(size_t slot, size_t task)
+        {
+            {
+                lock_guard<mutex> lock(m_queues[slot].m_mutex);
+                m_queues[slot].m_tasks.push_back(task);
+            }
+            m_queued++;
+            if (m_sleepers > 0)
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_cv.notify_one();
+            }
+        }
+
+        bool pop(size_t slot, size_t& task)
+        {
+            for (size_t i = 0; i < m_queues.size(); i++)
+            {
+                auto& queue = m_queues[(slot + i) % m_queues.size()];
+                lock_guard<mutex> lock(queue.m_mutex);
+                if (!queue.m_tasks.empty())
+                {
+                    if (i == 0)
+                    {
+                        task = queue.m_tasks.back();
+                        queue.m_tasks.pop_back();
+                    }
+                    else
+                    {
+                        task = queue.m_tasks.front();
+                        queue.m_tasks.pop_front();
+                    }
+                    m_queued--;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Runs task and then, on the same thread, the first successor it made ready
+        void execute(size_t slot, size_t task)
+        {
+            while (true)
+            {
+                try
+                {
+                    for (size_t op : m_tasks[task].ops)
+                    {
+                        m_run_op(op);
+                    }
+                }
+                catch (...)
+                {
+                    lock_guard<mutex> lock(m_mutex);
+                    if (!m_error)
+                    {
+                        m_error = current_exception();
+                    }
+                    m_failed = true;
+                    m_cv.notify_all();
+                    return;
+                }
+
+                const size_t none = m_tasks.size();
+                size_t next = none;
+                for (size_t successor : m_tasks[task].successors)
+                {
+                    if (m_pending[successor].fetch_sub(1) == 1)
+                    {
+                        if (next == none)
+                        {
+                            next = successor;
+                        }
+                        else
+                        {
+                            push(slot, successor);
+                        }
+                    }
+                }
+                if (m_remaining.fetch_sub(1) == 1)
+                {
+                    lock_guard<mutex> lock(m_mutex);
+                    m_cv.notify_all();
+                }
+                if (next == none)
+                {
+                    return;
+                }
+                task = next;
+            }
+        }
+
+        void work(size_t slot)
+        {
+            size_t task;
+            while (!finished())
+            {
+                if (pop(slot, task))
+                {
+                    execute(slot, task);
+                    continue;
+                }
+                unique_lock<mutex> lock(m_mutex);
+                m_sleepers++;
+                m_cv.wait(lock, [this]() { return m_queued > 0 || finished(); });
+                m_sleepers--;
+            }
+        }
+
+        // Entry point of a pool thread; only touches the references once it has joined
+        void help()
+        {
+            {
+                lock_guard<mutex> lock(m_mutex);
+                if (m_done)
+                {
+                    return;
+                }
+                m_joined++;
+            }
+            work(m_next_slot++);
+            lock_guard<mutex> lock(m_mutex);
+            m_joined--;
+            m_cv.notify_all();
+        }
+
+        const vector<runtime::cpu::DEXScheduler::Task>& m_tasks;
+        const function<void(size_t)>& m_run_op;
+        unique_ptr<atomic<size_t>[]> m_pending;
+        vector<ReadyQueue> m_queues;
+        atomic<size_t> m_remaining;
+        atomic<size_t> m_queued{0};
+        atomic<size_t> m_sleepers{0};
+        atomic<size_t> m_next_slot{1};
+        atomic<bool> m_failed{false};
+
+        // Guarded by m_mutex
+        mutex m_mutex;
+        condition_variable m_cv;
+        exception_ptr m_error;
+        size_t m_joined = 0;
+        bool m_done = false;
+    };
+}
+
+constexpr size_t runtime::cpu::DEXScheduler::s_default_min_task_bytes;
+
+runtime::cpu::DEXScheduler::DEXScheduler(const vector<OpInfo>& ops, size_t min_task_bytes)
+{
+    map<size_t, AccessMap> spaces;
+    bool have_ordered = false;
+    size_t last_ordered = 0;
+    for (size_t op = 0; op < ops.size(); op++)
+    {
+        const OpInfo& info = ops[op];
+        vector<size_t> deps = info.dependencies;
+        for (const Region& r : info.reads)
+        {
+            spaces[r.space].for_each_overlap(r.begin, r.end, [&](const AccessMap::Access& a) {
+                if (a.write)
+                {
+                    deps.push_back(a.op);
+                }
+            });
+        }
+        for (const Region& r : info.writes)
+        {
+            spaces[r.space].for_each_overlap(
+                r.begin, r.end, [&](const AccessMap::Access& a) { deps.push_back(a.op); });
+        }
+        if (info.ordered)
+        {
+            if (have_ordered)
+            {
+                deps.push_back(last_ordered);
+            }
+            have_ordered = true;
+            last_ordered = op;
+        }
+        for (const Region& r : info.reads)
+        {
+            spaces[r.space].add(r.begin, r.end, op, false);
+        }
+        for (const Region& r : info.writes)
+        {
+            spaces[r.space].add(r.begin, r.end, op, true);
+        }
+
+        vector<size_t> preds;
+        for (size_t dep : deps)
+        {
+            NGRAPH_CHECK(dep < op, "DEX scheduler dependency on a later op");
+            preds.push_back(m_op_tasks[dep]);
+        }
+        sort(preds.begin(), preds.end());
+        preds.erase(unique(preds.begin(), preds.end()), preds.end());
+
+        if (preds.size() == 1 && info.bytes < min_task_bytes && !info.ordered)
+        {
+            // Every input of the op is ready once its only predecessor task is done, so it
+            // can run at the end of that task without adding a cycle
+            m_tasks[preds[0]].ops.push_back(op);
+            m_op_tasks.push_back(preds[0]);
+            continue;
+        }
+
+        size_t task = m_tasks.size();
+        m_tasks.push_back(Task{{op}, {}, preds.size()});
+        m_op_tasks.push_back(task);
+        for (size_t pred : preds)
+        {
+            m_tasks[pred].successors.push_back(task);
+        }
+        if (preds.empty())
+        {
+            m_roots.push_back(task);
+        }
+    }
+}
+
+void runtime::cpu::DEXScheduler::run(const function<void(size_t)>& run_op,
+                                     size_t num_threads) const
+{
+    if (m_tasks.empty())
+    {
+        return;
+    }
+    num_threads = max<size_t>(1, min(num_threads, m_tasks.size()));
+    auto state = make_shared<RunState>(m_tasks, run_op, num_threads);
+    // The caller pops from the back, so queue the roots in reverse to start in program order
+    for (auto it = m_roots.rbegin(); it != m_roots.rend(); ++it)
+    {
+        state->push(0, *it);
+    }
+    if (num_threads > 1)
+    {
+        WorkerPool::get().submit([state]() { state->help(); }, num_threads - 1);
+    }
+    bool was_serial = runtime::reference::fast::set_serial_on_this_thread(num_threads > 1);
+    state->work(0);
+    runtime::reference::fast::set_serial_on_this_thread(was_serial);
+
+    unique_lock<mutex> lock(state->m_mutex);
+    state->m_done = true;
+    state->m_cv.wait(lock, [&state]() { return state->m_joined == 0; });
+    if (state->m_error)
+    {
+        rethrow_exception(state->m_error);
+    }
+}
+
+size_t runtime::cpu::DEXScheduler::get_default_num_threads()
+{
+    int32_t threads = getenv_int("NGRAPH_CPU_DEX_SCHEDULER_THREADS", 0);
+    return threads > 1 ? static_cast<size_t>(threads) : 0;
+}
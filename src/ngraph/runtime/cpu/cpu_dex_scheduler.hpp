@@ -0,0 +1,101 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Runs the DEX functor list of a function on several threads.
+            ///
+            /// Ops are ordered by the memory they touch rather than by graph edges, because
+            /// the memory assignment passes reuse and alias buffers: an op waits for every
+            /// earlier op that writes memory it reads (RAW) and every earlier op that reads or
+            /// writes memory it writes (WAR, WAW). Any schedule that honours those edges
+            /// computes the same results as the sequential functor loop.
+            ///
+            /// Ops whose outputs are smaller than the task threshold are fused into the task
+            /// of their only predecessor to amortize scheduling. At run time every thread owns
+            /// a deque of ready tasks; a thread continues with the first successor its task
+            /// made ready, keeping producer and consumer on the same core, and queues the rest
+            /// for idle threads to steal.
+            class CPU_BACKEND_API DEXScheduler
+            {
+            public:
+                /// \brief Bytes [begin, end) of one memory space, e.g. the intermediate pool
+                /// or one function argument
+                struct Region
+                {
+                    size_t space;
+                    size_t begin;
+                    size_t end;
+                };
+
+                struct OpInfo
+                {
+                    std::vector<Region> reads;
+                    std::vector<Region> writes;
+                    /// Ops that must complete first regardless of the memory they touch
+                    std::vector<size_t> dependencies;
+                    /// Bytes written by the op, compared against the task threshold
+                    size_t bytes;
+                    /// Ordered ops, e.g. collectives, run in their sequential order
+                    bool ordered;
+                };
+
+                /// \brief Ops, fused or not, that a single thread runs back to back
+                struct Task
+                {
+                    std::vector<size_t> ops;
+                    std::vector<size_t> successors;
+                    size_t predecessors;
+                };
+
+                static constexpr size_t s_default_min_task_bytes = 16 * 1024;
+
+                DEXScheduler(const std::vector<OpInfo>& ops,
+                             size_t min_task_bytes = s_default_min_task_bytes);
+
+                /// \brief Calls run_op for every op, on up to num_threads threads including
+                /// the caller. The first exception thrown by run_op is rethrown once all
+                /// threads have left the run.
+                void run(const std::function<void(size_t)>& run_op, size_t num_threads) const;
+
+                /// \brief Threads requested by NGRAPH_CPU_DEX_SCHEDULER_THREADS; 0 when the
+                /// scheduler is disabled
+                static size_t get_default_num_threads();
+
+                const std::vector<Task>& get_tasks() const { return m_tasks; }
+                /// \brief Index into get_tasks() of the task that runs op
+                size_t get_task(size_t op) const { return m_op_tasks.at(op); }
+
+            private:
+                std::vector<Task> m_tasks;
+                std::vector<size_t> m_op_tasks;
+                std::vector<size_t> m_roots;
+            };
+        }
+    }
+}
@@ -14,11 +14,20 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <thread>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include "cpu_executor.hpp"
 
 #include "ngraph/except.hpp"
+#include "ngraph/log.hpp"
 
 #define MAX_PARALLELISM_THRESHOLD 2
 
@@ -54,6 +63,72 @@ static int GetNumCores()
     return count < 1 ? 1 : count;
 }
 
+static bool IsNumaAware()
+{
+    return std::getenv("NGRAPH_CPU_NUMA_AWARE") != nullptr;
+}
+
+// Parses a sysfs cpu list such as "0-3,8-11"
+static std::vector<int> ParseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ','))
+    {
+        if (range.empty())
+        {
+            continue;
+        }
+        auto dash = range.find('-');
+        int first = std::atoi(range.substr(0, dash).c_str());
+        int last = (dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str()));
+        for (int cpu = first; cpu <= last; cpu++)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// Cores of each NUMA node. Machines without NUMA information are a single node.
+static const std::vector<std::vector<int>>& GetNumaNodeCores()
+{
+    static std::vector<std::vector<int>> s_nodes = []() {
+        std::vector<std::vector<int>> nodes;
+#if defined(__linux__)
+        for (int node = 0;; node++)
+        {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) +
+                             "/cpulist");
+            if (!in)
+            {
+                break;
+            }
+            std::string list;
+            std::getline(in, list);
+            auto cores = ParseCpuList(list);
+            // Memory-only nodes have no cores to run a pool on
+            if (!cores.empty())
+            {
+                nodes.push_back(cores);
+            }
+        }
+#endif
+        if (nodes.empty())
+        {
+            std::vector<int> cores;
+            for (unsigned core = 0; core < std::thread::hardware_concurrency(); core++)
+            {
+                cores.push_back(static_cast<int>(core));
+            }
+            nodes.push_back(cores);
+        }
+        return nodes;
+    }();
+    return s_nodes;
+}
+
 static int GetNumThreadPools()
 {
     const auto ngraph_inter_op_parallelism = std::getenv("NGRAPH_INTER_OP_PARALLELISM");
@@ -63,10 +138,48 @@ static int GetNumThreadPools()
     {
         count = std::atoi(ngraph_inter_op_parallelism);
     }
+    else if (IsNumaAware())
+    {
+        // One pool per NUMA node
+        count = static_cast<int>(GetNumaNodeCores().size());
+    }
 
     return count < 1 ? 1 : count;
 }
 
+// Eigen thread environment whose threads are restricted to a fixed set of cores
+class PinnedThreadEnvironment : public Eigen::StlThreadEnvironment
+{
+public:
+    PinnedThreadEnvironment(const std::vector<int>& cores)
+        : m_cores(cores)
+    {
+    }
+
+    EnvThread* CreateThread(std::function<void()> f)
+    {
+        std::vector<int> cores = m_cores;
+        return Eigen::StlThreadEnvironment::CreateThread([cores, f]() {
+#if defined(__linux__)
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            for (int core : cores)
+            {
+                CPU_SET(core, &cpu_set);
+            }
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) != 0)
+            {
+                NGRAPH_WARN << "CPU Backend: Unable to pin thread pool thread";
+            }
+#endif
+            f();
+        });
+    }
+
+private:
+    std::vector<int> m_cores;
+};
+
 namespace ngraph
 {
     namespace runtime
@@ -77,8 +190,10 @@ namespace ngraph
             {
                 CPUExecutor::CPUExecutor(int num_thread_pools)
                     : m_num_thread_pools(num_thread_pools)
+                    , m_numa_aware(IsNumaAware())
                 {
                     m_num_cores = GetNumCores();
+                    const auto& numa_nodes = GetNumaNodeCores();
                     for (int i = 0; i < num_thread_pools; i++)
                     {
                         int num_threads_per_pool;
@@ -104,8 +219,61 @@ namespace ngraph
                             num_threads_per_pool = tp_count;
                         }
 
-                        m_thread_pools.push_back(std::unique_ptr<Eigen::ThreadPool>(
-                            new Eigen::ThreadPool(num_threads_per_pool)));
+                        bool pin = std::getenv("NGRAPH_CPU_PIN_THREAD_POOLS") != nullptr;
+                        // Cores the pool's threads may run on, empty if unrestricted
+                        std::vector<int> cores;
+                        int numa_node = -1;
+                        if (m_numa_aware)
+                        {
+                            // Pools are dealt out to the nodes in turn and never span nodes,
+                            // so their threads only touch node-local memory
+                            numa_node = i % static_cast<int>(numa_nodes.size());
+                            const auto& node_cores = numa_nodes[numa_node];
+                            int node_size = static_cast<int>(node_cores.size());
+                            if (eigen_tp_count == nullptr)
+                            {
+                                num_threads_per_pool = std::min(num_threads_per_pool, node_size);
+                            }
+                            if (pin)
+                            {
+                                int k = i / static_cast<int>(numa_nodes.size());
+                                for (int j = 0; j < num_threads_per_pool; j++)
+                                {
+                                    cores.push_back(
+                                        node_cores[(k * num_threads_per_pool + j) % node_size]);
+                                }
+                            }
+                            else
+                            {
+                                cores = node_cores;
+                            }
+                        }
+                        else if (pin)
+                        {
+                            // Give each pool its own block of cores so that concurrent
+                            // streams on different pools do not compete for them
+                            int num_hw_threads = std::thread::hardware_concurrency();
+                            for (int j = 0; j < num_threads_per_pool; j++)
+                            {
+                                cores.push_back((i * num_threads_per_pool + j) % num_hw_threads);
+                            }
+                        }
+                        m_pool_numa_nodes.push_back(numa_node);
+                        m_pool_cores.push_back(cores);
+                        m_pool_threads.push_back(num_threads_per_pool);
+
+                        if (!cores.empty())
+                        {
+                            m_thread_pools.push_back(
+                                std::unique_ptr<Eigen::ThreadPoolInterface>(
+                                    new Eigen::ThreadPoolTempl<PinnedThreadEnvironment>(
+                                        num_threads_per_pool, PinnedThreadEnvironment(cores))));
+                        }
+                        else
+                        {
+                            m_thread_pools.push_back(std::unique_ptr<Eigen::ThreadPoolInterface>(
+                                new Eigen::ThreadPool(num_threads_per_pool)));
+                        }
                         m_thread_pool_devices.push_back(
                             std::unique_ptr<Eigen::ThreadPoolDevice>(new Eigen::ThreadPoolDevice(
                                 m_thread_pools[i].get(), num_threads_per_pool)));
@@ -113,6 +281,86 @@ namespace ngraph
                         m_tbb_arenas.emplace_back(1);
 #endif
                     }
+
+                    if (m_numa_aware)
+                    {
+                        NGRAPH_INFO << get_topology_report();
+                    }
+                }
+
+                std::vector<int> CPUExecutor::get_numa_pools(int numa_node) const
+                {
+                    std::vector<int> pools;
+                    for (int i = 0; i < m_num_thread_pools; i++)
+                    {
+                        if (m_pool_numa_nodes[i] == numa_node)
+                        {
+                            pools.push_back(i);
+                        }
+                    }
+                    return pools;
+                }
+
+                void CPUExecutor::first_touch(int pool, void* buffer, size_t size)
+                {
+                    if (m_pool_numa_nodes[pool] < 0 || buffer == nullptr || size == 0)
+                    {
+                        return;
+                    }
+                    // Linux places a page on the node of the thread that first writes it, so
+                    // the pool's own threads each zero one slice of the buffer
+                    const size_t page_size = 4096;
+                    size_t num_pages = (size + page_size - 1) / page_size;
+                    size_t num_slices =
+                        std::min(num_pages, static_cast<size_t>(m_pool_threads[pool]));
+                    char* bytes = static_cast<char*>(buffer);
+                    Eigen::Barrier barrier(static_cast<unsigned int>(num_slices));
+                    for (size_t slice = 0; slice < num_slices; slice++)
+                    {
+                        m_thread_pools[pool]->Schedule([=, &barrier]() {
+                            size_t begin = num_pages * slice / num_slices * page_size;
+                            size_t end =
+                                std::min(size, num_pages * (slice + 1) / num_slices * page_size);
+                            for (size_t offset = begin; offset < end; offset += page_size)
+                            {
+                                bytes[offset] = 0;
+                            }
+                            barrier.Notify();
+                        });
+                    }
+                    barrier.Wait();
+                }
+
+                std::string CPUExecutor::get_topology_report() const
+                {
+                    auto join_cores = [](const std::vector<int>& cores) {
+                        std::stringstream ss;
+                        for (size_t i = 0; i < cores.size(); i++)
+                        {
+                            ss << (i == 0 ? "" : ",") << cores[i];
+                        }
+                        return ss.str();
+                    };
+                    const auto& numa_nodes = GetNumaNodeCores();
+                    std::stringstream ss;
+                    ss << "CPU Backend topology: " << numa_nodes.size() << " NUMA node(s), "
+                       << m_num_thread_pools << " thread pool(s)"
+                       << (m_numa_aware ? ", NUMA aware" : "");
+                    for (size_t node = 0; node < numa_nodes.size(); node++)
+                    {
+                        ss << "\n  node " << node << ": cores " << join_cores(numa_nodes[node]);
+                    }
+                    for (int i = 0; i < m_num_thread_pools; i++)
+                    {
+                        ss << "\n  pool " << i << ": " << m_pool_threads[i] << " thread(s)";
+                        if (m_pool_numa_nodes[i] >= 0)
+                        {
+                            ss << ", node " << m_pool_numa_nodes[i];
+                        }
+                        ss << ", cores "
+                           << (m_pool_cores[i].empty() ? "any" : join_cores(m_pool_cores[i]));
+                    }
+                    return ss.str();
                 }
 
 #if defined(NGRAPH_TBB_ENABLE)
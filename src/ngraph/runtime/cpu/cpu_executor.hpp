@@ -17,7 +17,9 @@
 #pragma once
 
 #include <functional>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <mkldnn.hpp>
 
@@ -63,14 +65,32 @@ namespace ngraph
 #endif
                     int get_num_thread_pools() { return m_num_thread_pools; }
                     int get_num_cores() { return m_num_cores; }
+                    /// \brief True when NGRAPH_CPU_NUMA_AWARE binds each pool to a NUMA node
+                    bool is_numa_aware() const { return m_numa_aware; }
+                    /// \brief NUMA node the pool's threads run on, -1 if not bound
+                    int get_numa_node(int pool) const { return m_pool_numa_nodes[pool]; }
+                    /// \brief Pools bound to numa_node
+                    std::vector<int> get_numa_pools(int numa_node) const;
+                    /// \brief Writes every page of buffer from the pool's threads, so that the
+                    /// kernel allocates the pages on the pool's NUMA node. Does nothing for pools
+                    /// that are not bound to a node.
+                    void first_touch(int pool, void* buffer, size_t size);
+                    /// \brief NUMA nodes with their cores, and the node, threads and cores of
+                    /// each pool
+                    std::string get_topology_report() const;
+
                 private:
-                    std::vector<std::unique_ptr<Eigen::ThreadPool>> m_thread_pools;
+                    std::vector<std::unique_ptr<Eigen::ThreadPoolInterface>> m_thread_pools;
                     std::vector<std::unique_ptr<Eigen::ThreadPoolDevice>> m_thread_pool_devices;
 #if defined(NGRAPH_TBB_ENABLE)
                     std::vector<tbb::task_arena> m_tbb_arenas;
 #endif
                     int m_num_thread_pools;
                     int m_num_cores;
+                    bool m_numa_aware;
+                    std::vector<int> m_pool_numa_nodes;
+                    std::vector<std::vector<int>> m_pool_cores;
+                    std::vector<int> m_pool_threads;
                 };
 
                 extern CPUExecutor& GetCPUExecutor();
@@ -39,8 +39,10 @@
 #include "contrib/mlir/core/pass/mlir_subgraph_extraction.hpp"
 #endif
 
+#include "ngraph/chrome_trace.hpp"
 #include "ngraph/descriptor/input.hpp"
 #include "ngraph/descriptor/output.hpp"
+#include "ngraph/env_util.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/function.hpp"
 #include "ngraph/graph_util.hpp"
@@ -120,6 +122,7 @@
 #include "ngraph/op/quantize.hpp"
 #include "ngraph/op/quantized_convolution.hpp"
 #include "ngraph/op/quantized_dot.hpp"
+#include "ngraph/op/recv.hpp"
 #include "ngraph/op/relu.hpp"
 #include "ngraph/op/replace_slice.hpp"
 #include "ngraph/op/reshape.hpp"
@@ -129,6 +132,7 @@
 #include "ngraph/op/scatter_add.hpp"
 #include "ngraph/op/scatter_nd_add.hpp"
 #include "ngraph/op/select.hpp"
+#include "ngraph/op/send.hpp"
 #include "ngraph/op/sigmoid.hpp"
 #include "ngraph/op/sign.hpp"
 #include "ngraph/op/sin.hpp"
@@ -155,11 +159,13 @@
 #include "ngraph/pass/like_replacement.hpp"
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/memory_aware_scheduling.hpp"
 #include "ngraph/pass/memory_layout.hpp"
 #include "ngraph/pass/nop_elimination.hpp"
 #include "ngraph/pass/opset0_downgrade.hpp"
 #include "ngraph/pass/propagate_cacheability.hpp"
 #include "ngraph/pass/reshape_elimination.hpp"
+#include "ngraph/pass/rematerialization.hpp"
 #include "ngraph/pass/reshape_sinking.hpp"
 #include "ngraph/pass/zero_dim_tensor_elimination.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
@@ -168,6 +174,7 @@
 #include "ngraph/runtime/cpu/cpu_builder_registry.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_cse.hpp"
+#include "ngraph/runtime/cpu/cpu_dex_scheduler.hpp"
 #include "ngraph/runtime/cpu/cpu_emitter.hpp"
 #include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_external_function.hpp"
@@ -243,6 +250,7 @@ runtime::cpu::CPU_ExternalFunction::CPU_ExternalFunction(
     : m_function(function)
     , m_release_function(release_function)
     , m_emit_timing(false)
+    , m_emit_hw_counters(false)
 #if defined(NGRAPH_TBB_ENABLE)
     , m_use_tbb(std::getenv("NGRAPH_CPU_USE_TBB") != nullptr)
 #endif
@@ -541,6 +549,7 @@ void runtime::cpu::CPU_ExternalFunction::compile(ngraph::pass::PassConfig& pass_
 #include "ngraph/runtime/cpu/cpu_executor.hpp"
 #include "ngraph/runtime/cpu/cpu_kernels.hpp"
 #include "ngraph/runtime/cpu/cpu_runtime_context.hpp"
+#include "ngraph/runtime/cpu/kernel/dropout.hpp"
 #include "ngraph/runtime/cpu/mkldnn_invoke.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/reference/all.hpp"
@@ -584,6 +593,7 @@ void runtime::cpu::CPU_ExternalFunction::compile(ngraph::pass::PassConfig& pass_
 #include "ngraph/runtime/reference/xor.hpp"
 #include "ngraph/shape.hpp"
 #include "ngraph/state/bernoulli_rng_state.hpp"
+#include "ngraph/state/uniform_rng_state.hpp"
 #include "ngraph/strides.hpp"
 #include "ngraph/util.hpp"
 
@@ -1105,6 +1115,7 @@ using namespace ngraph::runtime;
 
     m_compiler->set_precompiled_header_source(pch_header_source);
 
+    runtime::event::Duration codegen_event("codegen", "CPU");
     auto codegen_module = m_compiler->compile(code);
 
     if (codegen_module == nullptr)
@@ -1113,6 +1124,7 @@ using namespace ngraph::runtime;
     }
     m_execution_engine->add_module(codegen_module);
     m_execution_engine->finalize();
+    codegen_event.stop();
 
     m_compiled_init_ctx_func = m_execution_engine->find_function<InitContextFuncTy>("init_cg_ctx");
 
@@ -1313,6 +1325,7 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     REGISTER_KNOBBED_PASS_WITH_ARGS(CPUWorkspaceInsertion, true, runtime::cpu::pass, nv_cwi, false)
     REGISTER_KNOBBED_PASS_WITH_ARGS(CPUAssignment, true, runtime::cpu::pass, this)
     REGISTER_KNOBBED_PASS_WITH_ARGS(ConstantFolding, true, ngraph::pass, GetGlobalCFDispatcherCPU())
+    REGISTER_KNOBBED_PASS_WITH_ARGS(StructuralCSE, true, ngraph::pass, m_constant_registry)
     REGISTER_KNOBBED_PASS_WITH_ARGS(CPULayout, true, runtime::cpu::pass, this)
     REGISTER_KNOBBED_PASS_WITH_ARGS(
         CommonSubexpressionElimination, true, ngraph::pass, runtime::cpu::get_cse_handlers_map())
@@ -1322,10 +1335,30 @@ void runtime::cpu::CPU_ExternalFunction::register_common_passes(
     REGISTER_KNOBBED_PASS(GetOutputElementElimination, false, ngraph::pass)
     REGISTER_KNOBBED_PASS_WITH_ARGS(
         PropagateCacheability, true, ngraph::pass, runtime::cpu::get_annotations_factory())
+    REGISTER_KNOBBED_PASS(MemoryAwareScheduling, true, ngraph::pass)
+    int32_t rematerialization_budget_mb = getenv_int("NGRAPH_REMATERIALIZATION_BUDGET_MB");
+    if (rematerialization_budget_mb >= 0)
+    {
+        pass_manager.register_pass<ngraph::pass::Rematerialization>(
+            static_cast<size_t>(rematerialization_budget_mb) << 20);
+    }
     bool reuse_memory = pass_config.get_pass_attribute("CPUMemoryAssignment::ReuseMemory") ||
                         pass_config.get_pass_attribute("ReuseMemory");
+    auto memory_scheme = ngraph::pass::MemoryManager::allocation_scheme::FIRST_FIT;
+    if (pass_config.get_pass_attribute("CPUMemoryAssignment::OptimalPlan"))
+    {
+        memory_scheme = ngraph::pass::MemoryManager::allocation_scheme::OPTIMAL;
+    }
+    else if (pass_config.get_pass_attribute("CPUMemoryAssignment::GreedyBySize"))
+    {
+        memory_scheme = ngraph::pass::MemoryManager::allocation_scheme::GREEDY_BY_SIZE;
+    }
     pass_manager.register_pass<runtime::cpu::pass::CPUMemoryAssignment>(
-        bufferID_to_tensorSets, tensor_to_bufferID, size_t(s_memory_pool_alignment), !reuse_memory);
+        bufferID_to_tensorSets,
+        tensor_to_bufferID,
+        size_t(s_memory_pool_alignment),
+        !reuse_memory,
+        memory_scheme);
 
     pass_manager.get_state().set_visualize_tree_ops_map(runtime::cpu::get_visualize_tree_ops_map());
 }
@@ -1508,6 +1541,14 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
 
     // Build executor
     size_t buffer_index = 0;
+    // Memory touched by each tensor, for the DEX scheduler's dependency analysis. Space 0 is
+    // the intermediate pool, followed by one space per function input and output.
+    unordered_map<string, DEXScheduler::Region> tensor_regions;
+    auto add_tensor_region = [&tensor_regions](descriptor::Tensor* tensor, size_t space) {
+        size_t offset = tensor->get_pool_offset();
+        tensor_regions[tensor->get_name()] =
+            DEXScheduler::Region{space, offset, offset + max<size_t>(tensor->size(), 1)};
+    };
     // Temporaries
     if (m_function->get_temporary_pool_size())
     {
@@ -1522,6 +1563,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                     intermediates_offsets.emplace_back(m_buffer_indices[ele_t->get_name()],
                                                        ele_t->get_pool_offset());
                     m_tensor_roles[ele_t->get_name()] = TensorRole::INTERMEDIATE;
+                    add_tensor_region(ele_t, 0);
                     buffer_index++;
                 }
             }
@@ -1572,6 +1614,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                                                          arg_index,
                                                          ele_t->get_pool_offset(),
                                                          stale);
+                add_tensor_region(ele_t, 1 + arg_index);
                 buffer_index++;
             }
         }
@@ -1592,6 +1635,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
             m_buffer_indices[ele_t->get_name()] = buffer_index;
             function_output_index_offset.emplace_back(
                 m_buffer_indices[ele_t->get_name()], i, ele_t->get_pool_offset());
+            add_tensor_region(ele_t, 1 + arg_index + i);
             buffer_index++;
         }
     }
@@ -1599,6 +1643,20 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     // After processing inputs, outputs, constants, and intermediates, set the buffer size.
     m_buffer_size = buffer_index;
 
+    m_dex_scheduler_threads = DEXScheduler::get_default_num_threads();
+#if defined(NGRAPH_TBB_ENABLE)
+    if (m_use_tbb)
+    {
+        m_dex_scheduler_threads = 0;
+    }
+#endif
+    // MKLDNN primitives share one scratchpad per call context, so they never run concurrently
+    const size_t mkldnn_scratchpad_space = 1 + arg_index + m_function->get_output_size();
+    vector<DEXScheduler::OpInfo> dex_ops;
+    unordered_map<Node*, size_t> dex_op_indices;
+
+    // Builders construct the MKLDNN primitives for the ops they handle
+    runtime::event::Duration build_event("build_functors", "CPU");
     for (shared_ptr<Node> node : m_function->get_ordered_ops())
     {
         if (node->is_parameter() || node->is_constant())
@@ -1641,6 +1699,47 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
         op_names.push_back(node->get_name());
         handler->second(this, node.get(), in, out);
 
+        if (m_dex_scheduler_threads > 0)
+        {
+            DEXScheduler::OpInfo info;
+            info.bytes = 0;
+            info.ordered = is_type<ngraph::op::AllReduce>(node) ||
+                           is_type<ngraph::op::BroadcastDistributed>(node) ||
+                           is_type<ngraph::op::Send>(node) || is_type<ngraph::op::Recv>(node) ||
+                           is_type<ngraph::op::CompiledKernel>(node);
+            for (const auto& name : in_names)
+            {
+                auto it = tensor_regions.find(name);
+                if (it != tensor_regions.end())
+                {
+                    info.reads.push_back(it->second);
+                }
+            }
+            for (const auto& name : out_names)
+            {
+                auto it = tensor_regions.find(name);
+                if (it != tensor_regions.end())
+                {
+                    info.writes.push_back(it->second);
+                    info.bytes += it->second.end - it->second.begin;
+                }
+            }
+            if (runtime::cpu::mkldnn_utils::use_mkldnn_kernel(node.get()))
+            {
+                info.writes.push_back(DEXScheduler::Region{mkldnn_scratchpad_space, 0, 1});
+            }
+            for (const auto& dep : node->get_control_dependencies())
+            {
+                auto it = dex_op_indices.find(dep.get());
+                if (it != dex_op_indices.end())
+                {
+                    info.dependencies.push_back(it->second);
+                }
+            }
+            dex_op_indices[node.get()] = dex_ops.size();
+            dex_ops.push_back(info);
+        }
+
         auto cacheable = true;
         auto reuse_memory = pass_config.get_pass_attribute("CPUMemoryAssignment::ReuseMemory") ||
                             pass_config.get_pass_attribute("ReuseMemory");
@@ -1716,6 +1815,12 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
 
         m_perf_counters.emplace_back(node, 0, 0);
     }
+    build_event.stop();
+
+    if (m_dex_scheduler_threads > 0)
+    {
+        m_dex_scheduler.reset(new DEXScheduler(dex_ops));
+    }
 
     if ((std::getenv("NGRAPH_DEX_DEBUG") != nullptr))
     {
@@ -1784,6 +1889,7 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
     executor = [&](CPURuntimeContext* ctx, vector<void*>& inputs, vector<void*>& outputs) {
         cpu::Timestamp start_ts, end_ts;
         uint64_t profiler_count = 0;
+        bool trace_ops = runtime::event::Manager::is_tracing_enabled();
 
         if (ctx->first_iteration)
         {
@@ -1832,12 +1938,26 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                             [&, functor, index](const tbb::flow::continue_msg& /* msg */) {
                                 if (p(ctx) || ctx->first_iteration)
                                 {
+                                    HardwareCounters::Sample start_counters{0, 0, 0, false};
+                                    if (m_emit_hw_counters)
+                                    {
+                                        start_counters =
+                                            HardwareCounters::get_thread_counters().read();
+                                    }
                                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                                     {
                                         start_ts = cpu::Clock::now();
                                     }
-                                    CPUExecutionContext ectx{0};
+                                    int64_t trace_begin = trace_ops ? GetOpTraceTimestamp() : 0;
+                                    CPUExecutionContext ectx{ctx->arena};
                                     executor::GetCPUExecutor().execute(*functor, ctx, &ectx, true);
+                                    if (trace_ops)
+                                    {
+                                        RecordOpTraceEvent(m_op_attrs[index],
+                                                           trace_begin,
+                                                           GetOpTraceTimestamp(),
+                                                           ctx->arena);
+                                    }
                                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                                     {
                                         end_ts = cpu::Clock::now();
@@ -1858,6 +1978,10 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                                             m_perf_counters[index].m_call_count++;
                                         }
                                     }
+                                    if (m_emit_hw_counters)
+                                    {
+                                        record_hw_counters(index, start_counters);
+                                    }
                                 }
                                 else
                                 {
@@ -1951,6 +2075,78 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                 }
             }
 
+            // The first iteration builds primitives and the debugger steps through ops one at a
+            // time, so both stay on the sequential loop below
+            if (m_dex_scheduler && !ctx->first_iteration && ctx->pc == 0 &&
+                ctx->breakpoints.empty() && !debug_tracer.tracing_is_enabled() &&
+                ddebug == nullptr)
+            {
+                m_dex_scheduler->run(
+                    [&](size_t index) {
+                        if (enables[index](ctx))
+                        {
+                            HardwareCounters::Sample start_counters{0, 0, 0, false};
+                            if (m_emit_hw_counters)
+                            {
+                                start_counters = HardwareCounters::get_thread_counters().read();
+                            }
+                            cpu::Timestamp op_start_ts;
+                            if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+                            {
+                                op_start_ts = cpu::Clock::now();
+                            }
+                            int64_t trace_begin = trace_ops ? GetOpTraceTimestamp() : 0;
+                            CPUExecutionContext ectx{ctx->arena};
+                            executor::GetCPUExecutor().execute(functors[index], ctx, &ectx);
+                            if (trace_ops)
+                            {
+                                RecordOpTraceEvent(m_op_attrs[index],
+                                                   trace_begin,
+                                                   GetOpTraceTimestamp(),
+                                                   ctx->arena);
+                            }
+                            if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
+                            {
+                                cpu::Timestamp op_end_ts = cpu::Clock::now();
+                                if (runtime::cpu::IsTracingEnabled())
+                                {
+                                    ctx->op_durations[index] =
+                                        (std::chrono::duration_cast<cpu::Timescale>(
+                                             op_end_ts - op_start_ts))
+                                            .count();
+                                }
+                                if (m_emit_timing)
+                                {
+                                    m_perf_counters[index].m_total_microseconds +=
+                                        std::chrono::duration_cast<std::chrono::microseconds>(
+                                            op_end_ts - op_start_ts)
+                                            .count();
+                                    m_perf_counters[index].m_call_count++;
+                                }
+                            }
+                            if (m_emit_hw_counters)
+                            {
+                                record_hw_counters(index, start_counters);
+                            }
+                        }
+                        else
+                        {
+                            if (runtime::cpu::IsTracingEnabled())
+                            {
+                                ctx->op_durations[index] = 0;
+                            }
+                            if (m_emit_timing)
+                            {
+                                m_perf_counters[index].m_call_count++;
+                            }
+                        }
+                    },
+                    m_dex_scheduler_threads);
+                // Every op has run, so the sequential loop is skipped
+                profiler_count = functors.size();
+                ctx->pc = functors.size();
+            }
+
             for (; ctx->pc < functors.size(); ctx->pc++)
             {
                 auto index = profiler_count++;
@@ -1959,19 +2155,30 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                     // Each Op will have exactly one functor, start the clock before the exceution
                     // of functor
                     // and collect the profiler_count once the execution complets
+                    HardwareCounters::Sample start_counters{0, 0, 0, false};
+                    if (m_emit_hw_counters)
+                    {
+                        start_counters = HardwareCounters::get_thread_counters().read();
+                    }
                     if (runtime::cpu::IsTracingEnabled() || m_emit_timing)
                     {
                         start_ts = cpu::Clock::now();
                     }
 
-                    CPUExecutionContext ectx{0};
+                    CPUExecutionContext ectx{ctx->arena};
 
                     if (debug_tracer.tracing_is_enabled())
                     {
                         this->dump_one_kernel(debug_tracer, ctx, true);
                     }
 
+                    int64_t trace_begin = trace_ops ? GetOpTraceTimestamp() : 0;
                     executor::GetCPUExecutor().execute(functors.at(ctx->pc), ctx, &ectx);
+                    if (trace_ops)
+                    {
+                        RecordOpTraceEvent(
+                            m_op_attrs[index], trace_begin, GetOpTraceTimestamp(), ctx->arena);
+                    }
 
                     if (debug_tracer.tracing_is_enabled())
                     {
@@ -2003,6 +2210,10 @@ void runtime::cpu::CPU_ExternalFunction::build(ngraph::pass::PassConfig& pass_co
                             m_perf_counters[index].m_call_count++;
                         }
                     }
+                    if (m_emit_hw_counters)
+                    {
+                        record_hw_counters(index, start_counters);
+                    }
                 }
                 else
                 {
@@ -2108,6 +2319,23 @@ const runtime::cpu::LayoutDescriptorPtrs&
     return result_layout_descriptors;
 }
 
+void runtime::cpu::CPU_ExternalFunction::record_hw_counters(
+    size_t index, const HardwareCounters::Sample& start)
+{
+    HardwareCounters::Sample end = HardwareCounters::get_thread_counters().read();
+    // A failed read would make the differences wrap around
+    if (!start.valid || !end.valid)
+    {
+        return;
+    }
+    PerformanceCounter& counter = m_perf_counters[index];
+    counter.m_cycles += end.cycles - start.cycles;
+    counter.m_instructions += end.instructions - start.instructions;
+    counter.m_llc_misses += end.llc_misses - start.llc_misses;
+    counter.m_bytes +=
+        (end.llc_misses - start.llc_misses) * HardwareCounters::get_cache_line_size();
+}
+
 const vector<runtime::PerformanceCounter>& runtime::cpu::CPU_ExternalFunction::get_perf_counters()
 {
 #if !defined(NGRAPH_DEX_ONLY)
@@ -37,10 +37,13 @@
 
 #include "ngraph/function.hpp"
 #include "ngraph/op/concat.hpp"
+#include "ngraph/pass/cse.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/pass_config.hpp"
 #include "ngraph/runtime/cpu/cpu_call_frame.hpp"
 #include "ngraph/runtime/cpu/cpu_debug_tracer.hpp"
+#include "ngraph/runtime/cpu/cpu_dex_scheduler.hpp"
+#include "ngraph/runtime/cpu/cpu_hardware_counters.hpp"
 #include "ngraph/runtime/cpu/cpu_layout_descriptor.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view_wrapper.hpp"
 #include "ngraph/runtime/cpu/mkldnn_emitter.hpp"
@@ -202,6 +205,8 @@ namespace ngraph
 
                 bool computes_result(Node* node);
                 void release_function() { m_function = nullptr; }
+                // Adds the hardware events since start to the op's performance counter
+                void record_hw_counters(size_t index, const HardwareCounters::Sample& start);
 #if !defined(NGRAPH_DEX_ONLY)
                 void emit_debug_function_entry(CodeWriter& writer,
                                                Node* node,
@@ -241,10 +246,19 @@ namespace ngraph
                 std::shared_ptr<ngraph::Function> m_function;
                 bool m_release_function;
                 bool m_emit_timing;
+                // Per-op hardware counters, only collected in DEX mode
+                bool m_emit_hw_counters;
+                // NUMA node whose thread pools run the call frame's streams, -1 for any
+                int m_numa_node = -1;
+                // Interns constant data shared with the backend's other functions, or null
+                std::shared_ptr<ngraph::pass::ConstantRegistry> m_constant_registry;
 
 #if defined(NGRAPH_TBB_ENABLE)
                 bool m_use_tbb;
 #endif
+                // Inter-op parallel DEX execution, enabled by NGRAPH_CPU_DEX_SCHEDULER_THREADS
+                std::unique_ptr<DEXScheduler> m_dex_scheduler;
+                size_t m_dex_scheduler_threads = 0;
 #if !defined(NGRAPH_DEX_ONLY)
                 bool m_is_compiled;
 #endif
@@ -0,0 +1,143 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ngraph/env_util.hpp"
+#include "ngraph/log.hpp"
+#include "ngraph/runtime/cpu/cpu_hardware_counters.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+#if defined(__linux__)
+// Counts user-space events of the calling thread on whichever CPU it runs. The group leader
+// starts disabled so the whole group is enabled atomically once every member is open.
+static int open_event(uint64_t config, int group_fd)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = (group_fd == -1 ? 1 : 0);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+
+runtime::cpu::HardwareCounters::HardwareCounters()
+{
+#if defined(__linux__)
+    m_group_fd = open_event(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (m_group_fd >= 0)
+    {
+        m_instructions_fd = open_event(PERF_COUNT_HW_INSTRUCTIONS, m_group_fd);
+        // The generic cache-miss event maps to last-level cache misses on x86
+        m_llc_misses_fd = open_event(PERF_COUNT_HW_CACHE_MISSES, m_group_fd);
+    }
+    if (m_group_fd < 0 || m_instructions_fd < 0 || m_llc_misses_fd < 0)
+    {
+        static atomic<bool> s_warned{false};
+        if (!s_warned.exchange(true))
+        {
+            NGRAPH_WARN << "CPU Backend: hardware counters are unavailable (" << strerror(errno)
+                        << "), check /proc/sys/kernel/perf_event_paranoid";
+        }
+        close_events();
+        return;
+    }
+    ioctl(m_group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+runtime::cpu::HardwareCounters::~HardwareCounters()
+{
+    close_events();
+}
+
+void runtime::cpu::HardwareCounters::close_events()
+{
+#if defined(__linux__)
+    for (int* fd : {&m_llc_misses_fd, &m_instructions_fd, &m_group_fd})
+    {
+        if (*fd >= 0)
+        {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+#endif
+}
+
+bool runtime::cpu::HardwareCounters::is_enabled()
+{
+    static bool enabled = getenv_bool("NGRAPH_CPU_HW_COUNTERS");
+    return enabled;
+}
+
+runtime::cpu::HardwareCounters& runtime::cpu::HardwareCounters::get_thread_counters()
+{
+    static thread_local HardwareCounters counters;
+    return counters;
+}
+
+size_t runtime::cpu::HardwareCounters::get_cache_line_size()
+{
+#if defined(__linux__) && defined(_SC_LEVEL1_DCACHE_LINESIZE)
+    static long line_size = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+    if (line_size > 0)
+    {
+        return static_cast<size_t>(line_size);
+    }
+#endif
+    return 64;
+}
+
+runtime::cpu::HardwareCounters::Sample runtime::cpu::HardwareCounters::read() const
+{
+    Sample sample{0, 0, 0, false};
+#if defined(__linux__)
+    if (m_group_fd >= 0)
+    {
+        // PERF_FORMAT_GROUP: the number of events followed by their values in open order
+        struct
+        {
+            uint64_t nr;
+            uint64_t values[3];
+        } group;
+        if (::read(m_group_fd, &group, sizeof(group)) == sizeof(group) && group.nr == 3)
+        {
+            sample.cycles = group.values[0];
+            sample.instructions = group.values[1];
+            sample.llc_misses = group.values[2];
+            sample.valid = true;
+        }
+    }
+#endif
+    return sample;
+}
@@ -0,0 +1,78 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ngraph/runtime/cpu/cpu_backend_visibility.h"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace cpu
+        {
+            /// \brief Cycles, instructions and last-level cache misses of one thread, read
+            /// through Linux perf_event_open.
+            ///
+            /// Reads return invalid samples where the events can't be opened, e.g. on other
+            /// platforms, inside containers without perf access or when perf_event_paranoid
+            /// forbids it.
+            ///
+            /// Only the events of the thread that opened the counters are counted. Work an op
+            /// hands to Eigen, OpenMP or MKLDNN worker threads is missing from its samples, so
+            /// the counters of large parallel ops understate their cycles and memory traffic.
+            class CPU_BACKEND_API HardwareCounters
+            {
+            public:
+                struct Sample
+                {
+                    uint64_t cycles;
+                    uint64_t instructions;
+                    uint64_t llc_misses;
+                    /// False when the counters are not open or the read failed
+                    bool valid;
+                };
+
+                ~HardwareCounters();
+                HardwareCounters(const HardwareCounters&) = delete;
+                HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+                /// \brief True when NGRAPH_CPU_HW_COUNTERS requests counters alongside the
+                /// per-op performance data
+                static bool is_enabled();
+                /// \brief Counters of the calling thread, opened on first use
+                static HardwareCounters& get_thread_counters();
+                /// \brief Size of a cache line, used to turn cache misses into bytes moved
+                static size_t get_cache_line_size();
+
+                bool is_open() const { return m_group_fd >= 0; }
+                /// \brief Running totals since the counters were opened
+                Sample read() const;
+
+            private:
+                HardwareCounters();
+                void close_events();
+
+                int m_group_fd{-1};
+                int m_instructions_fd{-1};
+                int m_llc_misses_fd{-1};
+            };
+        }
+    }
+}
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "ngraph/op/pad.hpp"
+#include "ngraph/state/philox_rng.hpp"
 
 // CBLAS types and wrappers
 
@@ -288,8 +289,8 @@ namespace ngraph
                                       size_t nelems,
                                       bool training,
                                       const double value,
-                                      const std::vector<std::minstd_rand>& vmsr,
-                                      const bool use_seed);
+                                      const PhiloxRNG& rng,
+                                      const uint64_t offset);
 
                 template <typename InputElementType, typename AxisElementType>
                 void reference_cumsum(void* input_tensor,
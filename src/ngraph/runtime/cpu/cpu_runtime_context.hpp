@@ -79,6 +79,8 @@ namespace ngraph
                 State* const* states;
                 std::set<size_t> breakpoints;
                 size_t pc;
+                // Index of the CPUExecutor thread pool this context executes on
+                int arena;
 #ifdef NGRAPH_MLIR_ENABLE
                 /// Maps CompiledKernel nodes to their MLIR compiler
                 /// The MLIR compiler caches the compiled code on the first invocation,
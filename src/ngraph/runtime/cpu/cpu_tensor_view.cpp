@@ -99,6 +99,7 @@ void runtime::cpu::CPUTensorView::write(const void* source, size_t n)
     {
         throw out_of_range("write access past end of tensor");
     }
+    wait_for_async_uses();
     char* target = get_data_ptr();
     memcpy(target, source, n);
 }
@@ -109,6 +110,7 @@ void runtime::cpu::CPUTensorView::read(void* target, size_t n) const
     {
         throw out_of_range("read access past end of tensor");
     }
+    wait_for_async_uses();
 
     auto tvl = this->get_tensor_layout();
     auto cpu_tvl = dynamic_cast<runtime::cpu::LayoutDescriptor*>(tvl.get());
@@ -176,8 +178,10 @@ void runtime::cpu::CPUTensorView::copy_from(const ngraph::runtime::Tensor& sourc
         throw invalid_argument("runtime::cpu::CPUTensorView::copy_from element types must match");
     }
 
+    wait_for_async_uses();
     if (auto cpu_source = dynamic_cast<const runtime::cpu::CPUTensorView*>(&source))
     {
+        cpu_source->wait_for_async_uses();
         auto this_tl =
             dynamic_cast<ngraph::runtime::cpu::LayoutDescriptor*>(this->get_tensor_layout().get());
         auto other_tl =
@@ -207,3 +211,34 @@ void runtime::cpu::CPUTensorView::copy_from(const ngraph::runtime::Tensor& sourc
             std::make_shared<runtime::cpu::LayoutDescriptor>(*m_descriptor));
     }
 }
+
+void runtime::cpu::CPUTensorView::wait_for_read_ready()
+{
+    wait_for_async_uses();
+}
+
+void runtime::cpu::CPUTensorView::wait_for_write_ready()
+{
+    wait_for_async_uses();
+}
+
+void runtime::cpu::CPUTensorView::begin_async_use()
+{
+    lock_guard<mutex> guard(m_async_mutex);
+    m_async_uses++;
+}
+
+void runtime::cpu::CPUTensorView::end_async_use()
+{
+    {
+        lock_guard<mutex> guard(m_async_mutex);
+        m_async_uses--;
+    }
+    m_async_condition.notify_all();
+}
+
+void runtime::cpu::CPUTensorView::wait_for_async_uses() const
+{
+    unique_lock<mutex> lock(m_async_mutex);
+    m_async_condition.wait(lock, [this]() { return m_async_uses == 0; });
+}
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
 #include <string>
 
 #include "ngraph/runtime/cpu/cpu_backend_visibility.h"
@@ -58,6 +60,16 @@ namespace ngraph
                 /// \param source The source tensor
                 void copy_from(const ngraph::runtime::Tensor& source) override;
 
+                /// \brief Blocks until no call_async iteration is using this tensor
+                void wait_for_read_ready() override;
+                /// \brief Blocks until no call_async iteration is using this tensor
+                void wait_for_write_ready() override;
+
+                /// \brief Marks the tensor as in use by a queued call_async iteration. read,
+                ///        write and copy_from block until the matching end_async_use.
+                CPU_BACKEND_API void begin_async_use();
+                CPU_BACKEND_API void end_async_use();
+
                 static constexpr int BufferAlignment = NGRAPH_CPU_ALIGNMENT;
 
             private:
@@ -65,9 +77,15 @@ namespace ngraph
                 CPUTensorView(CPUTensorView&&) = delete;
                 CPUTensorView& operator=(const CPUTensorView&) = delete;
 
+                void wait_for_async_uses() const;
+
                 char* buffer;
                 char* aligned_buffer;
                 size_t buffer_size;
+
+                mutable std::mutex m_async_mutex;
+                mutable std::condition_variable m_async_condition;
+                size_t m_async_uses = 0;
             };
         }
     }
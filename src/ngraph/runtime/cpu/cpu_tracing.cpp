@@ -14,10 +14,17 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 
 #include "cpu_tracing.hpp"
+#include "ngraph/chrome_trace.hpp"
+#include "ngraph/log.hpp"
 
 #ifndef NGRAPH_JSON_DISABLE
 void ngraph::runtime::cpu::to_json(nlohmann::json& json, const TraceEvent& event)
@@ -90,3 +97,208 @@ bool ngraph::runtime::cpu::IsTracingEnabled()
     return false;
 }
 #endif
+
+namespace
+{
+    // Written only by the thread that owns it. FlushOpTraceEvents is the only reader and
+    // holds the flush lock, so head and tail each have a single writer.
+    class OpTraceRing
+    {
+    public:
+        OpTraceRing(const std::string& tid)
+            : m_tid(tid)
+            , m_events(s_capacity)
+        {
+        }
+
+        // Prepares a drained ring that was given up by an exited thread for another thread
+        void reset(const std::string& tid)
+        {
+            m_tid = tid;
+            m_named = false;
+            m_retired.store(false, std::memory_order_relaxed);
+        }
+
+        void push(const ngraph::runtime::cpu::OpTraceEvent& event)
+        {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) == s_capacity)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            m_events[head % s_capacity] = event;
+            m_head.store(head + 1, std::memory_order_release);
+        }
+
+        template <typename F>
+        void drain(F&& f)
+        {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            size_t head = m_head.load(std::memory_order_acquire);
+            for (; tail != head; tail++)
+            {
+                f(m_events[tail % s_capacity]);
+            }
+            m_tail.store(tail, std::memory_order_release);
+        }
+
+        size_t take_dropped() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+        const std::string& get_tid() const { return m_tid; }
+        bool m_named = false;
+        // Set when the owning thread exits, after its last push
+        std::atomic<bool> m_retired{false};
+
+    private:
+        static const size_t s_capacity = 16384;
+        std::string m_tid;
+        std::vector<ngraph::runtime::cpu::OpTraceEvent> m_events;
+        std::atomic<size_t> m_head{0};
+        std::atomic<size_t> m_tail{0};
+        std::atomic<size_t> m_dropped{0};
+    };
+
+    struct OpTraceRings
+    {
+        std::mutex m_register_mutex;
+        std::mutex m_flush_mutex;
+        // Rings outlive their threads so that events recorded just before a worker exits
+        // still reach the trace. The flush that drains a retired ring moves it to the free
+        // list, where the next new thread picks it up.
+        std::vector<std::unique_ptr<OpTraceRing>> m_rings;
+        std::vector<std::unique_ptr<OpTraceRing>> m_free_rings;
+    };
+
+    struct OpTraceRingOwner
+    {
+        ~OpTraceRingOwner()
+        {
+            if (m_ring != nullptr)
+            {
+                m_ring->m_retired.store(true, std::memory_order_release);
+            }
+        }
+        OpTraceRing* m_ring = nullptr;
+    };
+
+    OpTraceRings& get_op_trace_rings()
+    {
+        static OpTraceRings rings;
+        return rings;
+    }
+
+    OpTraceRing& get_thread_op_trace_ring()
+    {
+        static thread_local OpTraceRingOwner owner;
+        if (owner.m_ring == nullptr)
+        {
+            const std::string& tid = ngraph::runtime::event::Manager::get_thread_id();
+            OpTraceRings& rings = get_op_trace_rings();
+            std::lock_guard<std::mutex> lock(rings.m_register_mutex);
+            if (rings.m_free_rings.empty())
+            {
+                rings.m_rings.emplace_back(new OpTraceRing(tid));
+            }
+            else
+            {
+                rings.m_rings.push_back(std::move(rings.m_free_rings.back()));
+                rings.m_free_rings.pop_back();
+                rings.m_rings.back()->reset(tid);
+            }
+            owner.m_ring = rings.m_rings.back().get();
+        }
+        return *owner.m_ring;
+    }
+
+    size_t get_tensor_bytes(const std::vector<ngraph::runtime::cpu::TensorTracerAttributes>& attrs)
+    {
+        size_t bytes = 0;
+        for (auto& attr : attrs)
+        {
+            bytes += attr.m_number_of_elements * attr.m_type_of_element.size();
+        }
+        return bytes;
+    }
+}
+
+int64_t ngraph::runtime::cpu::GetOpTraceTimestamp()
+{
+    return static_cast<int64_t>(runtime::event::Manager::get_current_microseconds());
+}
+
+void ngraph::runtime::cpu::RecordOpTraceEvent(const OpAttributes& op,
+                                              int64_t begin,
+                                              int64_t end,
+                                              int arena)
+{
+    get_thread_op_trace_ring().push({&op, begin, end, arena});
+}
+
+void ngraph::runtime::cpu::FlushOpTraceEvents()
+{
+    OpTraceRings& rings = get_op_trace_rings();
+    std::lock_guard<std::mutex> flush_lock(rings.m_flush_mutex);
+    std::vector<OpTraceRing*> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(rings.m_register_mutex);
+        for (auto& ring : rings.m_rings)
+        {
+            snapshot.push_back(ring.get());
+        }
+    }
+
+    const std::string& pid = runtime::event::Manager::get_process_id();
+    std::vector<std::string> events;
+    size_t dropped = 0;
+    std::vector<OpTraceRing*> retired;
+    for (size_t i = 0; i < snapshot.size(); i++)
+    {
+        OpTraceRing* ring = snapshot[i];
+        // Checked before draining, so that a retired ring is drained of its last events
+        if (ring->m_retired.load(std::memory_order_acquire))
+        {
+            retired.push_back(ring);
+        }
+        size_t first_event = events.size();
+        std::ostringstream prefix;
+        prefix << R"(,"ph":"X","cat":"Op","pid":)" << pid << R"(,"tid":)" << ring->get_tid();
+        ring->drain([&](const OpTraceEvent& event) {
+            std::ostringstream out;
+            out << R"({"name":")" << event.Op->Description << '"' << prefix.str()
+                << R"(,"ts":)" << event.Begin << R"(,"dur":)" << event.End - event.Begin
+                << R"(,"args":{"arena":)" << event.Arena << R"(,"input_bytes":)"
+                << get_tensor_bytes(event.Op->m_inputs_tensor_attrs) << R"(,"output_bytes":)"
+                << get_tensor_bytes(event.Op->m_outputs_tensor_attrs) << "}}";
+            events.push_back(out.str());
+        });
+        if (!ring->m_named && events.size() > first_event)
+        {
+            std::ostringstream out;
+            out << R"({"name":"thread_name","ph":"M","pid":)" << pid << R"(,"tid":)"
+                << ring->get_tid() << R"(,"args":{"name":"CPU thread )" << i << R"("}})";
+            events.push_back(out.str());
+            ring->m_named = true;
+        }
+        dropped += ring->take_dropped();
+    }
+    if (!retired.empty())
+    {
+        std::lock_guard<std::mutex> lock(rings.m_register_mutex);
+        for (OpTraceRing* ring : retired)
+        {
+            auto it = std::find_if(rings.m_rings.begin(),
+                                   rings.m_rings.end(),
+                                   [ring](const std::unique_ptr<OpTraceRing>& r) {
+                                       return r.get() == ring;
+                                   });
+            rings.m_free_rings.push_back(std::move(*it));
+            rings.m_rings.erase(it);
+        }
+    }
+    runtime::event::Manager::write_events(events);
+    if (dropped > 0)
+    {
+        NGRAPH_WARN << "CPU Backend: dropped " << dropped
+                    << " op trace events, the per-thread trace buffers were full";
+    }
+}
@@ -75,6 +75,22 @@ namespace ngraph
                                   int64_t* op_durations,
                                   const std::string& file_name);
             bool IsTracingEnabled();
+
+            // Per-op spans for the runtime::event chrome trace (NGRAPH_ENABLE_TRACING). Each
+            // thread records into its own fixed-size ring buffer without locking, and the
+            // call frame flushes all of them into the trace file once a call completes.
+            struct OpTraceEvent
+            {
+                const OpAttributes* Op;
+                int64_t Begin;
+                int64_t End;
+                int Arena;
+            };
+
+            int64_t GetOpTraceTimestamp();
+            // Dropped, and counted, when the calling thread's ring buffer is full
+            void RecordOpTraceEvent(const OpAttributes& op, int64_t begin, int64_t end, int arena);
+            void FlushOpTraceEvents();
         }
     }
 }
@@ -46,6 +46,36 @@ namespace ngraph
                         in.template cast<OutputElementType>();
                 }
 
+                // The bfloat16 conversions are split across the arena's threads and run the
+                // vectorized bulk conversion on each range
+                template <>
+                inline void
+                    convert<float, bfloat16>(void* input, void* output, size_t count, int arena)
+                {
+                    const float* in = static_cast<const float*>(input);
+                    bfloat16* out = static_cast<bfloat16*>(output);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        count,
+                        Eigen::TensorOpCost(sizeof(float), sizeof(bfloat16), 1),
+                        [in, out](Eigen::Index first, Eigen::Index last) {
+                            bfloat16::from_float(in + first, out + first, last - first);
+                        });
+                }
+
+                template <>
+                inline void
+                    convert<bfloat16, float>(void* input, void* output, size_t count, int arena)
+                {
+                    const bfloat16* in = static_cast<const bfloat16*>(input);
+                    float* out = static_cast<float*>(output);
+                    ngraph::runtime::cpu::executor::GetCPUExecutor().get_device(arena).parallelFor(
+                        count,
+                        Eigen::TensorOpCost(sizeof(bfloat16), sizeof(float), 1),
+                        [in, out](Eigen::Index first, Eigen::Index last) {
+                            bfloat16::to_float(in + first, out + first, last - first);
+                        });
+                }
+
                 template <typename InputElementType>
                 void convert_to_float32(void* input, void* output, size_t count, int arena)
                 {
@@ -19,6 +19,7 @@
 #include <random>
 
 #include "ngraph/shape.hpp"
+#include "ngraph/state/philox_rng.hpp"
 
 namespace ngraph
 {
@@ -29,6 +30,8 @@ namespace ngraph
             namespace kernel
             {
                 // Note: this kernel is for doing upscale in train
+                // The mask is drawn from positions [offset, offset + nelems) of the counter based
+                // random stream, so it is the same whatever the number of threads.
                 template <typename T, typename M>
                 void generate_dropout(T* input,
                                       T* out0,
@@ -36,14 +39,28 @@ namespace ngraph
                                       const size_t nelems,
                                       const bool training,
                                       const double keep_prob,
-                                      const std::vector<std::minstd_rand>& vmsr,
-                                      const bool use_seed)
+                                      const PhiloxRNG& rng,
+                                      const uint64_t offset)
                 {
                     if (training)
 
                     {
-                        int32_t rnd_seed = rand();
                         M dropout_prob = 1 - static_cast<M>(keep_prob);
+                        auto generate = [&](size_t idx_start, size_t idx_end) {
+                            rng.for_each_uniform(
+                                offset, idx_start, idx_end, [&](size_t idx, double u) {
+                                    if (static_cast<M>(u) < dropout_prob)
+                                    {
+                                        out1_mask[idx] = 0;
+                                        out0[idx] = 0;
+                                    }
+                                    else
+                                    {
+                                        out1_mask[idx] = 1;
+                                        out0[idx] = input[idx] / static_cast<T>(keep_prob);
+                                    }
+                                });
+                        };
 #ifdef _OPENMP
                         size_t nthr =
                             ngraph::runtime::cpu::executor::GetCPUExecutor().get_num_cores();
@@ -52,43 +69,12 @@ namespace ngraph
 #pragma omp parallel num_threads(nthr)
                         {
                             size_t tid = omp_get_thread_num();
+                            size_t idx_start = std::min(tid * chunk_size, nelems);
+                            generate(idx_start, std::min(idx_start + chunk_size, nelems));
+                        }
 #else
-                        size_t chunk_size = nelems;
-                        {
-                            size_t tid = 0;
+                        generate(0, nelems);
 #endif
-                            // Note :
-                            // In this implementation of dropout, we are trying to be same as PDPD
-                            // native implementation (and other frameworks).
-                            // https://github.com/NervanaSystems/ngraph-paddle/blob/14d88829b386c9f7601788c5539c08326dcbe2fe/paddle/fluid/operators/dropout_op.h#L58-L78
-                            // So, if framework passes same seed, then we will get same mask.
-                            std::minstd_rand msr;
-                            if (use_seed)
-                            {
-                                msr = vmsr[tid];
-                            }
-                            else
-                            {
-                                msr.seed(rnd_seed + tid);
-                            }
-                            std::uniform_real_distribution<> gen(0, 1);
-
-                            size_t idx_start = tid * chunk_size;
-                            size_t idx_end = std::min(idx_start + chunk_size, nelems);
-                            for (size_t idx = idx_start; idx < idx_end; ++idx)
-                            {
-                                if (static_cast<M>(gen(msr)) < dropout_prob)
-                                {
-                                    out1_mask[idx] = 0;
-                                    out0[idx] = 0;
-                                }
-                                else
-                                {
-                                    out1_mask[idx] = 1;
-                                    out0[idx] = input[idx] / static_cast<T>(keep_prob);
-                                }
-                            }
-                        }
                     }
                     else
                     {
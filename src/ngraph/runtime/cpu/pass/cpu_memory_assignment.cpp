@@ -15,8 +15,10 @@
 //*****************************************************************************
 
 #include <exception>
+#include <iostream>
 #include <sstream>
 
+#include "ngraph/env_util.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/log.hpp"
 #include "ngraph/op/concat.hpp"
@@ -36,9 +38,12 @@ runtime::cpu::pass::CPUMemoryAssignment::CPUMemoryAssignment(
         bufferID_to_tensorSets,
     unordered_map<descriptor::Tensor*, size_t>& tensor_to_bufferID,
     size_t alignment,
-    bool disable_memory_sharing)
+    bool disable_memory_sharing,
+    ngraph::pass::MemoryManager::allocation_scheme scheme)
     : m_alignment(alignment)
     , m_disable_memory_sharing(disable_memory_sharing)
+    , m_scheme(disable_memory_sharing ? ngraph::pass::MemoryManager::allocation_scheme::NO_REUSE
+                                      : scheme)
     , m_bufferID_to_tensorSets(bufferID_to_tensorSets)
     , m_tensor_to_bufferID(tensor_to_bufferID)
 {
@@ -628,7 +633,9 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
     // memory assignment using liveness analysis result
 
     // memory manager for non-cacheable ops, memory allocation will be freed when not longer in use
-    ngraph::pass::MemoryManager mm(m_alignment, m_disable_memory_sharing);
+    ngraph::pass::MemoryManager mm(m_alignment, m_scheme);
+    // tensors whose offsets come from mm, remapped once an offline scheme has been planned
+    unordered_set<descriptor::Tensor*> planned_tensors;
     // memory manager for cacheable ops, memory allocation will never be freed
     ngraph::pass::MemoryManager mm_caching(m_alignment, true);
 
@@ -755,10 +762,17 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
                     // of the set of input tensor.
                     // do not combine those two sets.
                     // change the label of output tensor set to that of input tensor set
+                    // offset is still to be resolved by mm only when the input set's buffer
+                    // was allocated from mm, not from mm_caching
+                    bool allocated_from_mm = planned_tensors.count(input_tensor) != 0;
                     output_buffer_it->second.first = input_buffer_it->second.first;
                     for (auto& ele_t : output_set)
                     {
                         ele_t->set_pool_offset(offset);
+                        if (allocated_from_mm)
+                        {
+                            planned_tensors.insert(ele_t);
+                        }
                     }
                 }
             }
@@ -790,6 +804,8 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
             else
             {
                 offset = mm.allocate(size);
+                planned_tensors.insert(tensor);
+                planned_tensors.insert(tensor_set.begin(), tensor_set.end());
             }
             tensor->set_pool_offset(offset);
             for (auto& e : tensor_set)
@@ -816,6 +832,13 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
         }
     }
 
+    // Offline schemes hand out buffer ids above, resolve them to offsets
+    mm.plan();
+    for (descriptor::Tensor* tensor : planned_tensors)
+    {
+        tensor->set_pool_offset(mm.get_offset(tensor->get_pool_offset()));
+    }
+
     // update offsets in concat and slice tensors set.
     // In place concatenation optimization
     process_in_place_concat(ops);
@@ -846,5 +869,11 @@ bool runtime::cpu::pass::CPUMemoryAssignment::run_on_function(shared_ptr<ngraph:
 
     function->set_temporary_pool_size(mm.max_allocated() + mm_caching.max_allocated());
 
+    if (getenv_bool("NGRAPH_MEMORY_PLAN_REPORT"))
+    {
+        std::cout << "CPUMemoryAssignment " << function->get_name() << "\n";
+        mm.dump_plan_report(std::cout);
+    }
+
     return false;
 }
@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "ngraph/pass/memory_layout.hpp"
 #include "ngraph/pass/pass.hpp"
 #include "ngraph/util.hpp"
 
@@ -45,7 +46,9 @@ public:
         std::unordered_map<size_t, std::pair<TensorRole, std::unordered_set<descriptor::Tensor*>>>&,
         std::unordered_map<descriptor::Tensor*, size_t>&,
         size_t alignment = 1,
-        bool disable_memory_sharing = false);
+        bool disable_memory_sharing = false,
+        ngraph::pass::MemoryManager::allocation_scheme scheme =
+            ngraph::pass::MemoryManager::allocation_scheme::FIRST_FIT);
     bool run_on_function(std::shared_ptr<ngraph::Function>) override;
 
 private:
@@ -71,6 +74,7 @@ private:
 
     size_t m_alignment;
     bool m_disable_memory_sharing;
+    ngraph::pass::MemoryManager::allocation_scheme m_scheme;
     std::set<descriptor::Tensor*> m_tensor_caching;
     std::unordered_map<size_t,
                        std::pair<ngraph::TensorRole, std::unordered_set<descriptor::Tensor*>>>&
@@ -14,19 +14,14 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+
 #include "ngraph/runtime/dynamic/dynamic_backend.hpp"
 #include "ngraph/graph_util.hpp"
-#include "ngraph/op/avg_pool.hpp"
-#include "ngraph/op/broadcast.hpp"
-#include "ngraph/op/convolution.hpp"
-#include "ngraph/op/experimental/dyn_broadcast.hpp"
-#include "ngraph/op/experimental/dyn_replace_slice.hpp"
-#include "ngraph/op/experimental/dyn_reshape.hpp"
-#include "ngraph/op/experimental/dyn_slice.hpp"
-#include "ngraph/op/experimental/generate_mask.hpp"
-#include "ngraph/op/experimental/range.hpp"
-#include "ngraph/op/experimental/transpose.hpp"
-#include "ngraph/op/reshape.hpp"
+#include "ngraph/ops.hpp"
 #include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/dyn_elimination.hpp"
 #include "ngraph/pass/manager.hpp"
@@ -111,17 +106,614 @@ static size_t count_dyn_nodes(const shared_ptr<ngraph::Function>& f)
     return count;
 }
 
+namespace
+{
+    // How a tensor of a bucketed function is padded
+    struct Padding
+    {
+        // For each axis, the index of the bucketed dimension it is padded along, or -1. Empty
+        // for tensors without padding.
+        std::vector<int64_t> dims;
+        // Whether the padding is known to hold zeros
+        bool zeros = true;
+
+        bool is_padded() const
+        {
+            return std::any_of(dims.begin(), dims.end(), [](int64_t dim) { return dim >= 0; });
+        }
+        int64_t get_dim(size_t axis) const { return dims.empty() ? -1 : dims[axis]; }
+    };
+
+    // The value an op ignores, which a masked input gets in its padding
+    enum class PaddingFill
+    {
+        ZERO,
+        ONE,
+        LOWEST,
+        HIGHEST
+    };
+
+    struct MaskedInput
+    {
+        Input<Node> input;
+        PaddingFill fill;
+    };
+}
+
+// Whether the output padding of an elementwise op holds zeros given that of its inputs
+static bool keeps_zero_padding(const shared_ptr<Node>& op, const std::vector<Padding>& inputs)
+{
+    if (op->is_unary_elementwise_arithmetic() || is_type<op::Convert>(op))
+    {
+        return inputs[0].zeros &&
+               (is_type<op::Abs>(op) || is_type<op::Asin>(op) || is_type<op::Atan>(op) ||
+                is_type<op::Ceiling>(op) || is_type<op::Convert>(op) || is_type<op::Floor>(op) ||
+                is_type<op::Negative>(op) || is_type<op::Relu>(op) || is_type<op::Sign>(op) ||
+                is_type<op::Sin>(op) || is_type<op::Sinh>(op) || is_type<op::Sqrt>(op) ||
+                is_type<op::Tan>(op) || is_type<op::Tanh>(op));
+    }
+    if (is_type<op::Multiply>(op) || is_type<op::And>(op))
+    {
+        return inputs[0].zeros || inputs[1].zeros;
+    }
+    return inputs[0].zeros && inputs[1].zeros &&
+           (is_type<op::Add>(op) || is_type<op::Subtract>(op) || is_type<op::Maximum>(op) ||
+            is_type<op::Minimum>(op) || is_type<op::Or>(op));
+}
+
+// Works out how every output of f is padded when the dimensions in bucketed_dims are rounded
+// up to buckets and the parameters are zero-padded. The inputs of ops that combine elements
+// across a padded axis are added to masked_inputs unless their padding already holds zeros
+// and zeros are what the op ignores. Returns the first op whose output would depend on the
+// padding, or null if there is none.
+static shared_ptr<Node> analyze_padding(const shared_ptr<Function>& f,
+                                        const std::vector<std::pair<size_t, size_t>>& bucketed_dims,
+                                        std::map<Output<Node>, Padding>& paddings,
+                                        std::vector<MaskedInput>& masked_inputs)
+{
+    const ParameterVector& parameters = f->get_parameters();
+    for (auto op : f->get_ordered_ops())
+    {
+        std::vector<Padding> inputs;
+        bool padded = false;
+        for (auto& value : op->input_values())
+        {
+            inputs.push_back(paddings[value]);
+            padded = padded || inputs.back().is_padded();
+        }
+
+        Padding output;
+        if (op->is_parameter())
+        {
+            size_t index = std::find(parameters.begin(), parameters.end(), op) - parameters.begin();
+            for (size_t dim = 0; dim < bucketed_dims.size(); dim++)
+            {
+                if (bucketed_dims[dim].first == index)
+                {
+                    output.dims.resize(op->get_output_partial_shape(0).rank().get_length(), -1);
+                    output.dims[bucketed_dims[dim].second] = dim;
+                }
+            }
+        }
+        else if (!padded)
+        {
+            // Computed from unpadded tensors only
+        }
+        else if (op->is_output())
+        {
+            output = inputs[0];
+        }
+        else if (op->is_unary_elementwise_arithmetic() || is_type<op::Convert>(op))
+        {
+            output.dims = inputs[0].dims;
+            output.zeros = keeps_zero_padding(op, inputs);
+        }
+        else if ((op->is_binary_elementwise_arithmetic() ||
+                  op->is_binary_elementwise_comparison() || op->is_binary_elementwise_logical()) &&
+                 op->get_autob().m_type == op::AutoBroadcastType::NONE)
+        {
+            output.dims = inputs[0].is_padded() ? inputs[0].dims : inputs[1].dims;
+            for (size_t axis = 0; axis < output.dims.size(); axis++)
+            {
+                if (output.dims[axis] < 0)
+                {
+                    output.dims[axis] = inputs[1].get_dim(axis);
+                }
+            }
+            output.zeros = keeps_zero_padding(op, inputs);
+        }
+        else if (is_type<op::Sum>(op) || is_type<op::Product>(op) || is_type<op::Max>(op) ||
+                 is_type<op::Min>(op))
+        {
+            AxisSet reduction_axes =
+                static_pointer_cast<op::util::ArithmeticReduction>(op)->get_reduction_axes();
+            bool reduces_padding = false;
+            for (size_t axis = 0; axis < inputs[0].dims.size(); axis++)
+            {
+                if (reduction_axes.count(axis) == 0)
+                {
+                    output.dims.push_back(inputs[0].dims[axis]);
+                }
+                else if (inputs[0].dims[axis] >= 0)
+                {
+                    reduces_padding = true;
+                }
+            }
+            // A row of padding reduces to padding, zero if the row is
+            output.zeros = inputs[0].zeros;
+            if (is_type<op::Sum>(op) && reduces_padding && !inputs[0].zeros)
+            {
+                masked_inputs.push_back(MaskedInput{op->input(0), PaddingFill::ZERO});
+                output.zeros = true;
+            }
+            else if (!is_type<op::Sum>(op) && reduces_padding)
+            {
+                PaddingFill fill = is_type<op::Product>(op)
+                                       ? PaddingFill::ONE
+                                       : is_type<op::Max>(op) ? PaddingFill::LOWEST
+                                                              : PaddingFill::HIGHEST;
+                masked_inputs.push_back(MaskedInput{op->input(0), fill});
+                output.zeros = false;
+            }
+        }
+        else if (is_type<op::Dot>(op))
+        {
+            size_t reduction_axes_count =
+                static_pointer_cast<op::Dot>(op)->get_reduction_axes_count();
+            size_t rank0 = op->get_input_partial_shape(0).rank().get_length();
+            size_t rank1 = op->get_input_partial_shape(1).rank().get_length();
+            bool reduces_padding = false;
+            for (size_t i = 0; i < reduction_axes_count; i++)
+            {
+                reduces_padding = reduces_padding ||
+                                  inputs[0].get_dim(rank0 - reduction_axes_count + i) >= 0 ||
+                                  inputs[1].get_dim(i) >= 0;
+            }
+            if (reduces_padding && !inputs[0].zeros && !inputs[1].zeros)
+            {
+                size_t masked = inputs[0].is_padded() ? 0 : 1;
+                masked_inputs.push_back(MaskedInput{op->input(masked), PaddingFill::ZERO});
+                inputs[masked].zeros = true;
+            }
+            for (size_t axis = 0; axis < rank0 - reduction_axes_count; axis++)
+            {
+                output.dims.push_back(inputs[0].get_dim(axis));
+            }
+            for (size_t axis = reduction_axes_count; axis < rank1; axis++)
+            {
+                output.dims.push_back(inputs[1].get_dim(axis));
+            }
+            output.zeros = inputs[0].zeros && inputs[1].zeros;
+        }
+        else if (is_type<op::Softmax>(op))
+        {
+            output.dims = inputs[0].dims;
+            for (size_t axis : static_pointer_cast<op::Softmax>(op)->get_axes())
+            {
+                if (inputs[0].dims[axis] >= 0)
+                {
+                    masked_inputs.push_back(MaskedInput{op->input(0), PaddingFill::LOWEST});
+                    break;
+                }
+            }
+            // Rows of padding are normalized too
+            output.zeros = false;
+        }
+        else if (is_type<op::Transpose>(op) || is_type<op::Reshape>(op))
+        {
+            AxisVector order;
+            if (auto transpose = as_type_ptr<op::Transpose>(op))
+            {
+                auto order_constant = as_type_ptr<op::Constant>(transpose->get_argument(1));
+                if (!order_constant || inputs[1].is_padded())
+                {
+                    return op;
+                }
+                order = order_constant->get_axis_vector_val();
+            }
+            else
+            {
+                // Only reshapes that permute the axes keep each padded axis whole
+                auto reshape = static_pointer_cast<op::Reshape>(op);
+                order = reshape->get_input_order();
+                const PartialShape& input_shape = op->get_input_partial_shape(0);
+                const Shape& output_shape = reshape->get_output_shape();
+                if (order.size() != output_shape.size() || input_shape.is_dynamic())
+                {
+                    return op;
+                }
+                for (size_t axis = 0; axis < order.size(); axis++)
+                {
+                    if (output_shape[axis] != input_shape.to_shape()[order[axis]])
+                    {
+                        return op;
+                    }
+                }
+            }
+            for (size_t axis : order)
+            {
+                output.dims.push_back(inputs[0].dims[axis]);
+            }
+            output.zeros = inputs[0].zeros;
+        }
+        else
+        {
+            return op;
+        }
+
+        for (auto& value : op->outputs())
+        {
+            paddings[value] = output;
+        }
+    }
+    return nullptr;
+}
+
+void runtime::dynamic::DynamicExecutable::set_shape_buckets(const std::vector<size_t>& buckets)
+{
+    std::vector<std::pair<size_t, size_t>> bucketed_dims;
+    std::vector<std::vector<int64_t>> result_dims;
+    if (!buckets.empty())
+    {
+        const ParameterVector& parameters = m_wrapped_function->get_parameters();
+        for (size_t i = 0; i < parameters.size(); i++)
+        {
+            if (parameters[i]->is_relevant_to_shapes())
+            {
+                continue;
+            }
+            const PartialShape& pshape = parameters[i]->get_output_partial_shape(0);
+            NGRAPH_CHECK(pshape.rank().is_static(),
+                         "Shape buckets need inputs of static rank, but ",
+                         *parameters[i],
+                         " has dynamic rank");
+            for (size_t axis = 0; axis < pshape.rank().get_length(); axis++)
+            {
+                if (pshape[axis].is_dynamic())
+                {
+                    bucketed_dims.emplace_back(i, axis);
+                }
+            }
+        }
+
+        std::map<Output<Node>, Padding> paddings;
+        std::vector<MaskedInput> masked_inputs;
+        auto unsupported =
+            analyze_padding(m_wrapped_function, bucketed_dims, paddings, masked_inputs);
+        NGRAPH_CHECK(!unsupported,
+                     "Shape buckets are not supported for functions in which the output of ",
+                     *unsupported,
+                     " depends on the padded extent");
+        for (auto result : m_wrapped_function->get_results())
+        {
+            result_dims.push_back(paddings[result->output(0)].dims);
+        }
+    }
+    m_bucketed_dims = bucketed_dims;
+    m_result_dims = result_dims;
+    m_shape_buckets = buckets;
+    std::sort(m_shape_buckets.begin(), m_shape_buckets.end());
+
+    // The executables compiled so far take other masks, if any
+    auto lru = std::make_shared<runtime::LRUCache>();
+    lru->set_cache_size(m_lru->get_cache_size());
+    lru->set_cache_size_bytes(m_lru->get_cache_size_bytes());
+    m_lru = lru;
+}
+
+void runtime::dynamic::DynamicExecutable::set_cache_capacity(size_t capacity)
+{
+    m_lru->set_cache_size(capacity);
+}
+
+void runtime::dynamic::DynamicExecutable::set_cache_capacity_bytes(size_t capacity_bytes)
+{
+    m_lru->set_cache_size_bytes(capacity_bytes);
+}
+
+runtime::dynamic::DynamicExecutable::CacheStatistics
+    runtime::dynamic::DynamicExecutable::get_cache_statistics() const
+{
+    std::lock_guard<std::mutex> guard(m_stats_mutex);
+    return m_stats;
+}
+
+Shape runtime::dynamic::DynamicExecutable::get_bucketed_shape(size_t input_index,
+                                                              const Shape& shape) const
+{
+    Shape bucketed = shape;
+    for (auto& dim : m_bucketed_dims)
+    {
+        if (dim.first != input_index)
+        {
+            continue;
+        }
+        auto bucket = std::lower_bound(
+            m_shape_buckets.begin(), m_shape_buckets.end(), shape[dim.second]);
+        if (bucket != m_shape_buckets.end())
+        {
+            bucketed[dim.second] = *bucket;
+        }
+    }
+    return bucketed;
+}
+
+// Copies the low corner of shape copy_shape from src to dst. Padding copies all of src into
+// the low corner of a zero-filled, larger dst; slicing copies the low corner of src into
+// all of a smaller dst.
+static void copy_corner(const char* src,
+                        const Shape& src_shape,
+                        char* dst,
+                        const Shape& dst_shape,
+                        const Shape& copy_shape,
+                        size_t element_size,
+                        size_t axis = 0)
+{
+    if (axis == copy_shape.size())
+    {
+        std::memcpy(dst, src, element_size);
+        return;
+    }
+    size_t src_stride = shape_size(Shape(src_shape.begin() + axis + 1, src_shape.end()));
+    size_t dst_stride = shape_size(Shape(dst_shape.begin() + axis + 1, dst_shape.end()));
+    if (axis + 1 == copy_shape.size())
+    {
+        std::memcpy(dst, src, copy_shape[axis] * element_size);
+        return;
+    }
+    for (size_t i = 0; i < copy_shape[axis]; i++)
+    {
+        copy_corner(src + i * src_stride * element_size,
+                    src_shape,
+                    dst + i * dst_stride * element_size,
+                    dst_shape,
+                    copy_shape,
+                    element_size,
+                    axis + 1);
+    }
+}
+
+shared_ptr<runtime::Tensor>
+    runtime::dynamic::DynamicExecutable::pad_input(const shared_ptr<runtime::Tensor>& input,
+                                                   const Shape& bucketed_shape)
+{
+    const element::Type& et = input->get_element_type();
+    std::vector<char> src(input->get_size_in_bytes());
+    input->read(src.data(), src.size());
+    std::vector<char> dst(shape_size(bucketed_shape) * et.size(), 0);
+    copy_corner(src.data(),
+                input->get_shape(),
+                dst.data(),
+                bucketed_shape,
+                input->get_shape(),
+                et.size());
+    auto padded = m_wrapped_backend->create_tensor(et, bucketed_shape);
+    padded->write(dst.data(), dst.size());
+    return padded;
+}
+
+template <typename T>
+static shared_ptr<Node> make_fill_constant(const element::Type& et, PaddingFill fill)
+{
+    T value = static_cast<T>(0);
+    switch (fill)
+    {
+    case PaddingFill::ZERO: break;
+    case PaddingFill::ONE: value = static_cast<T>(1); break;
+    case PaddingFill::LOWEST: value = std::numeric_limits<T>::lowest(); break;
+    case PaddingFill::HIGHEST: value = std::numeric_limits<T>::max(); break;
+    }
+    return make_shared<op::Constant>(et, Shape{}, std::vector<T>{value});
+}
+
+static shared_ptr<Node> make_fill_constant(const element::Type& et, PaddingFill fill)
+{
+    switch (et)
+    {
+    case element::Type_t::bf16: return make_fill_constant<bfloat16>(et, fill);
+    case element::Type_t::f16: return make_fill_constant<float16>(et, fill);
+    case element::Type_t::f32: return make_fill_constant<float>(et, fill);
+    case element::Type_t::f64: return make_fill_constant<double>(et, fill);
+    case element::Type_t::i8: return make_fill_constant<int8_t>(et, fill);
+    case element::Type_t::i16: return make_fill_constant<int16_t>(et, fill);
+    case element::Type_t::i32: return make_fill_constant<int32_t>(et, fill);
+    case element::Type_t::i64: return make_fill_constant<int64_t>(et, fill);
+    case element::Type_t::u8: return make_fill_constant<uint8_t>(et, fill);
+    case element::Type_t::u16: return make_fill_constant<uint16_t>(et, fill);
+    case element::Type_t::u32: return make_fill_constant<uint32_t>(et, fill);
+    case element::Type_t::u64: return make_fill_constant<uint64_t>(et, fill);
+    case element::Type_t::boolean:
+    case element::Type_t::u1:
+    case element::Type_t::undefined:
+    case element::Type_t::dynamic: break;
+    }
+    throw ngraph_error("Cannot mask the padding of a tensor of element type " + et.get_type_name());
+}
+
+// The masks are boolean parameters, one per bucketed dimension and appended to those of the
+// clone, that are true at the valid positions of the dimension
+shared_ptr<Function> runtime::dynamic::DynamicExecutable::add_padding_masks(
+    const shared_ptr<Function>& clone, const std::vector<PartialShape>& arg_shapes)
+{
+    std::map<Output<Node>, Padding> paddings;
+    std::vector<MaskedInput> masked_inputs;
+    auto unsupported = analyze_padding(clone, m_bucketed_dims, paddings, masked_inputs);
+    NGRAPH_CHECK(!unsupported,
+                 "Shape buckets are not supported for functions in which the output of ",
+                 *unsupported,
+                 " depends on the padded extent");
+
+    ParameterVector masks;
+    for (auto& dim : m_bucketed_dims)
+    {
+        size_t length = arg_shapes[dim.first].to_shape()[dim.second];
+        masks.push_back(make_shared<op::Parameter>(element::boolean, Shape{length}));
+    }
+    for (auto& masked_input : masked_inputs)
+    {
+        Output<Node> value = masked_input.input.get_source_output();
+        const Shape& shape = value.get_shape();
+        const Padding& padding = paddings[value];
+        AxisSet all_axes;
+        for (size_t axis = 0; axis < shape.size(); axis++)
+        {
+            all_axes.insert(axis);
+        }
+
+        shared_ptr<Node> mask;
+        for (size_t axis = 0; axis < shape.size(); axis++)
+        {
+            if (padding.dims[axis] < 0)
+            {
+                continue;
+            }
+            AxisSet broadcast_axes = all_axes;
+            broadcast_axes.erase(axis);
+            shared_ptr<Node> axis_mask =
+                make_shared<op::Broadcast>(masks[padding.dims[axis]], shape, broadcast_axes);
+            mask = mask ? make_shared<op::And>(mask, axis_mask) : axis_mask;
+        }
+        auto fill = make_shared<op::Broadcast>(
+            make_fill_constant(value.get_element_type(), masked_input.fill), shape, all_axes);
+        masked_input.input.replace_source_output(make_shared<op::Select>(mask, value, fill));
+    }
+
+    ParameterVector parameters = clone->get_parameters();
+    parameters.insert(parameters.end(), masks.begin(), masks.end());
+    return make_shared<Function>(clone->get_results(), parameters, clone->get_name());
+}
+
+shared_ptr<runtime::Executable> runtime::dynamic::DynamicExecutable::compile_specialized(
+    const std::vector<element::Type>& arg_element_types,
+    const std::vector<PartialShape>& arg_shapes,
+    const std::vector<void*>& arg_value_base_pointers,
+    std::shared_ptr<Function>& clone)
+{
+    stopwatch timer;
+    timer.start();
+
+    clone = specialize_function(
+        m_wrapped_function, arg_element_types, arg_shapes, arg_value_base_pointers);
+
+    pass::Manager passes;
+    passes.register_pass<pass::ConstantFolding>();
+    passes.register_pass<pass::DynElimination>();
+    passes.register_pass<pass::Opset0Downgrade>(); // Converts dynamic v1 variants to v0 ops
+    passes.set_per_pass_validation(false);
+
+    // FIXME(amprocte): Vile, temporary hack: we need to do repeated rounds of
+    // ConstantFolding/DynElimination until everything that DynElimination is supposed to
+    // eliminate has actually been eliminated. We could do this by monitoring the return values
+    // of the passes (keep iterating until both CF and DE report no changes), but that did not
+    // seem to work so here we are. Probably a better fix is to somehow combine the matchers in
+    // CF
+    // and DE into one pass.
+    size_t num_dyn_nodes_last_pass = std::numeric_limits<size_t>::max();
+
+    while (num_dyn_nodes_last_pass != 0)
+    {
+        passes.run_passes(clone);
+        auto num_dyn_nodes_this_pass = count_dyn_nodes(clone);
+
+        NGRAPH_CHECK(num_dyn_nodes_this_pass < num_dyn_nodes_last_pass,
+                     "Could not eliminate all Dyn nodes (",
+                     num_dyn_nodes_this_pass,
+                     " remaining)");
+
+        num_dyn_nodes_last_pass = num_dyn_nodes_this_pass;
+    }
+
+    pass::Manager pass_val;
+    pass_val.register_pass<pass::Validate>();
+    pass_val.run_passes(clone);
+
+    const ResultVector& results = clone->get_results();
+    for (auto& result : results)
+    {
+        NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
+                     "Shape staticization failed for result node ",
+                     *result);
+    }
+
+    if (!m_bucketed_dims.empty())
+    {
+        clone = add_padding_masks(clone, arg_shapes);
+    }
+
+    auto compiled_executable = m_wrapped_backend->compile(clone, m_enable_performance_collection);
+
+    timer.stop();
+    {
+        std::lock_guard<std::mutex> guard(m_stats_mutex);
+        m_stats.m_misses++;
+        m_stats.m_compile_microseconds += timer.get_microseconds();
+    }
+    return compiled_executable;
+}
+
+std::future<void>
+    runtime::dynamic::DynamicExecutable::precompile(const std::vector<Shape>& input_shapes)
+{
+    NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == input_shapes.size());
+    std::vector<element::Type> arg_element_types;
+    std::vector<PartialShape> arg_shapes;
+    std::vector<int> merged_input_shapes;
+    for (size_t i = 0; i < input_shapes.size(); i++)
+    {
+        auto parameter = m_wrapped_function->get_parameters()[i];
+        NGRAPH_CHECK(!parameter->is_relevant_to_shapes(),
+                     "Cannot precompile a function with inputs relevant to shapes");
+        Shape shape = get_bucketed_shape(i, input_shapes[i]);
+        arg_element_types.push_back(parameter->get_element_type());
+        arg_shapes.push_back(shape);
+        merged_input_shapes.insert(merged_input_shapes.end(), shape.begin(), shape.end());
+        merged_input_shapes.emplace_back(-1);
+    }
+
+    return std::async(std::launch::async,
+                      [this, arg_element_types, arg_shapes, merged_input_shapes]() {
+                          m_lru->get_or_compile(merged_input_shapes, [&]() {
+                              std::shared_ptr<Function> clone;
+                              auto exec =
+                                  compile_specialized(arg_element_types,
+                                                      arg_shapes,
+                                                      std::vector<void*>(arg_shapes.size()),
+                                                      clone);
+                              return runtime::LRUCache::Entry(exec, clone);
+                          });
+                      });
+}
+
 bool runtime::dynamic::DynamicExecutable::call(
     const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
-    const std::vector<std::shared_ptr<runtime::Tensor>>& inputs)
+    const std::vector<std::shared_ptr<runtime::Tensor>>& call_inputs)
 {
     // TODO: Get cached executable out if it exists.
     // We will cache on:
     // (1) all shapes;
     // (2) all values of shape-relevant input tensors.
 
+    NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == call_inputs.size());
+
+    // Pad the inputs that are not relevant to shapes up to their shape buckets
+    std::vector<std::shared_ptr<runtime::Tensor>> inputs = call_inputs;
+    if (!m_shape_buckets.empty())
+    {
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            if (m_wrapped_function->get_parameters()[i]->is_relevant_to_shapes())
+            {
+                continue;
+            }
+            Shape bucketed_shape = get_bucketed_shape(i, inputs[i]->get_shape());
+            if (bucketed_shape != inputs[i]->get_shape())
+            {
+                inputs[i] = pad_input(inputs[i], bucketed_shape);
+            }
+        }
+    }
+
     std::vector<int> merged_input_shapes;
-    std::ostringstream key;
     size_t loop_count = 0;
     for (auto& input : inputs)
     {
@@ -151,173 +743,158 @@ bool runtime::dynamic::DynamicExecutable::call(
         loop_count++;
     }
 
-    std::copy(merged_input_shapes.begin(),
-              merged_input_shapes.end(),
-              std::ostream_iterator<int>(key, ", "));
-
-    if (m_lru->is_cached(merged_input_shapes))
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
+    for (auto& input : inputs)
     {
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
-
-        std::shared_ptr<Function> clone = m_lru->get_cloned_function(merged_input_shapes);
-        const ResultVector& results = clone->get_results();
-        for (auto& result : results)
+        if (auto dynamic_tensor = std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
         {
-            NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
-                         "Shape staticization failed for result node ",
-                         *result);
+            NGRAPH_CHECK(dynamic_tensor->has_storage());
+            wrapped_inputs.push_back(dynamic_tensor->get_wrapped_tensor());
         }
-        NGRAPH_CHECK(results.size() == outputs.size());
+        else
+        {
+            wrapped_inputs.push_back(input);
+        }
+    }
+
+    // Only the first caller to miss on this key compiles; concurrent callers with the same
+    // key wait for its result.
+    auto compile = [&]() {
+        std::vector<element::Type> arg_element_types;
+        std::vector<PartialShape> arg_shapes;
+
+        // We'll use AlignedBuffers to back the base pointers, storing them in this vector for
+        // RAII
+        // purposes.
+        std::vector<AlignedBuffer> arg_buffers;
+        arg_buffers.reserve(inputs.size());
+        std::vector<void*> arg_value_base_pointers(inputs.size());
 
-        for (size_t i = 0; i < outputs.size(); i++)
+        for (size_t i = 0; i < inputs.size(); i++)
         {
-            if (auto dynamic_tensor =
-                    std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
+            auto& input = inputs[i];
+            if (m_wrapped_function->get_parameters()[i]->is_relevant_to_shapes())
             {
-                dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
-                                             results[i]->get_output_shape(0));
-                wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
+                arg_buffers.emplace_back(input->get_size_in_bytes(), /*alignment=*/64);
+                arg_value_base_pointers[i] = arg_buffers.back().get_ptr();
+
+                // TODO(amprocte): For host-resident tensors we should be able to skip the read,
+                // but no API for that yet.
+                input->read(arg_value_base_pointers[i], input->get_size_in_bytes());
             }
             else
             {
-                wrapped_outputs.push_back(outputs[i]);
+                arg_value_base_pointers[i] = nullptr;
             }
+
+            arg_element_types.push_back(wrapped_inputs[i]->get_element_type());
+            arg_shapes.push_back(wrapped_inputs[i]->get_shape());
         }
 
-        return m_lru->get_cached_entry(merged_input_shapes)->call(wrapped_outputs, inputs);
-    }
-    else
+        std::shared_ptr<Function> clone;
+        auto exec =
+            compile_specialized(arg_element_types, arg_shapes, arg_value_base_pointers, clone);
+        return runtime::LRUCache::Entry(exec, clone);
+    };
+
+    bool was_cached = false;
+    auto entry = m_lru->get_or_compile(merged_input_shapes, compile, &was_cached);
+    std::shared_ptr<runtime::Executable> compiled_executable = entry.first;
+    std::shared_ptr<Function> clone = entry.second;
+    if (was_cached)
     {
-        NGRAPH_CHECK(m_wrapped_function->get_parameters().size() == inputs.size());
+        std::lock_guard<std::mutex> guard(m_stats_mutex);
+        m_stats.m_hits++;
+    }
 
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_inputs;
-        std::vector<element::Type> arg_element_types;
-        std::vector<PartialShape> arg_shapes;
+    // The masks of the valid positions of the bucketed dimensions follow the inputs
+    for (auto& dim : m_bucketed_dims)
+    {
+        size_t valid_length = call_inputs[dim.first]->get_shape()[dim.second];
+        size_t length = inputs[dim.first]->get_shape()[dim.second];
+        std::vector<char> valid(length, 0);
+        std::fill(valid.begin(), valid.begin() + valid_length, 1);
+        auto mask = m_wrapped_backend->create_tensor(element::boolean, Shape{length});
+        mask->write(valid.data(), valid.size());
+        wrapped_inputs.push_back(mask);
+    }
 
-        std::shared_ptr<Function> clone;
-        {
-            // We'll use AlignedBuffers to back the base pointers, storing them in this vector for
-            // RAII
-            // purposes.
-            std::vector<AlignedBuffer> arg_buffers;
-            arg_buffers.reserve(inputs.size());
-            std::vector<void*> arg_value_base_pointers(inputs.size());
+    std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
+    // Padded results are computed into temporaries and sliced back into the outputs
+    std::vector<std::shared_ptr<runtime::Tensor>> padded_outputs(outputs.size());
+    bool padded = false;
 
-            size_t i = 0;
+    const ResultVector& results = clone->get_results();
+    NGRAPH_CHECK(results.size() == outputs.size());
 
-            for (auto& input : inputs)
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        const element::Type& et = results[i]->get_output_element_type(0);
+        Shape shape = results[i]->get_output_shape(0);
+        if (!m_result_dims.empty() && !m_result_dims[i].empty())
+        {
+            Shape unpadded_shape = shape;
+            for (size_t axis = 0; axis < shape.size(); axis++)
             {
-                if (m_wrapped_function->get_parameters()[i]->is_relevant_to_shapes())
-                {
-                    // TODO(amprocte): Move has_storage() to runtime::Tensor?
-                    if (auto dynamic_tensor =
-                            std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
-                    {
-                        NGRAPH_CHECK(dynamic_tensor->has_storage());
-                    }
-
-                    arg_buffers.emplace_back(input->get_size_in_bytes(), /*alignment=*/64);
-                    arg_value_base_pointers[i] = arg_buffers.back().get_ptr();
-
-                    // TODO(amprocte): For host-resident tensors we should be able to skip the read,
-                    // but no API for that yet.
-                    input->read(arg_value_base_pointers[i], input->get_size_in_bytes());
-                }
-                else
-                {
-                    arg_value_base_pointers[i] = nullptr;
-                }
-
-                if (auto dynamic_tensor =
-                        std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(input))
-                {
-                    NGRAPH_CHECK(dynamic_tensor->has_storage());
-                    arg_element_types.push_back(
-                        dynamic_tensor->get_wrapped_tensor()->get_element_type());
-                    arg_shapes.push_back(dynamic_tensor->get_wrapped_tensor()->get_shape());
-                    wrapped_inputs.push_back(dynamic_tensor->get_wrapped_tensor());
-                }
-                else
+                int64_t dim = m_result_dims[i][axis];
+                if (dim >= 0)
                 {
-                    arg_element_types.push_back(input->get_element_type());
-                    arg_shapes.push_back(input->get_shape());
-                    wrapped_inputs.push_back(input);
+                    unpadded_shape[axis] = call_inputs[m_bucketed_dims[dim].first]
+                                               ->get_shape()[m_bucketed_dims[dim].second];
                 }
-
-                i++;
             }
-
-            clone = specialize_function(
-                m_wrapped_function, arg_element_types, arg_shapes, arg_value_base_pointers);
+            if (unpadded_shape != shape)
+            {
+                padded_outputs[i] = m_wrapped_backend->create_tensor(et, shape);
+                shape = unpadded_shape;
+                padded = true;
+            }
         }
 
-        pass::Manager passes;
-        passes.register_pass<pass::ConstantFolding>();
-        passes.register_pass<pass::DynElimination>();
-        passes.register_pass<pass::Opset0Downgrade>(); // Converts dynamic v1 variants to v0 ops
-        passes.set_per_pass_validation(false);
-
-        // FIXME(amprocte): Vile, temporary hack: we need to do repeated rounds of
-        // ConstantFolding/DynElimination until everything that DynElimination is supposed to
-        // eliminate has actually been eliminated. We could do this by monitoring the return values
-        // of the passes (keep iterating until both CF and DE report no changes), but that did not
-        // seem to work so here we are. Probably a better fix is to somehow combine the matchers in
-        // CF
-        // and DE into one pass.
-        size_t num_dyn_nodes_last_pass = std::numeric_limits<size_t>::max();
-
-        while (num_dyn_nodes_last_pass != 0)
+        if (auto dynamic_tensor =
+                std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
         {
-            passes.run_passes(clone);
-            auto num_dyn_nodes_this_pass = count_dyn_nodes(clone);
-
-            NGRAPH_CHECK(num_dyn_nodes_this_pass < num_dyn_nodes_last_pass,
-                         "Could not eliminate all Dyn nodes (",
-                         num_dyn_nodes_this_pass,
-                         " remaining)");
-
-            num_dyn_nodes_last_pass = num_dyn_nodes_this_pass;
+            dynamic_tensor->make_storage(et, shape);
+            wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
         }
+        else
+        {
+            wrapped_outputs.push_back(outputs[i]);
+        }
+    }
 
-        pass::Manager pass_val;
-        pass_val.register_pass<pass::Validate>();
-        pass_val.run_passes(clone);
-
-        std::vector<std::shared_ptr<runtime::Tensor>> wrapped_outputs;
+    if (!padded)
+    {
+        return compiled_executable->call(wrapped_outputs, wrapped_inputs);
+    }
 
-        const ResultVector& results = clone->get_results();
-        for (auto& result : results)
+    std::vector<std::shared_ptr<runtime::Tensor>> call_outputs = wrapped_outputs;
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (padded_outputs[i])
         {
-            NGRAPH_CHECK(result->get_output_partial_shape(0).is_static(),
-                         "Shape staticization failed for result node ",
-                         *result);
+            call_outputs[i] = padded_outputs[i];
         }
-        NGRAPH_CHECK(results.size() == outputs.size());
-
-        for (size_t i = 0; i < outputs.size(); i++)
+    }
+    bool rc = compiled_executable->call(call_outputs, wrapped_inputs);
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (padded_outputs[i])
         {
-            if (auto dynamic_tensor =
-                    std::dynamic_pointer_cast<runtime::dynamic::DynamicTensor>(outputs[i]))
-            {
-                dynamic_tensor->make_storage(results[i]->get_output_element_type(0),
-                                             results[i]->get_output_shape(0));
-                wrapped_outputs.push_back(dynamic_tensor->get_wrapped_tensor());
-            }
-            else
-            {
-                wrapped_outputs.push_back(outputs[i]);
-            }
+            const Shape& shape = wrapped_outputs[i]->get_shape();
+            std::vector<char> src(padded_outputs[i]->get_size_in_bytes());
+            padded_outputs[i]->read(src.data(), src.size());
+            std::vector<char> dst(wrapped_outputs[i]->get_size_in_bytes());
+            copy_corner(src.data(),
+                        padded_outputs[i]->get_shape(),
+                        dst.data(),
+                        shape,
+                        shape,
+                        padded_outputs[i]->get_element_type().size());
+            wrapped_outputs[i]->write(dst.data(), dst.size());
         }
-
-        auto compiled_executable =
-            m_wrapped_backend->compile(clone, m_enable_performance_collection);
-        // Put compiled executable in the cache.
-        m_lru->add_entry(merged_input_shapes, compiled_executable, clone);
-        auto result = compiled_executable->call(wrapped_outputs, wrapped_inputs);
-
-        return result;
     }
+    return rc;
 }
 
 runtime::dynamic::DynamicTensor::DynamicTensor(
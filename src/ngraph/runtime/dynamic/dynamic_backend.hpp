@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ngraph/runtime/backend.hpp"
@@ -89,21 +92,83 @@ private:
 ///
 /// `DynamicExecutable` objects are produced by `DynamicBackend::compile()`.
 ///
+/// To bound the number of compilations, dynamic dimensions may be rounded up to
+/// shape buckets (see `set_shape_buckets`), and expected shapes may be compiled
+/// ahead of time in the background (see `precompile`).
+///
 class ngraph::runtime::dynamic::DynamicExecutable : public ngraph::runtime::Executable
 {
 public:
+    struct CacheStatistics
+    {
+        size_t m_hits = 0;
+        size_t m_misses = 0;
+        /// Total time spent specializing and compiling on cache misses
+        size_t m_compile_microseconds = 0;
+    };
+
     DynamicExecutable(std::shared_ptr<Function> wrapped_function,
                       std::shared_ptr<ngraph::runtime::Backend> wrapped_backend,
                       bool enable_performance_collection = false);
     virtual bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) override;
 
+    /// \brief Round each dynamic dimension of the inputs that are not relevant to shapes
+    ///        up to the smallest bucket that holds it. Such inputs are zero-padded to the
+    ///        bucketed shape and each output is sliced back to its unpadded shape.
+    ///        Dimensions beyond the largest bucket are not rounded.
+    ///
+    ///        Elementwise ops without autobroadcast, transposes, and the Sum, Product, Max,
+    ///        Min, Dot and Softmax ops can be bucketed. When one of the latter combines
+    ///        elements across a padded axis and the padding is not already zero where that
+    ///        is enough, the compiled function takes a boolean mask of the valid positions of
+    ///        each bucketed dimension as an extra input and selects the value the op ignores,
+    ///        e.g. the lowest value for Max and Softmax, into the padding. Functions with
+    ///        other ops on padded tensors throw, as do bucketed inputs of dynamic rank.
+    /// \param buckets The bucket sizes, e.g. {16, 32, 64, 128}
+    void set_shape_buckets(const std::vector<size_t>& buckets);
+
+    /// \brief Set the maximum number of compiled executables kept in the cache.
+    void set_cache_capacity(size_t capacity);
+
+    /// \brief Set the maximum estimated size of the cached executables, evicting the least
+    ///        recently used ones beyond it. 0, the default, means no limit. See
+    ///        LRUCache::set_cache_size_bytes.
+    void set_cache_capacity_bytes(size_t capacity_bytes);
+
+    CacheStatistics get_cache_statistics() const;
+
+    /// \brief Compile for the given (bucketed) input shapes in the background so that
+    ///        later calls with those shapes hit the cache. Not supported for functions
+    ///        with inputs that are relevant to shapes. The executable must outlive the
+    ///        returned future.
+    std::future<void> precompile(const std::vector<Shape>& input_shapes);
+
 private:
+    Shape get_bucketed_shape(size_t input_index, const Shape& shape) const;
+    std::shared_ptr<Function> add_padding_masks(const std::shared_ptr<Function>& clone,
+                                                const std::vector<PartialShape>& arg_shapes);
+    std::shared_ptr<runtime::Tensor> pad_input(const std::shared_ptr<runtime::Tensor>& input,
+                                               const Shape& bucketed_shape);
+    std::shared_ptr<runtime::Executable>
+        compile_specialized(const std::vector<element::Type>& arg_element_types,
+                            const std::vector<PartialShape>& arg_shapes,
+                            const std::vector<void*>& arg_value_base_pointers,
+                            std::shared_ptr<Function>& clone);
+
     std::shared_ptr<ngraph::Function> m_wrapped_function;
     std::shared_ptr<ngraph::runtime::Backend> m_wrapped_backend;
     std::shared_ptr<ngraph::runtime::LRUCache> m_lru =
         std::make_shared<ngraph::runtime::LRUCache>();
     bool m_enable_performance_collection;
+    std::vector<size_t> m_shape_buckets;
+    // The dimensions rounded up to buckets, as (parameter index, axis)
+    std::vector<std::pair<size_t, size_t>> m_bucketed_dims;
+    // For each result, the index in m_bucketed_dims of the dimension each axis is padded
+    // along, or -1 for none. Empty for results without padding.
+    std::vector<std::vector<int64_t>> m_result_dims;
+    mutable std::mutex m_stats_mutex;
+    CacheStatistics m_stats;
 };
 
 ///
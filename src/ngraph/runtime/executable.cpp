@@ -39,6 +39,35 @@ bool runtime::Executable::call_with_validate(const vector<shared_ptr<runtime::Te
     return call(outputs, inputs);
 }
 
+future<bool> runtime::Executable::call_async(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                            const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    auto result = make_shared<promise<bool>>();
+    future<bool> future_result = result->get_future();
+
+    // Each call waits for the previous one so that iterations complete in order
+    lock_guard<mutex> guard(m_async_mutex);
+    shared_future<void> previous = m_last_async_call;
+    auto task = [this, outputs, inputs, previous, result]() mutable {
+        if (previous.valid())
+        {
+            previous.wait();
+            // Don't keep the whole chain of earlier calls alive
+            previous = shared_future<void>();
+        }
+        try
+        {
+            result->set_value(call(outputs, inputs));
+        }
+        catch (...)
+        {
+            result->set_exception(current_exception());
+        }
+    };
+    m_last_async_call = async(launch::async, task).share();
+    return future_result;
+}
+
 void runtime::Executable::validate(const vector<std::shared_ptr<runtime::Tensor>>& outputs,
                                    const vector<std::shared_ptr<runtime::Tensor>>& inputs)
 {
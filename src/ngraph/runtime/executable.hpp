@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
+#include <mutex>
 
 #include "ngraph/function.hpp"
 #include "ngraph/runtime/performance_counter.hpp"
@@ -44,6 +46,19 @@ public:
     virtual bool call(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
                       const std::vector<std::shared_ptr<runtime::Tensor>>& inputs) = 0;
 
+    /// \brief Starts a single iteration of a Function without waiting for it to complete.
+    ///    Iterations started with call_async execute in the order they were started, so a
+    ///    caller can fill the inputs of the next pipeline stage (see create_input_tensor) and
+    ///    read the outputs of the previous stage while this one runs. The tensors must not be
+    ///    accessed until the returned future is ready unless the backend's tensors block in
+    ///    wait_for_write_ready and wait_for_read_ready. The Executable must outlive the call.
+    /// \param outputs vector of runtime::Tensor used as outputs
+    /// \param inputs vector of runtime::Tensor used as inputs
+    /// \returns A future holding the value returned by call
+    virtual std::future<bool>
+        call_async(const std::vector<std::shared_ptr<runtime::Tensor>>& outputs,
+                   const std::vector<std::shared_ptr<runtime::Tensor>>& inputs);
+
     /// \brief Executes a single iteration of a Function.
     /// \param outputs vector of runtime::Tensor used as outputs
     /// \param inputs vector of runtime::Tensor used as inputs
@@ -159,4 +174,8 @@ protected:
 
     ngraph::ParameterVector m_parameters;
     ngraph::ResultVector m_results;
+
+private:
+    std::mutex m_async_mutex;
+    std::shared_future<void> m_last_async_call;
 };
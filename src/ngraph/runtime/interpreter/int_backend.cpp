@@ -61,7 +61,8 @@ shared_ptr<runtime::Executable>
     runtime::interpreter::INTBackend::compile(shared_ptr<Function> function,
                                               bool enable_performance_collection)
 {
-    return make_shared<INTExecutable>(function, enable_performance_collection);
+    return make_shared<INTExecutable>(
+        function, enable_performance_collection, m_constant_registry);
 }
 
 bool runtime::interpreter::INTBackend::is_supported(const Node& node) const
@@ -73,28 +74,19 @@ std::shared_ptr<runtime::Executable> runtime::interpreter::INTBackend::load(istr
 {
     shared_ptr<Executable> exec;
     cpio::Reader reader(in);
-    auto file_info = reader.get_file_info();
     string save_info;
-    for (const cpio::FileInfo& info : file_info)
+    if (const cpio::FileInfo* info = reader.find("save_info"))
     {
-        if (info.get_name() == "save_info")
-        {
-            vector<char> buffer = reader.read(info);
-            save_info = string(buffer.data(), buffer.size());
-            break;
-        }
+        vector<char> buffer = reader.read(*info);
+        save_info = string(buffer.data(), buffer.size());
     }
-    if (save_info == "INTERPRETER Save File 1.0")
+    // 1.0 saves hold a json model, 1.1 saves a binary one. deserialize tells them apart.
+    if (save_info == "INTERPRETER Save File 1.0" || save_info == "INTERPRETER Save File 1.1")
     {
-        for (const cpio::FileInfo& info : file_info)
+        if (const cpio::FileInfo* info = reader.find("model"))
         {
-            if (info.get_name() == "model")
-            {
-                vector<char> buffer = reader.read(info);
-                string model_string = string(buffer.data(), buffer.size());
-                exec = shared_ptr<INTExecutable>(new INTExecutable(model_string));
-                break;
-            }
+            vector<char> buffer = reader.read(*info);
+            exec = shared_ptr<INTExecutable>(new INTExecutable(buffer.data(), buffer.size()));
         }
     }
     return exec;
@@ -24,6 +24,7 @@
 
 #include "ngraph/runtime/interpreter/int_backend_visibility.hpp"
 
+#include "ngraph/pass/cse.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/runtime/tensor.hpp"
 
@@ -64,4 +65,7 @@ public:
 
 private:
     std::set<std::string> m_unsupported_op_name_list;
+    // Constant data shared by every function this backend compiles
+    std::shared_ptr<pass::ConstantRegistry> m_constant_registry =
+        std::make_shared<pass::ConstantRegistry>();
 };
@@ -18,15 +18,20 @@
 #include "ngraph/chrome_trace.hpp"
 #include "ngraph/cpio.hpp"
 #include "ngraph/descriptor/layout/dense_tensor_layout.hpp"
+#include "ngraph/env_util.hpp"
 #include "ngraph/except.hpp"
 #include "ngraph/ops.hpp"
 #include "ngraph/pass/assign_layout.hpp"
 #include "ngraph/pass/core_fusion.hpp"
+#include "ngraph/pass/cse.hpp"
 #include "ngraph/pass/fused_op_decomposition.hpp"
 #include "ngraph/pass/like_replacement.hpp"
 #include "ngraph/pass/liveness.hpp"
 #include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/memory_aware_scheduling.hpp"
+#include "ngraph/pass/memory_layout.hpp"
 #include "ngraph/pass/opset0_downgrade.hpp"
+#include "ngraph/pass/rematerialization.hpp"
 #include "ngraph/runtime/backend_manager.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
@@ -58,8 +63,10 @@ runtime::interpreter::OP_TYPEID runtime::interpreter::INTExecutable::get_typeid(
     return rc;
 }
 
-runtime::interpreter::INTExecutable::INTExecutable(const shared_ptr<Function>& function,
-                                                   bool enable_performance_collection)
+runtime::interpreter::INTExecutable::INTExecutable(
+    const shared_ptr<Function>& function,
+    bool enable_performance_collection,
+    const shared_ptr<pass::ConstantRegistry>& constant_registry)
     : m_is_compiled{true}
     , m_performance_counters_enabled{enable_performance_collection}
 {
@@ -76,148 +83,344 @@ runtime::interpreter::INTExecutable::INTExecutable(const shared_ptr<Function>& f
     pass_manager.register_pass<pass::Opset0Downgrade>();
     // Need to decompose any v0 fused ops, which were produced by the downgrade pass
     pass_manager.register_pass<pass::FusedOpDecomposition>();
+    pass_manager.register_pass<pass::StructuralCSE>(constant_registry);
     pass_manager.register_pass<pass::AssignLayout<DenseTensorLayout>>();
-    pass_manager.register_pass<pass::Liveness>();
     pass_manager.run_passes(m_function);
     for (auto node : m_function->get_ordered_ops())
     {
         m_nodes.push_back(node);
     }
     set_parameters_and_results(*m_function);
+    build_plan();
 }
 
-runtime::interpreter::INTExecutable::INTExecutable(const std::string& model_string)
+runtime::interpreter::INTExecutable::INTExecutable(const char* model_data, size_t model_size)
     : m_is_compiled{true}
     , m_performance_counters_enabled{false}
 {
-    m_function = deserialize(model_string);
+    m_function = deserialize(model_data, model_size);
     for (auto node : m_function->get_ordered_ops())
     {
         m_nodes.push_back(node);
     }
     set_parameters_and_results(*m_function);
+    build_plan();
 }
 
-bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
-                                               const vector<shared_ptr<runtime::Tensor>>& inputs)
+element::Type runtime::interpreter::INTExecutable::get_kernel_type(const Node& op)
 {
-    runtime::event::Duration d1("call", "Interpreter");
+    element::Type type;
+    if (is_type<op::Convert>(&op) || is_type<op::Quantize>(&op) || is_type<op::Dequantize>(&op) ||
+        is_type<op::ArgMin>(&op) || is_type<op::ArgMax>(&op))
+    {
+        type = op.get_input_element_type(0);
+    }
+    else if (is_type<op::Equal>(&op) || is_type<op::Greater>(&op) || is_type<op::GreaterEq>(&op) ||
+             is_type<op::Less>(&op) || is_type<op::LessEq>(&op) || is_type<op::NotEqual>(&op))
+    {
+        // Get the type of the second input, not the first
+        // All BinaryElementwiseComparision ops have the same type for inputs
+        // Select has bool for first input and the type we are interested in for the second
+        type = op.get_input_element_type(1);
+    }
+    else if (is_type<op::TopK>(&op))
+    {
+        type = op.get_output_element_type(1);
+    }
+    else
+    {
+        type = op.get_output_element_type(0);
+    }
+    return type;
+}
 
-    // convert inputs to HostTensor
-    vector<shared_ptr<HostTensor>> func_inputs;
-    for (auto tensor : inputs)
+runtime::interpreter::INTExecutable::Kernel
+    runtime::interpreter::INTExecutable::get_kernel(const element::Type& type)
+{
+    Kernel kernel = nullptr;
+    switch (type)
     {
-        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
-        func_inputs.push_back(host_tensor);
+    case element::Type_t::boolean: kernel = &INTExecutable::op_engine<char>; break;
+    case element::Type_t::f32: kernel = &INTExecutable::op_engine<float>; break;
+    case element::Type_t::f64: kernel = &INTExecutable::op_engine<double>; break;
+    case element::Type_t::i8: kernel = &INTExecutable::op_engine<int8_t>; break;
+    case element::Type_t::i16: kernel = &INTExecutable::op_engine<int16_t>; break;
+    case element::Type_t::i32: kernel = &INTExecutable::op_engine<int32_t>; break;
+    case element::Type_t::i64: kernel = &INTExecutable::op_engine<int64_t>; break;
+    case element::Type_t::u8: kernel = &INTExecutable::op_engine<uint8_t>; break;
+    case element::Type_t::u16: kernel = &INTExecutable::op_engine<uint16_t>; break;
+    case element::Type_t::u32: kernel = &INTExecutable::op_engine<uint32_t>; break;
+    case element::Type_t::u64: kernel = &INTExecutable::op_engine<uint64_t>; break;
+    case element::Type_t::undefined:
+    case element::Type_t::dynamic:
+    case element::Type_t::u1:
+    case element::Type_t::bf16:
+    case element::Type_t::f16: break;
     }
-    if (m_nan_check_enabled)
+    return kernel;
+}
+
+void runtime::interpreter::INTExecutable::build_plan()
+{
+    // Intermediates can only be laid out when all of their shapes are known
+    for (auto op : m_nodes)
     {
-        perform_nan_check(func_inputs);
+        for (size_t i = 0; i < op->get_output_size(); ++i)
+        {
+            if (op->get_output_partial_shape(i).is_dynamic() ||
+                op->get_output_element_type(i).is_dynamic())
+            {
+                return;
+            }
+        }
     }
 
-    // convert outputs to HostTensor
-    vector<shared_ptr<HostTensor>> func_outputs;
-    for (auto tensor : outputs)
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::MemoryAwareScheduling>();
+    int32_t budget_mb = getenv_int("NGRAPH_REMATERIALIZATION_BUDGET_MB");
+    if (budget_mb >= 0)
     {
-        auto host_tensor = static_pointer_cast<runtime::HostTensor>(tensor);
-        func_outputs.push_back(host_tensor);
+        pass_manager.register_pass<pass::Rematerialization>(static_cast<size_t>(budget_mb)
+                                                            << 20);
     }
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(get_alignment());
+    pass_manager.run_passes(m_function);
+    m_nodes = m_function->get_ordered_ops();
 
-    // map function params -> HostTensor
-    unordered_map<descriptor::Tensor*, shared_ptr<HostTensor>> tensor_map;
-    size_t input_count = 0;
+    unordered_map<descriptor::Tensor*, size_t> slot_map;
+    size_t next_slot = 0;
     for (auto param : get_parameters())
     {
         for (size_t i = 0; i < param->get_output_size(); ++i)
         {
-            descriptor::Tensor* tensor = &param->output(i).get_tensor();
-            tensor_map.insert({tensor, func_inputs[input_count++]});
+            // A parameter listed more than once is read through the slot of its first position
+            slot_map.insert({&param->output(i).get_tensor(), next_slot++});
         }
     }
-
-    // map function outputs -> HostTensor
-    for (size_t output_count = 0; output_count < get_results().size(); ++output_count)
+    for (auto result : get_results())
     {
-        auto output = get_results()[output_count];
-        if (!is_type<op::Result>(output))
+        if (!is_type<op::Result>(result))
         {
             throw ngraph_error("One of function's outputs isn't op::Result");
         }
-        descriptor::Tensor* tensor = &output->output(0).get_tensor();
-        tensor_map.insert({tensor, func_outputs[output_count]});
+        slot_map.insert({&result->output(0).get_tensor(), next_slot++});
     }
+    m_num_external_slots = next_slot;
 
-    // for each ordered op in the graph
     for (auto op : m_nodes)
     {
-        runtime::event::Duration d2(op->description(), "Interpreter");
         if (op->is_parameter())
         {
             continue;
         }
-
-        // get op inputs from map
-        vector<shared_ptr<HostTensor>> op_inputs;
+        PlanStep step;
+        step.m_node = op;
+        step.m_type = get_kernel_type(*op);
+        step.m_kernel = get_kernel(step.m_type);
+        step.m_precomputed = false;
         for (auto input : op->inputs())
         {
-            descriptor::Tensor* tensor = &input.get_tensor();
-            op_inputs.push_back(tensor_map.at(tensor));
+            step.m_input_slots.push_back(slot_map.at(&input.get_tensor()));
         }
-
-        // get op outputs from map or create
-        vector<shared_ptr<HostTensor>> op_outputs;
         for (size_t i = 0; i < op->get_output_size(); ++i)
         {
             descriptor::Tensor* tensor = &op->output(i).get_tensor();
-            shared_ptr<HostTensor> host_tensor;
-            auto it = tensor_map.find(tensor);
-            if (it == tensor_map.end())
+            auto it = slot_map.find(tensor);
+            if (it == slot_map.end())
             {
-                const Shape& shape = op->get_output_shape(i);
-                const element::Type& type = op->get_output_element_type(i);
-                string name = op->output(i).get_tensor().get_name();
-                host_tensor = make_shared<runtime::HostTensor>(type, shape, name);
-                tensor_map.insert({tensor, host_tensor});
+                it = slot_map.insert({tensor, next_slot++}).first;
+            }
+            step.m_output_slots.push_back(it->second);
+        }
+
+        // Constants never change, so evaluate them once here instead of copying on every call
+        if (op->is_constant() && step.m_kernel)
+        {
+            shared_ptr<runtime::HostTensor> tensor;
+            if (auto constant = as_type_ptr<op::Constant>(op))
+            {
+                // Read the constant's own data, which may be shared with other executables
+                tensor = make_shared<runtime::HostTensor>(
+                    constant->get_element_type(),
+                    constant->get_shape(),
+                    const_cast<void*>(constant->get_data_ptr()),
+                    op->get_name());
             }
             else
             {
-                host_tensor = it->second;
+                tensor = make_shared<runtime::HostTensor>(
+                    op->get_output_element_type(0), op->get_output_shape(0), op->get_name());
+                (this->*step.m_kernel)(*op, {tensor}, {});
             }
-            op_outputs.push_back(host_tensor);
+            m_constant_tensors.push_back({step.m_output_slots[0], tensor});
+            step.m_precomputed = true;
         }
+        m_plan.push_back(step);
+    }
+    m_num_slots = next_slot;
+    m_plan_built = true;
+}
+
+unique_ptr<runtime::interpreter::INTExecutable::ExecutionFrame>
+    runtime::interpreter::INTExecutable::acquire_frame()
+{
+    {
+        lock_guard<mutex> guard(m_frame_mutex);
+        if (!m_free_frames.empty())
+        {
+            unique_ptr<ExecutionFrame> frame = move(m_free_frames.back());
+            m_free_frames.pop_back();
+            return frame;
+        }
+    }
 
-        // get op type
-        element::Type type;
-        if (is_type<op::Convert>(op) || is_type<op::Quantize>(op) || is_type<op::Dequantize>(op) ||
-            is_type<op::ArgMin>(op) || is_type<op::ArgMax>(op))
+    // Every concurrent call needs its own frame
+    unique_ptr<ExecutionFrame> frame(new ExecutionFrame());
+    frame->m_pool = AlignedBuffer(m_function->get_temporary_pool_size(), get_alignment());
+    frame->m_tensors.resize(m_num_slots);
+    char* pool = frame->m_pool.get_ptr<char>();
+    for (const PlanStep& step : m_plan)
+    {
+        for (size_t i = 0; i < step.m_output_slots.size(); ++i)
+        {
+            size_t slot = step.m_output_slots[i];
+            if (slot < m_num_external_slots || step.m_node->is_constant())
+            {
+                continue;
+            }
+            const descriptor::Tensor& tensor = step.m_node->output(i).get_tensor();
+            frame->m_tensors[slot] = make_shared<runtime::HostTensor>(
+                tensor.get_element_type(),
+                tensor.get_shape(),
+                pool + tensor.get_pool_offset(),
+                tensor.get_name());
+        }
+    }
+    for (auto& constant : m_constant_tensors)
+    {
+        frame->m_tensors[constant.first] = constant.second;
+    }
+    // Constants that could not be precomputed are evaluated on every call
+    for (const PlanStep& step : m_plan)
+    {
+        if (step.m_node->is_constant() && !step.m_precomputed)
+        {
+            const descriptor::Tensor& tensor = step.m_node->output(0).get_tensor();
+            frame->m_tensors[step.m_output_slots[0]] = make_shared<runtime::HostTensor>(
+                tensor.get_element_type(), tensor.get_shape(), tensor.get_name());
+        }
+    }
+    frame->m_step_inputs.resize(m_plan.size());
+    frame->m_step_outputs.resize(m_plan.size());
+    for (size_t i = 0; i < m_plan.size(); ++i)
+    {
+        for (size_t slot : m_plan[i].m_input_slots)
         {
-            type = op->get_input_element_type(0);
+            frame->m_step_inputs[i].push_back(frame->m_tensors[slot]);
         }
-        else if (is_type<op::Equal>(op) || is_type<op::Greater>(op) || is_type<op::GreaterEq>(op) ||
-                 is_type<op::Less>(op) || is_type<op::LessEq>(op) || is_type<op::NotEqual>(op))
+        for (size_t slot : m_plan[i].m_output_slots)
         {
-            // Get the type of the second input, not the first
-            // All BinaryElementwiseComparision ops have the same type for inputs
-            // Select has bool for first input and the type we are interested in for the second
-            type = op->get_input_element_type(1);
+            frame->m_step_outputs[i].push_back(frame->m_tensors[slot]);
         }
-        else if (is_type<op::TopK>(op))
+    }
+    return frame;
+}
+
+void runtime::interpreter::INTExecutable::release_frame(unique_ptr<ExecutionFrame> frame)
+{
+    // Drop the references to the caller's tensors before pooling the frame
+    for (size_t i = 0; i < m_plan.size(); ++i)
+    {
+        const PlanStep& step = m_plan[i];
+        for (size_t j = 0; j < step.m_input_slots.size(); ++j)
         {
-            type = op->get_output_element_type(1);
+            if (step.m_input_slots[j] < m_num_external_slots)
+            {
+                frame->m_step_inputs[i][j] = nullptr;
+            }
         }
-        else
+        for (size_t j = 0; j < step.m_output_slots.size(); ++j)
         {
-            type = op->get_output_element_type(0);
+            if (step.m_output_slots[j] < m_num_external_slots)
+            {
+                frame->m_step_outputs[i][j] = nullptr;
+            }
         }
+    }
+    lock_guard<mutex> guard(m_frame_mutex);
+    m_free_frames.push_back(move(frame));
+}
+
+bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::Tensor>>& outputs,
+                                               const vector<shared_ptr<runtime::Tensor>>& inputs)
+{
+    runtime::event::Duration d1("call", "Interpreter");
+
+    NGRAPH_CHECK(m_plan_built, "Interpreter cannot execute a function with dynamic shapes");
+    NGRAPH_CHECK(inputs.size() + outputs.size() == m_num_external_slots,
+                 "Interpreter called with the wrong number of tensors");
+
+    unique_ptr<ExecutionFrame> frame = acquire_frame();
 
-        if (m_performance_counters_enabled)
+    // map function params and outputs -> HostTensor
+    vector<shared_ptr<HostTensor>>& tensors = frame->m_tensors;
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        tensors[i] = static_pointer_cast<runtime::HostTensor>(inputs[i]);
+    }
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        tensors[inputs.size() + i] = static_pointer_cast<runtime::HostTensor>(outputs[i]);
+    }
+    if (m_nan_check_enabled)
+    {
+        perform_nan_check(vector<shared_ptr<HostTensor>>(tensors.begin(),
+                                                         tensors.begin() + inputs.size()));
+    }
+
+    // for each step of the plan
+    for (size_t i = 0; i < m_plan.size(); ++i)
+    {
+        const PlanStep& step = m_plan[i];
+        const shared_ptr<Node>& op = step.m_node;
+        runtime::event::Duration d2(op->description(), "Interpreter");
+
+        vector<shared_ptr<HostTensor>>& op_inputs = frame->m_step_inputs[i];
+        vector<shared_ptr<HostTensor>>& op_outputs = frame->m_step_outputs[i];
+        for (size_t j = 0; j < step.m_input_slots.size(); ++j)
         {
-            m_timer_map[op].start();
+            if (step.m_input_slots[j] < m_num_external_slots)
+            {
+                op_inputs[j] = tensors[step.m_input_slots[j]];
+            }
         }
-        generate_calls(type, *op.get(), op_outputs, op_inputs);
-        if (m_performance_counters_enabled)
+        for (size_t j = 0; j < step.m_output_slots.size(); ++j)
         {
-            m_timer_map[op].stop();
+            if (step.m_output_slots[j] < m_num_external_slots)
+            {
+                op_outputs[j] = tensors[step.m_output_slots[j]];
+            }
+        }
+
+        if (!step.m_precomputed)
+        {
+            if (m_performance_counters_enabled)
+            {
+                m_timer_map[op].start();
+            }
+            if (step.m_kernel)
+            {
+                (this->*step.m_kernel)(*op, op_outputs, op_inputs);
+            }
+            else
+            {
+                generate_calls(step.m_type, *op, op_outputs, op_inputs);
+            }
+            if (m_performance_counters_enabled)
+            {
+                m_timer_map[op].stop();
+            }
         }
         if (m_nan_check_enabled)
         {
@@ -225,6 +428,12 @@ bool runtime::interpreter::INTExecutable::call(const vector<shared_ptr<runtime::
         }
     }
 
+    for (size_t i = 0; i < m_num_external_slots; ++i)
+    {
+        tensors[i] = nullptr;
+    }
+    release_frame(move(frame));
+
     return true;
 }
 
@@ -324,11 +533,12 @@ void runtime::interpreter::INTExecutable::perform_nan_check(
 
 void runtime::interpreter::INTExecutable::save(ostream& out)
 {
-    cpio::Writer writer(out);
-    string si = "INTERPRETER Save File 1.0";
+    cpio::Writer writer(out, cpio::Version::V2);
+    string si = "INTERPRETER Save File 1.1";
     writer.write("save_info", si.data(), si.size());
-    string model = serialize(m_function, 0);
-    writer.write("model", model.data(), model.size());
+    // Stream the model into the archive so large Constants are not staged in memory
+    serialize_binary(writer.begin("model"), m_function);
+    writer.end();
 }
 
 shared_ptr<ngraph::op::Parameter>
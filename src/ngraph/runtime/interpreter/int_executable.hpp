@@ -19,11 +19,13 @@
 #include <initializer_list>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include "ngraph/ops.hpp"
+#include "ngraph/pass/cse.hpp"
 #include "ngraph/runtime/aligned_buffer.hpp"
 #include "ngraph/runtime/backend.hpp"
 #include "ngraph/runtime/host_tensor.hpp"
@@ -149,8 +151,11 @@ class ngraph::runtime::interpreter::INTExecutable : public Executable
     friend class INTBackend;
 
 public:
+    /// \param constant_registry If given, the constant data of the function is shared with
+    ///        every other function compiled against the same registry
     INTExecutable(const std::shared_ptr<Function>& function,
-                  bool enable_performance_collection = false);
+                  bool enable_performance_collection = false,
+                  const std::shared_ptr<pass::ConstantRegistry>& constant_registry = nullptr);
 
     bool call(const std::vector<std::shared_ptr<Tensor>>& outputs,
               const std::vector<std::shared_ptr<Tensor>>& inputs) override;
@@ -172,7 +177,7 @@ public:
         create_output_tensor(size_t output_index, size_t pipeline_depth) override;
 
 protected:
-    INTExecutable(const std::string& model_string);
+    INTExecutable(const char* model_data, size_t model_size);
 
     std::shared_ptr<ngraph::op::Parameter> get_parameter(size_t index) const;
     std::shared_ptr<ngraph::op::Result> get_result(size_t index) const;
@@ -188,6 +193,48 @@ protected:
 
     static OP_TYPEID get_typeid(const Node& node);
 
+    using Kernel = void (INTExecutable::*)(const Node& node,
+                                           const std::vector<std::shared_ptr<HostTensor>>& out,
+                                           const std::vector<std::shared_ptr<HostTensor>>& args);
+
+    /// \brief One op of the execution plan with its kernel and tensor slots resolved.
+    struct PlanStep
+    {
+        std::shared_ptr<Node> m_node;
+        element::Type m_type;
+        /// op_engine instantiation for m_type, or nullptr to dispatch through generate_calls
+        Kernel m_kernel;
+        std::vector<size_t> m_input_slots;
+        std::vector<size_t> m_output_slots;
+        /// Constant whose output was filled when the plan was built
+        bool m_precomputed;
+    };
+
+    /// \brief The tensors for one in-flight call. Intermediates live in m_pool at the
+    ///        offsets assigned by pass::MemoryLayout. Frames are reused across calls.
+    struct ExecutionFrame
+    {
+        AlignedBuffer m_pool;
+        std::vector<std::shared_ptr<HostTensor>> m_tensors;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> m_step_inputs;
+        std::vector<std::vector<std::shared_ptr<HostTensor>>> m_step_outputs;
+    };
+
+    void build_plan();
+    std::unique_ptr<ExecutionFrame> acquire_frame();
+    void release_frame(std::unique_ptr<ExecutionFrame> frame);
+    static element::Type get_kernel_type(const Node& op);
+    static Kernel get_kernel(const element::Type& type);
+
+    bool m_plan_built = false;
+    std::vector<PlanStep> m_plan;
+    // Slots [0, m_num_external_slots) are the function's parameters followed by its results
+    size_t m_num_external_slots = 0;
+    size_t m_num_slots = 0;
+    std::vector<std::pair<size_t, std::shared_ptr<HostTensor>>> m_constant_tensors;
+    std::mutex m_frame_mutex;
+    std::vector<std::unique_ptr<ExecutionFrame>> m_free_frames;
+
     static void perform_nan_check(const std::vector<std::shared_ptr<HostTensor>>&,
                                   const Node* op = nullptr);
 
@@ -0,0 +1,80 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ngraph/except.hpp"
+#include "ngraph/runtime/mapped_file.hpp"
+
+using namespace ngraph;
+using namespace std;
+
+#ifndef _WIN32
+runtime::MappedFile::MappedFile(const string& path)
+    : m_data(nullptr)
+    , m_size(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw ngraph_error("Unable to open '" + path + "' for mapping");
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        throw ngraph_error("Unable to stat '" + path + "'");
+    }
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size > 0)
+    {
+        // MAP_PRIVATE keeps the pages shared with the page cache until something writes to them
+        void* data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            throw ngraph_error("Unable to map '" + path + "'");
+        }
+        m_data = static_cast<char*>(data);
+    }
+    // The mapping holds its own reference to the file
+    close(fd);
+}
+
+runtime::MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+    {
+        munmap(m_data, m_size);
+    }
+}
+#else
+runtime::MappedFile::MappedFile(const string& path)
+    : m_data(nullptr)
+    , m_size(0)
+{
+    throw ngraph_error("MappedFile is not supported on this platform");
+}
+
+runtime::MappedFile::~MappedFile()
+{
+}
+#endif
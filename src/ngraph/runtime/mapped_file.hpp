@@ -0,0 +1,51 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ngraph/ngraph_visibility.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        class MappedFile;
+    }
+}
+
+/// \brief Maps a file into memory copy-on-write. Pages are read from the file on first touch
+/// and, until written, share physical memory with every other process mapping the same file.
+class NGRAPH_API ngraph::runtime::MappedFile
+{
+public:
+    /// \brief Maps the whole of the file at path
+    /// \param path The file to map
+    MappedFile(const std::string& path);
+    ~MappedFile();
+
+    char* get_ptr() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    char* m_data;
+    size_t m_size;
+};
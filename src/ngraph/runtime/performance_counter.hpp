@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 #include "ngraph/node.hpp"
@@ -41,9 +42,32 @@ namespace ngraph
                 return m_call_count == 0 ? 0 : m_total_microseconds / m_call_count;
             }
             size_t call_count() const { return m_call_count; }
+            /// Hardware counters summed over all calls. Zero unless the backend collects them.
+            uint64_t cycles() const { return m_cycles; }
+            uint64_t instructions() const { return m_instructions; }
+            uint64_t llc_misses() const { return m_llc_misses; }
+            /// Last-level cache misses times the cache line size. This is the traffic that
+            /// missed the caches, not the total memory traffic of the op.
+            uint64_t bytes() const { return m_bytes; }
+            /// Instructions retired per byte of bytes(). Instructions are not FLOPs, so this
+            /// only approximates arithmetic intensity.
+            double instructions_per_byte() const
+            {
+                return m_bytes == 0 ? 0 : static_cast<double>(m_instructions) / m_bytes;
+            }
+            double gigabytes_per_second() const
+            {
+                return m_total_microseconds == 0
+                           ? 0
+                           : static_cast<double>(m_bytes) / (m_total_microseconds * 1000.0);
+            }
             std::shared_ptr<const Node> m_node;
             size_t m_total_microseconds;
             size_t m_call_count;
+            uint64_t m_cycles = 0;
+            uint64_t m_instructions = 0;
+            uint64_t m_llc_misses = 0;
+            uint64_t m_bytes = 0;
         };
     }
 }
@@ -24,6 +24,7 @@
 
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/shape.hpp"
 
 namespace ngraph
@@ -121,6 +122,58 @@ namespace ngraph
                 }
             }
 
+            namespace fast
+            {
+                template <typename T>
+                bool avg_pool(const T* arg,
+                              T* out,
+                              const Shape& arg_shape,
+                              const Shape& out_shape,
+                              const Shape& window_shape,
+                              const Strides& window_movement_strides,
+                              const Shape& padding_below,
+                              const Shape& padding_above,
+                              bool include_padding_in_avg_computation)
+                {
+                    // The generic kernel restores the caller's rounding mode after the first
+                    // output, so only the default mode gives the same results everywhere.
+                    PoolingPlan plan(arg_shape,
+                                     out_shape,
+                                     window_shape,
+                                     window_movement_strides,
+                                     padding_below,
+                                     padding_above);
+                    if (std::fegetround() != FE_TONEAREST || !plan.valid ||
+                        (plan.has_empty_window && !include_padding_in_avg_computation))
+                    {
+                        return false;
+                    }
+
+                    for_each_window(plan, [&](size_t out_index, const std::vector<size_t>& taps) {
+                        // Padding contributes +0 to a sum that starts at +0, which never
+                        // changes it, so only the count includes the padding.
+                        T result = 0;
+                        for (size_t tap : taps)
+                        {
+                            result += arg[tap];
+                        }
+                        size_t n_elements =
+                            include_padding_in_avg_computation ? plan.window_size : taps.size();
+
+                        if (std::is_same<T, int8_t>::value || std::is_same<T, uint8_t>::value)
+                        {
+                            out[out_index] = static_cast<T>(
+                                std::nearbyint(static_cast<float>(result) / n_elements));
+                        }
+                        else
+                        {
+                            out[out_index] = result / n_elements;
+                        }
+                    });
+                    return true;
+                }
+            }
+
             template <typename T>
             void avg_pool(const T* arg,
                           T* out,
@@ -132,6 +185,19 @@ namespace ngraph
                           const Shape& padding_above,
                           bool include_padding_in_avg_computation)
             {
+                if (fast::is_enabled() && fast::avg_pool(arg,
+                                                         out,
+                                                         arg_shape,
+                                                         out_shape,
+                                                         window_shape,
+                                                         window_movement_strides,
+                                                         padding_below,
+                                                         padding_above,
+                                                         include_padding_in_avg_computation))
+                {
+                    return;
+                }
+
                 auto old_mode = std::fegetround();
                 std::fesetround(FE_TONEAREST);
                 // At the outermost level we will walk over every output coordinate O.
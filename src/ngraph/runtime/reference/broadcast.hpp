@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -27,6 +28,76 @@ namespace ngraph
     {
         namespace reference
         {
+            namespace fast
+            {
+                template <typename T>
+                bool broadcast(const T* arg,
+                               T* out,
+                               const Shape& in_shape,
+                               const Shape& out_shape,
+                               const AxisSet& broadcast_axes)
+                {
+                    size_t rank = out_shape.size();
+                    size_t out_size = shape_size(out_shape);
+                    if (rank == 0 || out_size == 0 ||
+                        (!broadcast_axes.empty() && *broadcast_axes.rbegin() >= rank))
+                    {
+                        return false;
+                    }
+
+                    // Input stride of every output axis, 0 along the broadcast axes
+                    Shape adjusted_in_shape;
+                    for (auto length : in_shape)
+                    {
+                        if (length != 1)
+                        {
+                            adjusted_in_shape.push_back(length);
+                        }
+                    }
+                    std::vector<size_t> adjusted_in_strides = row_major_strides(adjusted_in_shape);
+                    std::vector<size_t> in_strides(rank, 0);
+                    size_t in_axis = 0;
+                    for (size_t axis = 0; axis < rank; axis++)
+                    {
+                        if (out_shape[axis] == 1 || broadcast_axes.count(axis) != 0)
+                        {
+                            continue;
+                        }
+                        if (in_axis == adjusted_in_shape.size() ||
+                            adjusted_in_shape[in_axis] != out_shape[axis])
+                        {
+                            return false;
+                        }
+                        in_strides[axis] = adjusted_in_strides[in_axis++];
+                    }
+                    if (in_axis != adjusted_in_shape.size())
+                    {
+                        return false;
+                    }
+
+                    size_t row_length = out_shape[rank - 1];
+                    size_t row_stride = in_strides[rank - 1];
+                    parallel_for(out_size / row_length, row_length, [&](size_t begin, size_t end) {
+                        for (size_t row = begin; row < end; row++)
+                        {
+                            size_t in_offset = 0;
+                            size_t index = row;
+                            for (size_t axis = rank - 1; axis > 0; axis--)
+                            {
+                                in_offset += (index % out_shape[axis - 1]) * in_strides[axis - 1];
+                                index /= out_shape[axis - 1];
+                            }
+                            T* out_row = out + row * row_length;
+                            for (size_t i = 0; i < row_length; i++)
+                            {
+                                out_row[i] = arg[in_offset + i * row_stride];
+                            }
+                        }
+                    });
+                    return true;
+                }
+            }
+
             template <typename T>
             void broadcast(const T* arg,
                            T* out,
@@ -34,6 +105,12 @@ namespace ngraph
                            const Shape& out_shape,
                            const AxisSet& broadcast_axes)
             {
+                if (fast::is_enabled() &&
+                    fast::broadcast(arg, out, in_shape, out_shape, broadcast_axes))
+                {
+                    return;
+                }
+
                 // Remove all broadcast axes from in_shape
                 Shape adjusted_in_shape;
                 for (auto length : in_shape)
@@ -57,23 +57,20 @@ namespace ngraph
                     out_end_coord[concatenation_axis] =
                         concatenation_pos + in_shapes[i][concatenation_axis];
 
-                    CoordinateTransform input_transform(in_shapes[i]);
                     CoordinateTransform output_chunk_transform(
                         out_shape, out_start_coord, out_end_coord);
 
-                    NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
+                    NGRAPH_CHECK(shape_size(in_shapes[i]) ==
                                  shape_size(output_chunk_transform.get_target_shape()));
 
-                    CoordinateTransform::Iterator output_chunk_it = output_chunk_transform.begin();
-
-                    for (const Coordinate& input_coord : input_transform)
-                    {
-                        size_t input_index = input_transform.index(input_coord);
-                        size_t output_chunk_index = output_chunk_transform.index(*output_chunk_it);
-                        ++output_chunk_it;
-
-                        out[output_chunk_index] = args[i][input_index];
-                    }
+                    const T* arg = args[i];
+                    output_chunk_transform.for_each_run(
+                        [&](size_t in_index, size_t out_index, size_t count, size_t out_step) {
+                            for (size_t j = 0; j < count; j++)
+                            {
+                                out[out_index + j * out_step] = arg[in_index + j];
+                            }
+                        });
 
                     concatenation_pos += in_shapes[i][concatenation_axis];
                 }
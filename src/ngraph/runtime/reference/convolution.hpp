@@ -22,6 +22,7 @@
 
 #include "ngraph/axis_vector.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/runtime/reference/reverse.hpp"
 #include "ngraph/util.hpp"
 
@@ -49,6 +50,233 @@ namespace ngraph
                 using type = long double;
             };
 
+            namespace fast
+            {
+                // For every output position o along a spatial axis and filter position k, the
+                // input position that the generic kernel reads, or -1 if it is in the padding
+                // or in a dilation gap. Empty if the generic kernel rejects the geometry.
+                inline std::vector<std::ptrdiff_t> get_convolution_taps(size_t in_length,
+                                                                         size_t filter_length,
+                                                                         size_t out_length,
+                                                                         size_t stride,
+                                                                         size_t filter_dilation,
+                                                                         std::ptrdiff_t pad_below,
+                                                                         std::ptrdiff_t pad_above,
+                                                                         size_t in_dilation)
+                {
+                    std::vector<std::ptrdiff_t> taps;
+                    std::ptrdiff_t dilated_length = (in_length - 1) * in_dilation + 1;
+                    std::ptrdiff_t last_end =
+                        (out_length - 1) * stride + (filter_length - 1) * filter_dilation + 1;
+                    if (in_length == 0 || filter_length == 0 || out_length == 0 ||
+                        in_dilation == 0 || last_end > dilated_length + pad_below + pad_above)
+                    {
+                        return taps;
+                    }
+                    taps.reserve(out_length * filter_length);
+                    for (size_t o = 0; o < out_length; o++)
+                    {
+                        for (size_t k = 0; k < filter_length; k++)
+                        {
+                            std::ptrdiff_t pos = o * stride + k * filter_dilation - pad_below;
+                            bool valid = pos >= 0 && pos < dilated_length && pos % in_dilation == 0;
+                            taps.push_back(valid ? pos / std::ptrdiff_t(in_dilation) : -1);
+                        }
+                    }
+                    return taps;
+                }
+
+                template <typename INPUT, typename FILTER, typename OUTPUT, typename ACCUMULATION>
+                bool general_convolution(const INPUT* in,
+                                         const FILTER* filter,
+                                         OUTPUT* out,
+                                         const Shape& in_shape,
+                                         const Shape& filter_shape,
+                                         const Shape& out_shape,
+                                         const Strides& stride,
+                                         const Strides& filter_dilation,
+                                         const CoordinateDiff& in_pad_below,
+                                         const CoordinateDiff& in_pad_above,
+                                         const Strides& in_dilation,
+                                         size_t in_batch_axis,
+                                         size_t in_channel_axis,
+                                         size_t filter_out_channel_axis,
+                                         size_t filter_in_channel_axis,
+                                         size_t out_batch_axis,
+                                         size_t out_channel_axis,
+                                         const float* input_scale,
+                                         const INPUT* input_zero_point,
+                                         const float* filter_scale,
+                                         const FILTER* filter_zero_point,
+                                         const float* output_scale,
+                                         const OUTPUT* output_zero_point)
+                {
+                    size_t rank = in_shape.size();
+                    if (rank < 3 || filter_shape.size() != rank || out_shape.size() != rank ||
+                        in_batch_axis + in_channel_axis != 1 || in_batch_axis > 1 ||
+                        filter_out_channel_axis + filter_in_channel_axis != 1 ||
+                        filter_out_channel_axis > 1 || out_batch_axis + out_channel_axis != 1 ||
+                        out_batch_axis > 1 ||
+                        in_shape[in_channel_axis] != filter_shape[filter_in_channel_axis] ||
+                        in_shape[in_batch_axis] != out_shape[out_batch_axis] ||
+                        filter_shape[filter_out_channel_axis] != out_shape[out_channel_axis] ||
+                        shape_size(in_shape) == 0 || shape_size(filter_shape) == 0 ||
+                        shape_size(out_shape) == 0)
+                    {
+                        return false;
+                    }
+
+                    // Valid taps of every spatial axis, the generic kernel walks the filter
+                    // positions in row-major order and the input channels inside them.
+                    size_t n = rank - 2;
+                    std::vector<std::vector<std::ptrdiff_t>> taps(n);
+                    size_t filter_size = 1;
+                    for (size_t d = 0; d < n; d++)
+                    {
+                        taps[d] = get_convolution_taps(in_shape[d + 2],
+                                                       filter_shape[d + 2],
+                                                       out_shape[d + 2],
+                                                       stride[d],
+                                                       filter_dilation[d],
+                                                       in_pad_below[d],
+                                                       in_pad_above[d],
+                                                       in_dilation[d]);
+                        if (taps[d].empty())
+                        {
+                            return false;
+                        }
+                        filter_size *= filter_shape[d + 2];
+                    }
+
+                    bool is_quantized = input_scale && input_zero_point && filter_scale &&
+                                        filter_zero_point && output_scale && output_zero_point;
+                    ACCUMULATION in_zero_point =
+                        is_quantized ? static_cast<ACCUMULATION>(*input_zero_point) : 0;
+                    ACCUMULATION filter_zero_point_value =
+                        is_quantized ? static_cast<ACCUMULATION>(*filter_zero_point) : 0;
+
+                    std::vector<size_t> in_strides = row_major_strides(in_shape);
+                    std::vector<size_t> filter_strides = row_major_strides(filter_shape);
+                    std::vector<size_t> out_strides = row_major_strides(out_shape);
+                    size_t n_in_channels = in_shape[in_channel_axis];
+                    size_t n_out_channels = out_shape[out_channel_axis];
+                    size_t width = out_shape[rank - 1];
+                    size_t filter_width = filter_shape[rank - 1];
+                    size_t rows = shape_size(out_shape) / width;
+
+                    auto old_mode = std::fegetround();
+                    std::fesetround(FE_TONEAREST);
+                    // Each task computes one row of outputs along the last spatial axis, with
+                    // one accumulator per output.
+                    parallel_for(
+                        rows, width * filter_size * n_in_channels, [&](size_t begin, size_t end) {
+                            std::vector<ACCUMULATION> results(width);
+                            std::vector<size_t> out_coord(n);
+                            std::vector<size_t> counter(n);
+                            for (size_t row = begin; row < end; row++)
+                            {
+                                // row = ((batch, out channel), o_1, ..., o_{n-1})
+                                size_t index = row;
+                                for (size_t d = n - 1; d > 0; d--)
+                                {
+                                    out_coord[d - 1] = index % out_shape[d + 1];
+                                    index /= out_shape[d + 1];
+                                }
+                                size_t out_channel = index % n_out_channels;
+                                size_t batch = index / n_out_channels;
+                                size_t out_offset = batch * out_strides[out_batch_axis] +
+                                                    out_channel * out_strides[out_channel_axis];
+                                for (size_t d = 0; d + 1 < n; d++)
+                                {
+                                    out_offset += out_coord[d] * out_strides[d + 2];
+                                }
+                                const INPUT* in_image = in + batch * in_strides[in_batch_axis];
+                                const FILTER* filter_kernel =
+                                    filter + out_channel * filter_strides[filter_out_channel_axis];
+
+                                std::fill(results.begin(), results.end(), ACCUMULATION(0));
+                                // Odometer over the filter positions of the leading axes
+                                std::fill(counter.begin(), counter.end(), 0);
+                                size_t d;
+                                do
+                                {
+                                    size_t in_offset = 0;
+                                    size_t filter_offset = 0;
+                                    bool valid = true;
+                                    for (size_t a = 0; a + 1 < n && valid; a++)
+                                    {
+                                        std::ptrdiff_t x = taps[a][out_coord[a] *
+                                                                       filter_shape[a + 2] +
+                                                                   counter[a]];
+                                        valid = x >= 0;
+                                        in_offset += x * in_strides[a + 2];
+                                        filter_offset += counter[a] * filter_strides[a + 2];
+                                    }
+                                    for (size_t k = 0; valid && k < filter_width; k++)
+                                    {
+                                        const FILTER* f = filter_kernel + filter_offset +
+                                                          k * filter_strides[rank - 1];
+                                        const INPUT* in_window = in_image + in_offset;
+                                        for (size_t c = 0; c < n_in_channels; c++)
+                                        {
+                                            ACCUMULATION f_v = static_cast<ACCUMULATION>(
+                                                f[c * filter_strides[filter_in_channel_axis]]);
+                                            if (is_quantized)
+                                            {
+                                                f_v = f_v - filter_zero_point_value;
+                                            }
+                                            const INPUT* in_channel =
+                                                in_window + c * in_strides[in_channel_axis];
+                                            for (size_t w = 0; w < width; w++)
+                                            {
+                                                std::ptrdiff_t x =
+                                                    taps[n - 1][w * filter_width + k];
+                                                if (x < 0)
+                                                {
+                                                    continue;
+                                                }
+                                                ACCUMULATION in_v = static_cast<ACCUMULATION>(
+                                                    in_channel[x * in_strides[rank - 1]]);
+                                                if (is_quantized)
+                                                {
+                                                    in_v = in_v - in_zero_point;
+                                                }
+                                                results[w] += in_v * f_v;
+                                            }
+                                        }
+                                    }
+                                    for (d = n - 1; d > 0; d--)
+                                    {
+                                        if (++counter[d - 1] < filter_shape[d + 1])
+                                        {
+                                            break;
+                                        }
+                                        counter[d - 1] = 0;
+                                    }
+                                } while (d > 0);
+
+                                for (size_t w = 0; w < width; w++)
+                                {
+                                    OUTPUT* o = out + out_offset + w * out_strides[rank - 1];
+                                    if (is_quantized)
+                                    {
+                                        float scale = *input_scale * *filter_scale / *output_scale;
+                                        *o = static_cast<OUTPUT>(std::round(
+                                                 static_cast<float>(results[w]) * scale)) +
+                                             *output_zero_point;
+                                    }
+                                    else
+                                    {
+                                        *o = results[w];
+                                    }
+                                }
+                            }
+                        });
+                    std::fesetround(old_mode);
+                    return true;
+                }
+            }
+
             // in: NC_I...
             // filter: C_OC_I...
             // out: NC_O...
@@ -87,6 +315,35 @@ namespace ngraph
                     is_quantized = true;
                 }
 
+                if (fast::is_enabled() &&
+                    fast::general_convolution<INPUT, FILTER, OUTPUT, ACCUMULATION>(
+                        in,
+                        filter,
+                        out,
+                        in_shape,
+                        filter_shape,
+                        out_shape,
+                        stride,
+                        filter_dilation,
+                        in_pad_below,
+                        in_pad_above,
+                        in_dilation,
+                        in_batch_axis,
+                        in_channel_axis,
+                        filter_out_channel_axis,
+                        filter_in_channel_axis,
+                        out_batch_axis,
+                        out_channel_axis,
+                        input_scale,
+                        input_zero_point,
+                        filter_scale,
+                        filter_zero_point,
+                        output_scale,
+                        output_zero_point))
+                {
+                    return;
+                }
+
                 auto old_mode = std::fegetround();
                 std::fesetround(FE_TONEAREST);
                 // Comments throughout assume without loss of generality that:
@@ -23,6 +23,7 @@
 #include <functional>
 #include "convolution.hpp"
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -31,6 +32,108 @@ namespace ngraph
     {
         namespace reference
         {
+            namespace fast
+            {
+                // out[i, j] = sum over k of arg0[i, k] * arg1[k, j], with i, k and j the
+                // flattened projected, dotted and projected axes.
+                template <typename INPUT0, typename INPUT1, typename OUTPUT, typename ACCUMULATION>
+                bool dot(const INPUT0* arg0,
+                         const INPUT1* arg1,
+                         OUTPUT* out,
+                         const Shape& arg0_shape,
+                         const Shape& arg1_shape,
+                         const Shape& out_shape,
+                         size_t reduction_axes_count,
+                         const float* input0_scale,
+                         const INPUT0* input0_zero_point,
+                         const float* input1_scale,
+                         const INPUT1* input1_zero_point,
+                         const float* output_scale,
+                         const OUTPUT* output_zero_point)
+                {
+                    // The generic kernel restores the caller's rounding mode after the first
+                    // row, so only the default mode gives the same results everywhere.
+                    if (std::fegetround() != FE_TONEAREST ||
+                        reduction_axes_count > arg0_shape.size() ||
+                        reduction_axes_count > arg1_shape.size() ||
+                        !std::equal(arg1_shape.begin(),
+                                    arg1_shape.begin() + reduction_axes_count,
+                                    arg0_shape.end() - reduction_axes_count))
+                    {
+                        return false;
+                    }
+                    size_t dot_size = shape_size(Shape(arg1_shape.begin(),
+                                                       arg1_shape.begin() + reduction_axes_count));
+                    size_t rows = shape_size(arg0_shape) / std::max(dot_size, size_t(1));
+                    size_t cols = shape_size(arg1_shape) / std::max(dot_size, size_t(1));
+                    if (dot_size == 0 || rows * cols == 0 || shape_size(out_shape) != rows * cols)
+                    {
+                        return false;
+                    }
+
+                    bool is_quantized = input0_scale && input0_zero_point && input1_scale &&
+                                        input1_zero_point && output_scale && output_zero_point;
+                    ACCUMULATION zero_point0 =
+                        is_quantized ? static_cast<ACCUMULATION>(*input0_zero_point) : 0;
+                    ACCUMULATION zero_point1 =
+                        is_quantized ? static_cast<ACCUMULATION>(*input1_zero_point) : 0;
+
+                    // Each task computes a block of one output row, walking k in order
+                    static constexpr size_t s_col_block = 256;
+                    size_t col_blocks = (cols + s_col_block - 1) / s_col_block;
+                    parallel_for(
+                        rows * col_blocks, dot_size * s_col_block, [&](size_t begin, size_t end) {
+                            std::vector<ACCUMULATION> sums(s_col_block);
+                            for (size_t tile = begin; tile < end; tile++)
+                            {
+                                size_t row = tile / col_blocks;
+                                size_t first = (tile % col_blocks) * s_col_block;
+                                size_t n = std::min(s_col_block, cols - first);
+                                std::fill(sums.begin(), sums.end(), ACCUMULATION(0));
+                                for (size_t k = 0; k < dot_size; k++)
+                                {
+                                    ACCUMULATION a =
+                                        static_cast<ACCUMULATION>(arg0[row * dot_size + k]);
+                                    const INPUT1* b = arg1 + k * cols + first;
+                                    if (is_quantized)
+                                    {
+                                        a = a - zero_point0;
+                                        for (size_t j = 0; j < n; j++)
+                                        {
+                                            sums[j] +=
+                                                a * (static_cast<ACCUMULATION>(b[j]) - zero_point1);
+                                        }
+                                    }
+                                    else
+                                    {
+                                        for (size_t j = 0; j < n; j++)
+                                        {
+                                            sums[j] += a * static_cast<ACCUMULATION>(b[j]);
+                                        }
+                                    }
+                                }
+
+                                OUTPUT* out_row = out + row * cols + first;
+                                for (size_t j = 0; j < n; j++)
+                                {
+                                    if (is_quantized)
+                                    {
+                                        float scale = *input0_scale * *input1_scale / *output_scale;
+                                        out_row[j] = static_cast<OUTPUT>(std::round(
+                                                         static_cast<float>(sums[j]) * scale)) +
+                                                     *output_zero_point;
+                                    }
+                                    else
+                                    {
+                                        out_row[j] = sums[j];
+                                    }
+                                }
+                            }
+                        });
+                    return true;
+                }
+            }
+
             template <typename INPUT0,
                       typename INPUT1,
                       typename OUTPUT,
@@ -49,6 +152,24 @@ namespace ngraph
                      const float* output_scale = nullptr,
                      const OUTPUT* output_zero_point = nullptr)
             {
+                if (fast::is_enabled() &&
+                    fast::dot<INPUT0, INPUT1, OUTPUT, ACCUMULATION>(arg0,
+                                                                   arg1,
+                                                                   out,
+                                                                   arg0_shape,
+                                                                   arg1_shape,
+                                                                   out_shape,
+                                                                   reduction_axes_count,
+                                                                   input0_scale,
+                                                                   input0_zero_point,
+                                                                   input1_scale,
+                                                                   input1_zero_point,
+                                                                   output_scale,
+                                                                   output_zero_point))
+                {
+                    return;
+                }
+
                 bool is_quantized = false;
                 if (input0_scale && input0_zero_point && input1_scale && input1_zero_point &&
                     output_scale && output_zero_point)
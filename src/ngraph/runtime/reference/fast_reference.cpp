@@ -0,0 +1,175 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+#include "ngraph/runtime/reference/fast_reference.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace
+{
+    thread_local bool t_run_serially = false;
+
+    // get_num_threads() - 1 workers started on first use, which run the chunks of one call
+    // at a time together with the calling thread
+    class ThreadPool
+    {
+    public:
+        ThreadPool(size_t num_workers)
+        {
+            for (size_t i = 0; i < num_workers; i++)
+            {
+                m_workers.emplace_back([this]() { work(); });
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_job_ready.notify_all();
+            for (auto& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        // Returns false without running anything when another call holds the pool
+        bool try_run(size_t num_chunks, const function<void(size_t)>& run_chunk)
+        {
+            unique_lock<mutex> call_lock(m_call_mutex, try_to_lock);
+            if (!call_lock.owns_lock())
+            {
+                return false;
+            }
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_run_chunk = &run_chunk;
+                m_num_chunks = num_chunks;
+                m_next_chunk = 0;
+                m_pending_chunks = num_chunks;
+                m_exception = nullptr;
+                m_job++;
+            }
+            m_job_ready.notify_all();
+
+            t_run_serially = true;
+            run_available_chunks();
+            t_run_serially = false;
+
+            unique_lock<mutex> lock(m_mutex);
+            m_job_done.wait(lock, [this]() { return m_pending_chunks == 0; });
+            m_run_chunk = nullptr;
+            if (m_exception)
+            {
+                rethrow_exception(m_exception);
+            }
+            return true;
+        }
+
+    private:
+        void work()
+        {
+            t_run_serially = true;
+            size_t seen_job = 0;
+            unique_lock<mutex> lock(m_mutex);
+            while (true)
+            {
+                m_job_ready.wait(lock, [&]() { return m_stopping || m_job != seen_job; });
+                if (m_stopping)
+                {
+                    return;
+                }
+                seen_job = m_job;
+                lock.unlock();
+                run_available_chunks();
+                lock.lock();
+            }
+        }
+
+        void run_available_chunks()
+        {
+            unique_lock<mutex> lock(m_mutex);
+            while (m_run_chunk != nullptr && m_next_chunk < m_num_chunks)
+            {
+                size_t chunk = m_next_chunk++;
+                const function<void(size_t)>& run_chunk = *m_run_chunk;
+                lock.unlock();
+                exception_ptr exception;
+                try
+                {
+                    run_chunk(chunk);
+                }
+                catch (...)
+                {
+                    exception = current_exception();
+                }
+                lock.lock();
+                if (exception && !m_exception)
+                {
+                    m_exception = exception;
+                }
+                if (--m_pending_chunks == 0)
+                {
+                    m_job_done.notify_all();
+                }
+            }
+        }
+
+        vector<thread> m_workers;
+        mutex m_call_mutex;
+        mutex m_mutex;
+        condition_variable m_job_ready;
+        condition_variable m_job_done;
+        const function<void(size_t)>* m_run_chunk = nullptr;
+        size_t m_num_chunks = 0;
+        size_t m_next_chunk = 0;
+        size_t m_pending_chunks = 0;
+        size_t m_job = 0;
+        bool m_stopping = false;
+        exception_ptr m_exception;
+    };
+}
+
+void runtime::reference::fast::run_chunks(size_t num_chunks,
+                                          const function<void(size_t)>& run_chunk)
+{
+    if (!t_run_serially)
+    {
+        static ThreadPool pool(get_num_threads() - 1);
+        if (pool.try_run(num_chunks, run_chunk))
+        {
+            return;
+        }
+    }
+    for (size_t chunk = 0; chunk < num_chunks; chunk++)
+    {
+        run_chunk(chunk);
+    }
+}
+
+bool runtime::reference::fast::set_serial_on_this_thread(bool serial)
+{
+    bool was_serial = t_run_serially;
+    t_run_serially = serial;
+    return was_serial;
+}
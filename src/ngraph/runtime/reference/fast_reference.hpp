@@ -0,0 +1,401 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cfenv>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "ngraph/axis_set.hpp"
+#include "ngraph/env_util.hpp"
+#include "ngraph/ngraph_visibility.hpp"
+#include "ngraph/shape.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        namespace reference
+        {
+            // Fast tier of the reference kernels.
+            //
+            // Kernels that have a fast implementation try it first and fall back to their
+            // CoordinateTransform loop when it does not apply (unusual geometry, or an input
+            // the generic loop would reject). Fast implementations walk the tensors with
+            // precomputed strides and only reorder work *between* output elements; every
+            // output element sees the same sequence of arithmetic operations as in the generic
+            // loop, so the results are bit-exact.
+            namespace fast
+            {
+                inline std::atomic<bool>& enabled_flag()
+                {
+                    static std::atomic<bool> s_enabled{
+                        getenv_bool("NGRAPH_FAST_REFERENCE", true)};
+                    return s_enabled;
+                }
+
+                /// \brief Returns false if the fast reference kernels were disabled with
+                ///        NGRAPH_FAST_REFERENCE=0 or set_enabled(false).
+                inline bool is_enabled() { return enabled_flag().load(); }
+                inline void set_enabled(bool enabled) { enabled_flag().store(enabled); }
+                /// \brief Number of threads the fast kernels may use. Set with
+                ///        NGRAPH_FAST_REFERENCE_THREADS, defaults to the intra-op budget of
+                ///        NGRAPH_INTRA_OP_PARALLELISM and then to the hardware concurrency.
+                inline size_t get_num_threads()
+                {
+                    static const size_t s_num_threads = []() {
+                        int32_t threads = getenv_int("NGRAPH_FAST_REFERENCE_THREADS", 0);
+                        if (threads <= 0)
+                        {
+                            threads = getenv_int("NGRAPH_INTRA_OP_PARALLELISM", 0);
+                        }
+                        if (threads <= 0)
+                        {
+                            threads = std::thread::hardware_concurrency();
+                        }
+                        return static_cast<size_t>(std::max(threads, 1));
+                    }();
+                    return s_num_threads;
+                }
+
+                // Work, in inner loop iterations, below which a thread is not worth starting
+                static constexpr size_t s_min_work_per_thread = 32 * 1024;
+
+                /// \brief Calls run_chunk(chunk) for each chunk in [0, num_chunks) on the
+                ///        threads of one pool shared by all the fast kernels, the calling
+                ///        thread included. The chunks run one after another on the calling
+                ///        thread when it is a pool thread, was set serial or the pool is busy
+                ///        with another call, so nested and concurrent calls do not add
+                ///        threads.
+                NGRAPH_API
+                void run_chunks(size_t num_chunks, const std::function<void(size_t)>& run_chunk);
+
+                /// \brief Makes the fast kernels called on this thread run serially. Backends
+                ///        set this on threads that already run ops in parallel with each
+                ///        other, e.g. the workers of an inter-op scheduler.
+                /// \return The previous setting
+                NGRAPH_API
+                bool set_serial_on_this_thread(bool serial);
+
+                /// \brief Calls f(begin, end) on disjoint subranges of [0, count), in parallel
+                ///        when there is enough work. Each chunk runs with the caller's
+                ///        floating point environment.
+                template <typename F>
+                void parallel_for(size_t count, size_t cost_per_item, const F& f)
+                {
+                    size_t work = count * std::max(cost_per_item, size_t(1));
+                    size_t num_threads = std::min(
+                        {get_num_threads(), count, work / s_min_work_per_thread});
+                    if (num_threads <= 1)
+                    {
+                        f(0, count);
+                        return;
+                    }
+
+                    fenv_t env;
+                    std::fegetenv(&env);
+                    run_chunks(num_threads, [&](size_t chunk) {
+                        fenv_t saved_env;
+                        std::fegetenv(&saved_env);
+                        std::fesetenv(&env);
+                        f(count * chunk / num_threads, count * (chunk + 1) / num_threads);
+                        std::fesetenv(&saved_env);
+                    });
+                }
+
+                struct StridedAxis
+                {
+                    size_t length;
+                    size_t stride;
+                };
+
+                /// \brief Splits the input of a reduction into the kept axes in front of the
+                ///        innermost run of kept axes (outer), the reduced axes and the
+                ///        innermost kept axes (inner), which are contiguous in both the input
+                ///        and the output.
+                ///
+                /// Output index o * inner + b accumulates the input elements at
+                /// in_offset(o) + reduced_offset + b, and visiting the reduced offsets in
+                /// row-major order for each o matches the order of the generic kernels.
+                struct ReductionPlan
+                {
+                    ReductionPlan(const Shape& in_shape, const AxisSet& reduction_axes)
+                    {
+                        size_t stride = 1;
+                        size_t axis = in_shape.size();
+                        for (; axis > 0 && reduction_axes.count(axis - 1) == 0; axis--)
+                        {
+                            inner *= in_shape[axis - 1];
+                            stride *= in_shape[axis - 1];
+                        }
+                        for (; axis > 0; axis--)
+                        {
+                            StridedAxis a{in_shape[axis - 1], stride};
+                            if (reduction_axes.count(axis - 1) == 0)
+                            {
+                                outer.insert(outer.begin(), a);
+                                outer_count *= a.length;
+                            }
+                            else
+                            {
+                                reduced.insert(reduced.begin(), a);
+                                reduced_count *= a.length;
+                            }
+                            stride *= a.length;
+                        }
+                        in_size = stride;
+                    }
+
+                    /// \brief True if the plan covers a non-empty reduction into out_shape.
+                    bool applies_to(const Shape& out_shape) const
+                    {
+                        return in_size > 0 && shape_size(out_shape) == outer_count * inner;
+                    }
+
+                    size_t get_in_offset(size_t outer_index) const
+                    {
+                        size_t offset = 0;
+                        for (size_t i = outer.size(); i > 0; i--)
+                        {
+                            offset += (outer_index % outer[i - 1].length) * outer[i - 1].stride;
+                            outer_index /= outer[i - 1].length;
+                        }
+                        return offset;
+                    }
+
+                    std::vector<StridedAxis> outer;
+                    std::vector<StridedAxis> reduced;
+                    size_t inner = 1;
+                    size_t outer_count = 1;
+                    size_t reduced_count = 1;
+                    size_t in_size = 1;
+                };
+
+                /// \brief Calls f(out_offset, in_offset, count) for every reduced position of
+                ///        count outputs starting at (row, first) of the plan.
+                template <typename F>
+                void reduce_rows(const ReductionPlan& plan,
+                                 size_t row,
+                                 size_t first,
+                                 size_t count,
+                                 std::vector<size_t>& counter,
+                                 const F& f)
+                {
+                    size_t out_offset = row * plan.inner + first;
+                    size_t in_offset = plan.get_in_offset(row) + first;
+                    if (plan.reduced.empty())
+                    {
+                        f(out_offset, in_offset, count);
+                        return;
+                    }
+
+                    // Odometer over the reduced axes, the last one is walked directly
+                    const StridedAxis& last = plan.reduced.back();
+                    std::fill(counter.begin(), counter.end(), 0);
+                    size_t axis;
+                    do
+                    {
+                        for (size_t i = 0; i < last.length; i++)
+                        {
+                            f(out_offset, in_offset + i * last.stride, count);
+                        }
+                        for (axis = plan.reduced.size() - 1; axis > 0; axis--)
+                        {
+                            const StridedAxis& a = plan.reduced[axis - 1];
+                            in_offset += a.stride;
+                            if (++counter[axis - 1] < a.length)
+                            {
+                                break;
+                            }
+                            in_offset -= a.length * a.stride;
+                            counter[axis - 1] = 0;
+                        }
+                    } while (axis > 0);
+                }
+
+                /// \brief Calls f(out_offset, in_offset, count) so that output element
+                ///        out_offset + i receives input element in_offset + i for i < count,
+                ///        with each output seeing its inputs in row-major order.
+                template <typename F>
+                void for_each_reduction(const ReductionPlan& plan, const F& f)
+                {
+                    // With few outer rows, split the inner rows as well to keep threads busy
+                    size_t block = plan.inner;
+                    if (plan.outer_count < get_num_threads() && plan.inner > 2048)
+                    {
+                        block = 1024;
+                    }
+                    size_t blocks_per_row = (plan.inner + block - 1) / block;
+
+                    parallel_for(
+                        plan.outer_count * blocks_per_row,
+                        plan.reduced_count * block,
+                        [&](size_t begin, size_t end) {
+                            std::vector<size_t> counter(plan.reduced.size());
+                            for (size_t tile = begin; tile < end; tile++)
+                            {
+                                size_t row = tile / blocks_per_row;
+                                size_t first = (tile % blocks_per_row) * block;
+                                size_t count = std::min(block, plan.inner - first);
+                                reduce_rows(plan, row, first, count, counter, f);
+                            }
+                        });
+                }
+
+                /// \brief Window geometry of a pooling op over an NC... tensor.
+                struct PoolingPlan
+                {
+                    PoolingPlan(const Shape& arg_shape,
+                                const Shape& out_shape,
+                                const Shape& window_shape,
+                                const Strides& window_movement_strides,
+                                const Shape& padding_below,
+                                const Shape& padding_above)
+                        : n_spatial(arg_shape.size() < 3 ? 0 : arg_shape.size() - 2)
+                    {
+                        if (n_spatial == 0 || out_shape.size() != arg_shape.size() ||
+                            out_shape[0] != arg_shape[0] || out_shape[1] != arg_shape[1] ||
+                            shape_size(arg_shape) == 0 || shape_size(out_shape) == 0)
+                        {
+                            return;
+                        }
+                        std::vector<size_t> strides = row_major_strides(arg_shape);
+                        for (size_t d = 0; d < n_spatial; d++)
+                        {
+                            size_t in_length = arg_shape[d + 2];
+                            size_t out_length = out_shape[d + 2];
+                            // The generic kernel rejects windows that leave the padded input
+                            if (window_shape[d] == 0 ||
+                                window_movement_strides[d] * (out_length - 1) + window_shape[d] >
+                                    in_length + padding_below[d] + padding_above[d])
+                            {
+                                return;
+                            }
+                            std::ptrdiff_t first_start = -std::ptrdiff_t(padding_below[d]);
+                            std::ptrdiff_t last_start =
+                                first_start + window_movement_strides[d] * (out_length - 1);
+                            if (first_start + std::ptrdiff_t(window_shape[d]) <= 0 ||
+                                last_start >= std::ptrdiff_t(in_length))
+                            {
+                                has_empty_window = true;
+                            }
+                            in_lengths.push_back(in_length);
+                            in_strides.push_back(strides[d + 2]);
+                            out_lengths.push_back(out_length);
+                            windows.push_back(window_shape[d]);
+                            movement_strides.push_back(window_movement_strides[d]);
+                            pads_below.push_back(padding_below[d]);
+                            window_size *= window_shape[d];
+                        }
+                        in_image_size = strides[1];
+                        out_image_size = row_major_strides(out_shape)[1];
+                        out_count = shape_size(out_shape);
+                        valid = true;
+                    }
+
+                    size_t n_spatial;
+                    bool valid = false;
+                    bool has_empty_window = false;
+                    size_t window_size = 1;
+                    size_t in_image_size = 0;
+                    size_t out_image_size = 0;
+                    size_t out_count = 0;
+                    std::vector<size_t> in_lengths;
+                    std::vector<size_t> in_strides;
+                    std::vector<size_t> out_lengths;
+                    std::vector<size_t> windows;
+                    std::vector<size_t> movement_strides;
+                    std::vector<size_t> pads_below;
+                };
+
+                /// \brief Calls f(out_index, taps) for every output of a pooling op, where taps
+                ///        holds the input offsets of the window elements that lie inside the
+                ///        input, in row-major window order.
+                template <typename F>
+                void for_each_window(const PoolingPlan& plan, const F& f)
+                {
+                    size_t n = plan.n_spatial;
+                    parallel_for(plan.out_count, plan.window_size, [&](size_t begin, size_t end) {
+                        std::vector<std::ptrdiff_t> starts(n);
+                        std::vector<size_t> first(n);
+                        std::vector<size_t> last(n);
+                        std::vector<size_t> counter(n);
+                        std::vector<size_t> taps;
+                        taps.reserve(plan.window_size);
+                        for (size_t out_index = begin; out_index < end; out_index++)
+                        {
+                            taps.clear();
+                            bool empty = false;
+                            size_t position = out_index % plan.out_image_size;
+                            for (size_t d = n; d > 0; d--)
+                            {
+                                size_t o = position % plan.out_lengths[d - 1];
+                                position /= plan.out_lengths[d - 1];
+                                std::ptrdiff_t start =
+                                    std::ptrdiff_t(o * plan.movement_strides[d - 1]) -
+                                    std::ptrdiff_t(plan.pads_below[d - 1]);
+                                std::ptrdiff_t in_length = plan.in_lengths[d - 1];
+                                std::ptrdiff_t window = plan.windows[d - 1];
+                                starts[d - 1] = start;
+                                first[d - 1] = size_t(std::max(-start, std::ptrdiff_t(0)));
+                                last[d - 1] = size_t(std::min(window, in_length - start));
+                                empty = empty || start >= in_length || start + window <= 0;
+                            }
+                            if (!empty)
+                            {
+                                size_t in_base =
+                                    (out_index / plan.out_image_size) * plan.in_image_size;
+                                for (size_t d = 0; d < n; d++)
+                                {
+                                    counter[d] = first[d];
+                                    in_base += (starts[d] + first[d]) * plan.in_strides[d];
+                                }
+                                // Odometer over the window, the last axis is walked directly
+                                size_t offset = in_base;
+                                size_t d;
+                                do
+                                {
+                                    for (size_t w = first[n - 1]; w < last[n - 1]; w++)
+                                    {
+                                        taps.push_back(offset + (w - first[n - 1]) *
+                                                                    plan.in_strides[n - 1]);
+                                    }
+                                    for (d = n - 1; d > 0; d--)
+                                    {
+                                        offset += plan.in_strides[d - 1];
+                                        if (++counter[d - 1] < last[d - 1])
+                                        {
+                                            break;
+                                        }
+                                        offset -= (last[d - 1] - first[d - 1]) *
+                                                  plan.in_strides[d - 1];
+                                        counter[d - 1] = first[d - 1];
+                                    }
+                                } while (d > 0);
+                            }
+                            f(out_index, taps);
+                        }
+                    });
+                }
+            }
+        }
+    }
+}
@@ -19,6 +19,7 @@
 #include <numeric>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/runtime/reference/gather_nd.hpp"
 
 namespace ngraph
@@ -27,6 +28,65 @@ namespace ngraph
     {
         namespace reference
         {
+            namespace fast
+            {
+                // out[outer, indices..., inner] = params[outer, indices[indices...], inner]
+                template <typename T, typename U>
+                bool gather(const T* params,
+                            const U* indices,
+                            T* out,
+                            const Shape& params_shape,
+                            const Shape& indices_shape,
+                            const Shape& out_shape,
+                            size_t axis)
+                {
+                    if (axis >= params_shape.size())
+                    {
+                        return false;
+                    }
+                    size_t outer = 1;
+                    size_t inner = 1;
+                    for (size_t i = 0; i < axis; i++)
+                    {
+                        outer *= params_shape[i];
+                    }
+                    for (size_t i = axis + 1; i < params_shape.size(); i++)
+                    {
+                        inner *= params_shape[i];
+                    }
+                    size_t axis_length = params_shape[axis];
+                    size_t num_indices = shape_size(indices_shape);
+                    if (outer * axis_length * inner == 0 || num_indices == 0 ||
+                        shape_size(out_shape) != outer * num_indices * inner)
+                    {
+                        return false;
+                    }
+
+                    // Leave out of range indices to the generic kernel, which rejects them
+                    std::vector<size_t> positions(num_indices);
+                    for (size_t j = 0; j < num_indices; j++)
+                    {
+                        U index = indices[j];
+                        index = index >= 0 ? index : index + params_shape[axis];
+                        if (static_cast<size_t>(index) >= axis_length)
+                        {
+                            return false;
+                        }
+                        positions[j] = static_cast<size_t>(index);
+                    }
+
+                    parallel_for(outer * num_indices, inner, [&](size_t begin, size_t end) {
+                        for (size_t slice = begin; slice < end; slice++)
+                        {
+                            size_t row = (slice / num_indices) * axis_length;
+                            const T* src = params + (row + positions[slice % num_indices]) * inner;
+                            std::copy(src, src + inner, out + slice * inner);
+                        }
+                    });
+                    return true;
+                }
+            }
+
             // Implement gather by calling gather_nd on sub-problems
             // # prepare constant shapes for tensors used for sub problems
             // indices'.shape  = indices.shape[-1] + [1]
@@ -51,6 +111,13 @@ namespace ngraph
                         const Shape& out_shape,
                         size_t axis)
             {
+                if (fast::is_enabled() &&
+                    fast::gather(
+                        params, indices, out, params_shape, indices_shape, out_shape, axis))
+                {
+                    return;
+                }
+
                 using namespace std;
                 // prepare shape of params_prime (remove first "axis" dimensions)
                 Shape params_prime_shape(params_shape);
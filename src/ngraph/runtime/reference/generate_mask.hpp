@@ -18,6 +18,7 @@
 
 #include <random>
 
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/state/bernoulli_rng_state.hpp"
 
 namespace ngraph
@@ -26,32 +27,48 @@ namespace ngraph
     {
         namespace reference
         {
+            /// \brief Fill out with Bernoulli(prob) values drawn from positions
+            ///    [offset, offset + count) of the random stream, or with ones when not training.
             template <typename T>
             void generate_mask(T* out,
                                size_t count,
-                               ngraph::BernoulliRNGState* rng_state,
+                               const PhiloxRNG& rng,
+                               uint64_t offset,
+                               double prob,
                                bool training)
             {
-                auto& gen = rng_state->get_generator();
-                auto& bd = rng_state->get_distribution();
+                fast::parallel_for(count, 1, [&](size_t begin, size_t end) {
+                    if (!training)
+                    {
+                        std::fill(out + begin, out + end, static_cast<T>(1));
+                        return;
+                    }
+                    rng.for_each_uniform(offset, begin, end, [&](size_t i, double u) {
+                        out[i] = static_cast<T>(u < prob);
+                    });
+                });
+            }
 
-                for (size_t i = 0; i < count; i++)
-                {
-                    out[i] = training ? static_cast<T>(bd(gen)) : static_cast<T>(1);
-                }
+            template <typename T>
+            void generate_mask(T* out,
+                               size_t count,
+                               ngraph::BernoulliRNGState* rng_state,
+                               bool training)
+            {
+                uint64_t offset = training ? rng_state->advance(count) : 0;
+                generate_mask(out,
+                              count,
+                              rng_state->get_rng(),
+                              offset,
+                              rng_state->get_probability(),
+                              training);
             }
 
             template <typename T>
             void generate_mask_no_state(
                 T* out, size_t count, bool training, uint32_t seed, double prob)
             {
-                std::mt19937 gen(seed);
-                std::bernoulli_distribution bd(prob);
-
-                for (size_t i = 0; i < count; i++)
-                {
-                    out[i] = training ? static_cast<T>(bd(gen)) : static_cast<T>(1);
-                }
+                generate_mask(out, count, PhiloxRNG(seed), 0, prob, training);
             }
         }
     }
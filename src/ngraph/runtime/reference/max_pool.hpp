@@ -20,6 +20,7 @@
 #include <numeric>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
 
 namespace ngraph
 {
@@ -121,6 +122,42 @@ namespace ngraph
                 }
             }
 
+            namespace fast
+            {
+                template <typename T>
+                bool max_pool(const T* arg,
+                              T* out,
+                              const Shape& arg_shape,
+                              const Shape& out_shape,
+                              const Shape& window_shape,
+                              const Strides& window_movement_strides,
+                              const Shape& padding_below,
+                              const Shape& padding_above)
+                {
+                    PoolingPlan plan(arg_shape,
+                                     out_shape,
+                                     window_shape,
+                                     window_movement_strides,
+                                     padding_below,
+                                     padding_above);
+                    if (!plan.valid)
+                    {
+                        return false;
+                    }
+
+                    for_each_window(plan, [&](size_t out_index, const std::vector<size_t>& taps) {
+                        T result = std::numeric_limits<T>::lowest();
+                        for (size_t tap : taps)
+                        {
+                            T x = arg[tap];
+                            result = x > result ? x : result;
+                        }
+                        out[out_index] = result;
+                    });
+                    return true;
+                }
+            }
+
             template <typename T>
             void max_pool(const T* arg,
                           T* out,
@@ -131,6 +168,18 @@ namespace ngraph
                           const Shape& padding_below,
                           const Shape& padding_above)
             {
+                if (fast::is_enabled() && fast::max_pool(arg,
+                                                         out,
+                                                         arg_shape,
+                                                         out_shape,
+                                                         window_shape,
+                                                         window_movement_strides,
+                                                         padding_below,
+                                                         padding_above))
+                {
+                    return;
+                }
+
                 // At the outermost level we will walk over every output coordinate O.
                 CoordinateTransform output_transform(out_shape);
 
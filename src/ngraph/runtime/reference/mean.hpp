@@ -30,6 +30,31 @@ namespace ngraph
     {
         namespace reference
         {
+            namespace fast
+            {
+                template <typename T>
+                bool mean(const T* arg,
+                          T* out,
+                          const Shape& in_shape,
+                          const Shape& out_shape,
+                          const AxisSet& reduction_axes)
+                {
+                    if (!sum(arg, out, in_shape, out_shape, reduction_axes))
+                    {
+                        return false;
+                    }
+                    size_t out_size = shape_size(out_shape);
+                    int count = static_cast<int>(shape_size(in_shape) / out_size);
+                    parallel_for(out_size, 1, [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            out[i] = out[i] / count;
+                        }
+                    });
+                    return true;
+                }
+            }
+
             template <typename T>
             void mean(const T* arg,
                       T* out,
@@ -37,6 +62,12 @@ namespace ngraph
                       const Shape& out_shape,
                       const AxisSet& reduction_axes)
             {
+                if (fast::is_enabled() &&
+                    fast::mean(arg, out, in_shape, out_shape, reduction_axes))
+                {
+                    return;
+                }
+
                 CoordinateTransform output_transform(out_shape);
                 std::vector<T> cs(shape_size(out_shape));
 
@@ -20,6 +20,7 @@
 #include <limits>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/shape_util.hpp"
 
 #ifdef _WIN32
@@ -32,6 +33,39 @@ namespace ngraph
     {
         namespace reference
         {
+            namespace fast
+            {
+                template <typename T>
+                bool min(const T* arg,
+                         T* out,
+                         const Shape& in_shape,
+                         const Shape& out_shape,
+                         const AxisSet& reduction_axes)
+                {
+                    ReductionPlan plan(in_shape, reduction_axes);
+                    if (!plan.applies_to(out_shape))
+                    {
+                        return false;
+                    }
+                    T minval = std::numeric_limits<T>::has_infinity
+                                   ? std::numeric_limits<T>::infinity()
+                                   : std::numeric_limits<T>::max();
+                    std::fill(out, out + plan.outer_count * plan.inner, minval);
+
+                    for_each_reduction(plan, [&](size_t out_offset, size_t in_offset, size_t n) {
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            T x = arg[in_offset + i];
+                            if (x < out[out_offset + i])
+                            {
+                                out[out_offset + i] = x;
+                            }
+                        }
+                    });
+                    return true;
+                }
+            }
+
             template <typename T>
             void min(const T* arg,
                      T* out,
@@ -39,6 +73,12 @@ namespace ngraph
                      const Shape& out_shape,
                      const AxisSet& reduction_axes)
             {
+                if (fast::is_enabled() &&
+                    fast::min(arg, out, in_shape, out_shape, reduction_axes))
+                {
+                    return;
+                }
+
                 T minval = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
                                                                 : std::numeric_limits<T>::max();
 
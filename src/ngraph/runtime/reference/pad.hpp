@@ -65,6 +65,24 @@ namespace ngraph
                 NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
                              shape_size(output_transform.get_target_shape()));
 
+                if (pad_mode == op::PadMode::CONSTANT)
+                {
+                    // Fill with the pad value, then copy the input over it
+                    size_t out_size = shape_size(out_shape);
+                    for (size_t i = 0; i < out_size; i++)
+                    {
+                        out[i] = *arg1;
+                    }
+                    input_transform.for_each_run(
+                        [&](size_t out_index, size_t in_index, size_t count, size_t in_step) {
+                            for (size_t i = 0; i < count; i++)
+                            {
+                                out[out_index + i] = arg0[in_index + i * in_step];
+                            }
+                        });
+                    return;
+                }
+
                 for (const Coordinate& in_coord : input_transform)
                 {
                     const Coordinate& out_coord = *output_it;
@@ -74,11 +92,7 @@ namespace ngraph
                     switch (pad_mode)
                     {
                     case op::PadMode::CONSTANT:
-                        // If the coordinate is out of bounds, substitute *arg1.
-                        v = input_transform.has_source_coordinate(in_coord)
-                                ? arg0[input_transform.index(in_coord)]
-                                : *arg1;
-                        break;
+                        NGRAPH_UNREACHABLE("CONSTANT padding returns before this loop");
                     case op::PadMode::EDGE:
                     {
                         Coordinate c = in_coord; // have to copy because in_coord is const
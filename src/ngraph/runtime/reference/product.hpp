@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/shape_util.hpp"
 
 namespace ngraph
@@ -27,6 +28,32 @@ namespace ngraph
     {
         namespace reference
         {
+            namespace fast
+            {
+                template <typename T>
+                bool product(const T* arg,
+                             T* out,
+                             const Shape& in_shape,
+                             const Shape& out_shape,
+                             const AxisSet& reduction_axes)
+                {
+                    ReductionPlan plan(in_shape, reduction_axes);
+                    if (!plan.applies_to(out_shape))
+                    {
+                        return false;
+                    }
+                    std::fill(out, out + plan.outer_count * plan.inner, T(1));
+
+                    for_each_reduction(plan, [&](size_t out_offset, size_t in_offset, size_t n) {
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            out[out_offset + i] = out[out_offset + i] * arg[in_offset + i];
+                        }
+                    });
+                    return true;
+                }
+            }
+
             template <typename T>
             void product(const T* arg,
                          T* out,
@@ -34,6 +61,12 @@ namespace ngraph
                          const Shape& out_shape,
                          const AxisSet& reduction_axes)
             {
+                if (fast::is_enabled() &&
+                    fast::product(arg, out, in_shape, out_shape, reduction_axes))
+                {
+                    return;
+                }
+
                 CoordinateTransform output_transform(out_shape);
 
                 for (const Coordinate& output_coord : output_transform)
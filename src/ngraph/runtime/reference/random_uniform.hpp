@@ -18,6 +18,7 @@
 
 #include <random>
 
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/state/uniform_rng_state.hpp"
 
 namespace ngraph
@@ -26,25 +27,36 @@ namespace ngraph
     {
         namespace reference
         {
+            /// \brief Fill out with the uniform values at positions [offset, offset + count) of
+            ///    the random stream. The values do not depend on how the work is split.
+            template <typename T>
+            void random_uniform(T* out,
+                                T min_val,
+                                T max_val,
+                                size_t count,
+                                const PhiloxRNG& rng,
+                                uint64_t offset)
+            {
+                fast::parallel_for(count, 1, [&](size_t begin, size_t end) {
+                    rng.for_each_uniform(offset, begin, end, [&](size_t i, double u) {
+                        out[i] = static_cast<T>(u) * (max_val - min_val) + min_val;
+                    });
+                });
+            }
+
             template <typename T>
             void random_uniform(
                 T* out, T min_val, T max_val, size_t count, ngraph::UniformRNGState* rng_state)
             {
-                auto& gen = rng_state->get_generator();
-                auto& bd = rng_state->get_distribution();
-
-                for (size_t i = 0; i < count; i++)
-                {
-                    out[i] = static_cast<T>(bd(gen)) * (max_val - min_val) + min_val;
-                }
+                random_uniform(
+                    out, min_val, max_val, count, rng_state->get_rng(), rng_state->advance(count));
             }
 
             template <typename T>
             void random_uniform_with_fixed_seed(
                 T* out, T min_val, T max_val, size_t count, size_t fixed_seed)
             {
-                ngraph::UniformRNGState rng_state(fixed_seed);
-                random_uniform(out, min_val, max_val, count, &rng_state);
+                random_uniform(out, min_val, max_val, count, PhiloxRNG(fixed_seed), 0);
             }
         }
     }
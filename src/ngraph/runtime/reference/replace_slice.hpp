@@ -38,32 +38,26 @@ namespace ngraph
                                const Shape& out_shape)
             {
                 // Step 1: Copy the entire replacement context to the output.
-                CoordinateTransform copy_transform(out_shape);
-
-                for (Coordinate copy_coord : copy_transform)
+                size_t out_size = shape_size(out_shape);
+                for (size_t i = 0; i < out_size; i++)
                 {
-                    out[copy_transform.index(copy_coord)] = arg0[copy_transform.index(copy_coord)];
+                    out[i] = arg0[i];
                 }
 
                 // Step 2: Overwrite the slice for replacement.
-                CoordinateTransform input_transform(arg1_shape);
                 CoordinateTransform output_transform(
                     out_shape, lower_bounds, upper_bounds, strides);
 
-                NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
+                NGRAPH_CHECK(shape_size(arg1_shape) ==
                              shape_size(output_transform.get_target_shape()));
 
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    const Coordinate& output_coord = *output_it;
-
-                    out[output_transform.index(output_coord)] =
-                        arg1[input_transform.index(input_coord)];
-
-                    ++output_it;
-                }
+                output_transform.for_each_run(
+                    [&](size_t in_index, size_t out_index, size_t count, size_t out_step) {
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[out_index + i * out_step] = arg1[in_index + i];
+                        }
+                    });
             }
         }
     }
@@ -43,22 +43,17 @@ namespace ngraph
 
                 CoordinateTransform input_transform(
                     in_shape, in_start_corner, in_shape, in_strides, in_axis_order);
-                CoordinateTransform output_transform(out_shape);
 
                 NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
-                             shape_size(output_transform.get_target_shape()));
-
-                CoordinateTransform::Iterator output_it = output_transform.begin();
-
-                for (const Coordinate& input_coord : input_transform)
-                {
-                    const Coordinate& output_coord = *output_it;
-
-                    out[output_transform.index(output_coord)] =
-                        arg[input_transform.index(input_coord)];
-
-                    ++output_it;
-                }
+                             shape_size(out_shape));
+
+                input_transform.for_each_run(
+                    [&](size_t out_index, size_t in_index, size_t count, size_t in_step) {
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[out_index + i] = arg[in_index + i * in_step];
+                        }
+                    });
             }
         }
     }
@@ -37,21 +37,17 @@ namespace ngraph
                        const Shape& out_shape)
             {
                 CoordinateTransform input_transform(arg_shape, lower_bounds, upper_bounds, strides);
-                CoordinateTransform output_transform(out_shape);
-
-                CoordinateTransform::Iterator output_it = output_transform.begin();
 
                 NGRAPH_CHECK(shape_size(input_transform.get_target_shape()) ==
-                             shape_size(output_transform.get_target_shape()));
-
-                for (const Coordinate& in_coord : input_transform)
-                {
-                    const Coordinate& out_coord = *output_it;
-
-                    out[output_transform.index(out_coord)] = arg[input_transform.index(in_coord)];
-
-                    ++output_it;
-                }
+                             shape_size(out_shape));
+
+                input_transform.for_each_run(
+                    [&](size_t out_index, size_t in_index, size_t count, size_t in_step) {
+                        for (size_t i = 0; i < count; i++)
+                        {
+                            out[out_index + i] = arg[in_index + i * in_step];
+                        }
+                    });
             }
         }
     }
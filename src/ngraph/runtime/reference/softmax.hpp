@@ -28,9 +28,46 @@ namespace ngraph
     {
         namespace reference
         {
+            namespace fast
+            {
+                template <typename T>
+                bool softmax(const T* arg, T* out, const Shape& shape, const AxisSet& axes)
+                {
+                    ReductionPlan plan(shape, axes);
+                    auto temp_shape = reduce(shape, axes);
+                    if (!plan.applies_to(temp_shape))
+                    {
+                        return false;
+                    }
+                    std::vector<T> temp(shape_size(temp_shape));
+
+                    max(arg, temp.data(), shape, temp_shape, axes);
+                    for_each_reduction(plan, [&](size_t temp_offset, size_t offset, size_t n) {
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            out[offset + i] = std::exp(arg[offset + i] - temp[temp_offset + i]);
+                        }
+                    });
+
+                    sum(out, temp.data(), shape, temp_shape, axes);
+                    for_each_reduction(plan, [&](size_t temp_offset, size_t offset, size_t n) {
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            out[offset + i] /= temp[temp_offset + i];
+                        }
+                    });
+                    return true;
+                }
+            }
+
             template <typename T>
             void softmax(const T* arg, T* out, const Shape& shape, const AxisSet& axes)
             {
+                if (fast::is_enabled() && fast::softmax(arg, out, shape, axes))
+                {
+                    return;
+                }
+
                 auto temp_shape = reduce(shape, axes);
                 auto temp_elements = shape_size(temp_shape);
                 auto temp_ptr = new T[temp_elements];
@@ -19,6 +19,7 @@
 #include <cmath>
 
 #include "ngraph/coordinate_transform.hpp"
+#include "ngraph/runtime/reference/fast_reference.hpp"
 #include "ngraph/shape_util.hpp"
 #include "ngraph/type/bfloat16.hpp"
 #include "ngraph/type/float16.hpp"
@@ -52,6 +53,48 @@ namespace ngraph
                 return true;
             }
 
+            namespace fast
+            {
+                template <typename T>
+                bool sum(const T* arg,
+                         T* out,
+                         const Shape& in_shape,
+                         const Shape& out_shape,
+                         const AxisSet& reduction_axes)
+                {
+                    ReductionPlan plan(in_shape, reduction_axes);
+                    if (!plan.applies_to(out_shape))
+                    {
+                        return false;
+                    }
+                    size_t out_size = plan.outer_count * plan.inner;
+                    std::vector<T> cs(out_size);
+                    std::fill(out, out + out_size, T(0));
+                    std::fill(cs.begin(), cs.end(), T(0));
+
+                    for_each_reduction(plan, [&](size_t out_offset, size_t in_offset, size_t n) {
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            T x = arg[in_offset + i];
+                            T& z = out[out_offset + i];
+
+                            if (is_finite(x) && is_finite(z))
+                            {
+                                T& c = cs[out_offset + i];
+                                T t = z + (x - c);
+                                c = (t - z) - (x - c);
+                                z = t;
+                            }
+                            else
+                            {
+                                z = z + x;
+                            }
+                        }
+                    });
+                    return true;
+                }
+            }
+
             template <typename T>
             void sum(const T* arg,
                      T* out,
@@ -59,6 +102,12 @@ namespace ngraph
                      const Shape& out_shape,
                      const AxisSet& reduction_axes)
             {
+                if (fast::is_enabled() &&
+                    fast::sum(arg, out, in_shape, out_shape, reduction_axes))
+                {
+                    return;
+                }
+
                 CoordinateTransform output_transform(out_shape);
                 std::vector<T> cs(shape_size(out_shape));
 
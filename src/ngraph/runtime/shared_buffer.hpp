@@ -0,0 +1,57 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <cstddef>
+
+#include "ngraph/runtime/aligned_buffer.hpp"
+
+namespace ngraph
+{
+    namespace runtime
+    {
+        template <typename T>
+        class SharedBuffer;
+    }
+}
+
+/// \brief An AlignedBuffer that refers to memory owned by another object rather than allocating
+/// its own. The owning object is held for the lifetime of the buffer, so the memory stays valid
+/// as long as any SharedBuffer refers to it.
+template <typename T>
+class ngraph::runtime::SharedBuffer : public ngraph::runtime::AlignedBuffer
+{
+public:
+    SharedBuffer(char* data, size_t size, const T& shared_object)
+        : m_shared_object(shared_object)
+    {
+        m_allocated_buffer = data;
+        m_aligned_buffer = data;
+        m_byte_size = size;
+    }
+
+    ~SharedBuffer() override
+    {
+        // The memory belongs to m_shared_object so keep ~AlignedBuffer from freeing it
+        m_allocated_buffer = nullptr;
+        m_aligned_buffer = nullptr;
+        m_byte_size = 0;
+    }
+
+private:
+    T m_shared_object;
+};
@@ -14,10 +14,12 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <queue>
 #include <stack>
+#include <unordered_map>
 
 #include "ngraph/cpio.hpp"
 #include "ngraph/env_util.hpp"
@@ -26,6 +28,8 @@
 #include "ngraph/log.hpp"
 #include "ngraph/ops.hpp"
 #include "ngraph/provenance.hpp"
+#include "ngraph/runtime/mapped_file.hpp"
+#include "ngraph/runtime/shared_buffer.hpp"
 #include "ngraph/serializer.hpp"
 #include "ngraph/util.hpp"
 #include "nlohmann/json.hpp"
@@ -37,6 +41,9 @@ using const_data_callback_t = shared_ptr<Node>(const string&, const element::Typ
 
 static bool s_serialize_output_shapes_enabled = getenv_bool("NGRAPH_SERIALIZER_OUTPUT_SHAPES");
 
+// Constant data in a weights file starts on a page boundary so it can be referenced in place
+static const size_t s_weights_alignment = 4096;
+
 void ngraph::set_serialize_output_shapes(bool enable)
 {
     s_serialize_output_shapes_enabled = enable;
@@ -111,6 +118,20 @@ public:
         m_binary_constant_data = binary_constant_data;
     }
 
+    void set_weights_stream(ostream* weights) { m_weights = weights; }
+
+    /// \brief Where the data of a Constant goes in the weights section
+    struct WeightsExtent
+    {
+        size_t m_offset;
+        const char* m_data;
+        size_t m_size;
+    };
+
+    /// \brief Lays out the Constant data as set_weights_stream does but, instead of writing
+    ///        it, records where each Constant goes so the caller can write it later
+    void set_weights_extents(vector<WeightsExtent>* extents) { m_weights_extents = extents; }
+
     json serialize_function(const Function& function);
     json serialize_output(const Output<Node>& output);
     json serialize_parameter_vector(const ParameterVector& parameters);
@@ -126,6 +147,9 @@ protected:
     size_t m_indent{0};
     bool m_serialize_output_shapes{false};
     bool m_binary_constant_data{false};
+    ostream* m_weights{nullptr};
+    vector<WeightsExtent>* m_weights_extents{nullptr};
+    size_t m_weights_size{0};
     json m_json_nodes;
 };
 
@@ -137,7 +161,12 @@ public:
         m_const_data_callback = const_data_callback;
     }
 
+    void set_weights(const shared_ptr<runtime::AlignedBuffer>& weights) { m_weights = weights; }
+
     shared_ptr<Function> deserialize_function(json j);
+    /// \brief Makes the function described by j from the nodes deserialized so far, without
+    ///        deserializing its "ops"
+    shared_ptr<Function> make_function(const json& j);
     Output<Node> deserialize_output(json j);
     OutputVector deserialize_output_vector(json j);
     ParameterVector deserialize_parameter_vector(json j);
@@ -153,6 +182,7 @@ protected:
     unordered_map<string, shared_ptr<Node>> m_node_map;
     unordered_map<string, shared_ptr<Function>> m_function_map;
     function<const_data_callback_t> m_const_data_callback;
+    shared_ptr<runtime::AlignedBuffer> m_weights;
 };
 
 static string
@@ -360,10 +390,491 @@ std::string ngraph::serialize(std::shared_ptr<ngraph::Function> func, size_t ind
     return ::serialize(func, indent, false);
 }
 
+void ngraph::serialize(ostream& out,
+                       ostream& weights_out,
+                       shared_ptr<ngraph::Function> func,
+                       size_t indent)
+{
+    JSONSerializer serializer;
+    serializer.set_indent(indent);
+    serializer.set_serialize_output_shapes(s_serialize_output_shapes_enabled);
+    serializer.set_weights_stream(&weights_out);
+
+    json j;
+    j.push_back(serializer.serialize_function(*func));
+    if (indent == 0)
+    {
+        out << j.dump();
+    }
+    else
+    {
+        out << j.dump(static_cast<int>(indent));
+    }
+}
+
+shared_ptr<ngraph::Function> ngraph::deserialize(istream& in, const string& weights_path)
+{
+    shared_ptr<Function> rc;
+    json js = json::parse(in);
+    JSONDeserializer deserializer;
+    auto weights = make_shared<runtime::MappedFile>(weights_path);
+    deserializer.set_weights(make_shared<runtime::SharedBuffer<shared_ptr<runtime::MappedFile>>>(
+        weights->get_ptr(), weights->size(), weights));
+    for (json func : js)
+    {
+        rc = deserializer.deserialize_function(func);
+    }
+    return rc;
+}
+
+// The binary format holds the same graph as the json one. A fixed size header is followed
+// by the table of strings used by the graph and by the function and its ops as length
+// prefixed records that refer to the strings by index. The Constant data comes last as raw
+// bytes, in a section that starts on a page boundary so it can be used in place when mapped.
+static const char s_binary_magic[8] = {'\x89', 'N', 'G', 'R', 'A', 'P', 'H', '\n'};
+static const uint32_t s_binary_version = 1;
+static const size_t s_binary_header_size = 40;
+
+enum class BinaryTag : uint8_t
+{
+    Null,
+    False,
+    True,
+    Unsigned,
+    Negative,
+    Float,
+    String,
+    Array,
+    Object
+};
+
+struct BinaryHeader
+{
+    uint64_t m_graph_size;
+    uint64_t m_weights_offset;
+    uint64_t m_weights_size;
+};
+
+template <typename T>
+static void write_le(char* out, T value)
+{
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+template <typename T>
+static T read_le(const char* in)
+{
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        value |= static_cast<T>(static_cast<uint8_t>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+static void write_varint(string& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static void write_zeros(ostream& out, size_t count)
+{
+    static const char zeros[256] = {};
+    for (; count > sizeof(zeros); count -= sizeof(zeros))
+    {
+        out.write(zeros, sizeof(zeros));
+    }
+    out.write(zeros, count);
+}
+
+/// \brief Encodes json values as binary records, interning their strings
+class BinaryWriter
+{
+public:
+    void write_count(size_t count) { write_varint(m_records, count); }
+    void write_record(const json& j)
+    {
+        m_record.clear();
+        encode(j);
+        write_varint(m_records, m_record.size());
+        m_records.append(m_record);
+    }
+
+    string get_strings() const
+    {
+        string strings;
+        write_varint(strings, m_strings.size());
+        for (const string* s : m_strings)
+        {
+            write_varint(strings, s->size());
+            strings.append(*s);
+        }
+        return strings;
+    }
+    const string& get_records() const { return m_records; }
+private:
+    void encode(const json& j)
+    {
+        switch (j.type())
+        {
+        case json::value_t::null: put(BinaryTag::Null); break;
+        case json::value_t::boolean: put(j.get<bool>() ? BinaryTag::True : BinaryTag::False); break;
+        case json::value_t::number_unsigned:
+            put(BinaryTag::Unsigned);
+            write_varint(m_record, j.get<uint64_t>());
+            break;
+        case json::value_t::number_integer:
+        {
+            int64_t value = j.get<int64_t>();
+            if (value >= 0)
+            {
+                put(BinaryTag::Unsigned);
+                write_varint(m_record, static_cast<uint64_t>(value));
+            }
+            else
+            {
+                put(BinaryTag::Negative);
+                write_varint(m_record, static_cast<uint64_t>(-(value + 1)));
+            }
+            break;
+        }
+        case json::value_t::number_float:
+        {
+            double value = j.get<double>();
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            char bytes[sizeof(bits)];
+            write_le(bytes, bits);
+            put(BinaryTag::Float);
+            m_record.append(bytes, sizeof(bytes));
+            break;
+        }
+        case json::value_t::string:
+            put(BinaryTag::String);
+            write_varint(m_record, intern(j.get_ref<const string&>()));
+            break;
+        case json::value_t::array:
+            put(BinaryTag::Array);
+            write_varint(m_record, j.size());
+            for (const json& element : j)
+            {
+                encode(element);
+            }
+            break;
+        case json::value_t::object:
+            put(BinaryTag::Object);
+            write_varint(m_record, j.size());
+            for (auto it = j.begin(); it != j.end(); ++it)
+            {
+                write_varint(m_record, intern(it.key()));
+                encode(it.value());
+            }
+            break;
+        default: throw ngraph_error("Cannot write json value of this type to a binary graph");
+        }
+    }
+
+    void put(BinaryTag tag) { m_record.push_back(static_cast<char>(tag)); }
+    size_t intern(const string& s)
+    {
+        auto it = m_string_ids.find(s);
+        if (it == m_string_ids.end())
+        {
+            it = m_string_ids.insert({s, m_strings.size()}).first;
+            m_strings.push_back(&it->first);
+        }
+        return it->second;
+    }
+
+    unordered_map<string, size_t> m_string_ids;
+    vector<const string*> m_strings;
+    string m_records;
+    string m_record;
+};
+
+/// \brief Decodes the records written by BinaryWriter
+class BinaryReader
+{
+public:
+    BinaryReader(const char* data, size_t size)
+        : m_data(data)
+        , m_size(size)
+    {
+        size_t count = read_varint();
+        m_strings.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            size_t length = read_varint();
+            m_strings.push_back(string(read_bytes(length), length));
+        }
+    }
+
+    size_t read_count() { return read_varint(); }
+    json read_record()
+    {
+        size_t length = read_varint();
+        size_t end = m_position + length;
+        check(length);
+        json j = decode();
+        if (m_position != end)
+        {
+            throw ngraph_error("Malformed record in binary graph");
+        }
+        return j;
+    }
+
+private:
+    json decode()
+    {
+        json j;
+        switch (static_cast<BinaryTag>(*read_bytes(1)))
+        {
+        case BinaryTag::Null: break;
+        case BinaryTag::False: j = false; break;
+        case BinaryTag::True: j = true; break;
+        case BinaryTag::Unsigned: j = read_varint(); break;
+        case BinaryTag::Negative: j = -static_cast<int64_t>(read_varint()) - 1; break;
+        case BinaryTag::Float:
+        {
+            uint64_t bits = read_le<uint64_t>(read_bytes(sizeof(uint64_t)));
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            j = value;
+            break;
+        }
+        case BinaryTag::String: j = read_string(); break;
+        case BinaryTag::Array:
+        {
+            j = json::array();
+            size_t count = read_varint();
+            for (size_t i = 0; i < count; ++i)
+            {
+                j.push_back(decode());
+            }
+            break;
+        }
+        case BinaryTag::Object:
+        {
+            j = json::object();
+            size_t count = read_varint();
+            for (size_t i = 0; i < count; ++i)
+            {
+                const string& key = read_string();
+                j[key] = decode();
+            }
+            break;
+        }
+        default: throw ngraph_error("Unknown value tag in binary graph");
+        }
+        return j;
+    }
+
+    const string& read_string()
+    {
+        size_t index = read_varint();
+        if (index >= m_strings.size())
+        {
+            throw ngraph_error("String index out of range in binary graph");
+        }
+        return m_strings[index];
+    }
+
+    uint64_t read_varint()
+    {
+        uint64_t value = 0;
+        for (size_t shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte = static_cast<uint8_t>(*read_bytes(1));
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw ngraph_error("Malformed integer in binary graph");
+    }
+
+    const char* read_bytes(size_t count)
+    {
+        check(count);
+        const char* bytes = m_data + m_position;
+        m_position += count;
+        return bytes;
+    }
+
+    void check(size_t count) const
+    {
+        if (count > m_size - m_position)
+        {
+            throw ngraph_error("Binary graph is truncated");
+        }
+    }
+
+    const char* m_data;
+    size_t m_size;
+    size_t m_position{0};
+    vector<string> m_strings;
+};
+
+static bool is_binary(istream& in)
+{
+    auto position = in.tellg();
+    char magic[sizeof(s_binary_magic)];
+    in.read(magic, sizeof(magic));
+    bool rc = in.gcount() == sizeof(magic) && memcmp(magic, s_binary_magic, sizeof(magic)) == 0;
+    in.clear();
+    in.seekg(position);
+    return rc;
+}
+
+static bool is_binary(const char* data, size_t size)
+{
+    return size >= sizeof(s_binary_magic) &&
+           memcmp(data, s_binary_magic, sizeof(s_binary_magic)) == 0;
+}
+
+static BinaryHeader read_binary_header(const char* data, size_t size)
+{
+    if (size < s_binary_header_size || !is_binary(data, size))
+    {
+        throw ngraph_error("Not a binary graph");
+    }
+    uint32_t version = read_le<uint32_t>(data + 8);
+    if (version != s_binary_version)
+    {
+        throw ngraph_error("Unsupported binary graph version " + to_string(version));
+    }
+    BinaryHeader header;
+    header.m_graph_size = read_le<uint64_t>(data + 16);
+    header.m_weights_offset = read_le<uint64_t>(data + 24);
+    header.m_weights_size = read_le<uint64_t>(data + 32);
+    if (header.m_weights_offset < s_binary_header_size + header.m_graph_size)
+    {
+        throw ngraph_error("Malformed binary graph header");
+    }
+    return header;
+}
+
+static shared_ptr<Function> deserialize_binary_graph(const char* graph,
+                                                     size_t graph_size,
+                                                     const shared_ptr<runtime::AlignedBuffer>& weights)
+{
+    shared_ptr<Function> rc;
+    BinaryReader reader(graph, graph_size);
+    JSONDeserializer deserializer;
+    deserializer.set_weights(weights);
+    size_t function_count = reader.read_count();
+    for (size_t i = 0; i < function_count; ++i)
+    {
+        json function = reader.read_record();
+        // Each op becomes a node as soon as it is decoded, so only one op record is held as
+        // json at a time
+        size_t op_count = reader.read_count();
+        for (size_t j = 0; j < op_count; ++j)
+        {
+            deserializer.deserialize_node(reader.read_record());
+        }
+        rc = deserializer.make_function(function);
+    }
+    return rc;
+}
+
+static shared_ptr<Function> deserialize_binary(istream& in)
+{
+    char header_data[s_binary_header_size];
+    in.read(header_data, sizeof(header_data));
+    BinaryHeader header = read_binary_header(header_data, static_cast<size_t>(in.gcount()));
+
+    vector<char> graph(header.m_graph_size);
+    in.read(graph.data(), graph.size());
+    in.ignore(header.m_weights_offset - s_binary_header_size - header.m_graph_size);
+    // The whole weights section is read with one call into a single page aligned buffer
+    auto weights = make_shared<runtime::AlignedBuffer>(header.m_weights_size, s_weights_alignment);
+    in.read(weights->get_ptr<char>(), header.m_weights_size);
+    if (!in)
+    {
+        throw ngraph_error("Binary graph is truncated");
+    }
+    return deserialize_binary_graph(graph.data(), graph.size(), weights);
+}
+
+static shared_ptr<Function> deserialize_binary(const string& path)
+{
+    // Map the file so that the Constants refer to the pages of the weights section
+    auto file = make_shared<runtime::MappedFile>(path);
+    BinaryHeader header = read_binary_header(file->get_ptr(), file->size());
+    if (header.m_weights_offset + header.m_weights_size > file->size())
+    {
+        throw ngraph_error("Binary graph '" + path + "' is truncated");
+    }
+    auto weights = make_shared<runtime::SharedBuffer<shared_ptr<runtime::MappedFile>>>(
+        file->get_ptr() + header.m_weights_offset, header.m_weights_size, file);
+    return deserialize_binary_graph(
+        file->get_ptr() + s_binary_header_size, header.m_graph_size, weights);
+}
+
+void ngraph::serialize_binary(ostream& out, shared_ptr<ngraph::Function> func)
+{
+    JSONSerializer serializer;
+    serializer.set_serialize_output_shapes(s_serialize_output_shapes_enabled);
+    vector<JSONSerializer::WeightsExtent> extents;
+    serializer.set_weights_extents(&extents);
+    json function = serializer.serialize_function(*func);
+
+    BinaryWriter writer;
+    writer.write_count(1);
+    json ops = move(function["ops"]);
+    function.erase("ops");
+    writer.write_record(function);
+    writer.write_count(ops.size());
+    for (const json& op : ops)
+    {
+        writer.write_record(op);
+    }
+    string strings = writer.get_strings();
+    const string& records = writer.get_records();
+
+    size_t graph_size = strings.size() + records.size();
+    size_t weights_offset =
+        ceil_div(s_binary_header_size + graph_size, s_weights_alignment) * s_weights_alignment;
+    size_t weights_size = extents.empty() ? 0 : extents.back().m_offset + extents.back().m_size;
+    char header[s_binary_header_size] = {};
+    memcpy(header, s_binary_magic, sizeof(s_binary_magic));
+    write_le<uint32_t>(header + 8, s_binary_version);
+    write_le<uint64_t>(header + 16, graph_size);
+    write_le<uint64_t>(header + 24, weights_offset);
+    write_le<uint64_t>(header + 32, weights_size);
+    out.write(header, sizeof(header));
+    out.write(strings.data(), strings.size());
+    out.write(records.data(), records.size());
+
+    // The Constant data is written straight from the Constants, without staging it
+    write_zeros(out, weights_offset - s_binary_header_size - graph_size);
+    size_t position = 0;
+    for (const JSONSerializer::WeightsExtent& extent : extents)
+    {
+        write_zeros(out, extent.m_offset - position);
+        out.write(extent.m_data, extent.m_size);
+        position = extent.m_offset + extent.m_size;
+    }
+}
+
 shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
 {
     shared_ptr<Function> rc;
-    if (cpio::is_cpio(in))
+    if (is_binary(in))
+    {
+        rc = deserialize_binary(in);
+    }
+    else if (cpio::is_cpio(in))
     {
         cpio::Reader reader(in);
         vector<cpio::FileInfo> file_info = reader.get_file_info();
@@ -409,14 +920,54 @@ shared_ptr<ngraph::Function> ngraph::deserialize(istream& in)
     return rc;
 }
 
+shared_ptr<ngraph::Function> ngraph::deserialize(const char* data, size_t size)
+{
+    shared_ptr<Function> rc;
+    if (is_binary(data, size))
+    {
+        BinaryHeader header = read_binary_header(data, size);
+        if (header.m_weights_offset + header.m_weights_size > size)
+        {
+            throw ngraph_error("Binary graph is truncated");
+        }
+        // The graph is read in place, the weights are copied once to outlive data
+        auto weights =
+            make_shared<runtime::AlignedBuffer>(header.m_weights_size, s_weights_alignment);
+        memcpy(weights->get_ptr(), data + header.m_weights_offset, header.m_weights_size);
+        rc = deserialize_binary_graph(data + s_binary_header_size, header.m_graph_size, weights);
+    }
+    else
+    {
+        json js = json::parse(data, data + size);
+        JSONDeserializer deserializer;
+        for (json func : js)
+        {
+            rc = deserializer.deserialize_function(func);
+        }
+    }
+    return rc;
+}
+
 shared_ptr<ngraph::Function> ngraph::deserialize(const string& s)
 {
     shared_ptr<Function> rc;
-    if (file_util::exists(s))
+    if (is_binary(s.data(), s.size()))
+    {
+        rc = deserialize(s.data(), s.size());
+    }
+    else if (file_util::exists(s))
     {
         // s is a file and not a json string
         ifstream in(s, ios_base::binary | ios_base::in);
-        rc = deserialize(in);
+        if (is_binary(in))
+        {
+            in.close();
+            rc = deserialize_binary(s);
+        }
+        else
+        {
+            rc = deserialize(in);
+        }
     }
     else
     {
@@ -679,12 +1230,17 @@ ParameterVector JSONDeserializer::deserialize_parameter_vector(json json_paramet
 
 shared_ptr<Function> JSONDeserializer::deserialize_function(json func_js)
 {
-    string func_name = func_js.at("name").get<string>();
-    vector<json> func_result = func_js.at("result");
     for (json node_js : func_js.at("ops"))
     {
         deserialize_node(node_js);
     }
+    return make_function(func_js);
+}
+
+shared_ptr<Function> JSONDeserializer::make_function(const json& func_js)
+{
+    string func_name = func_js.at("name").get<string>();
+    vector<json> func_result = func_js.at("result");
 
     // This handles both graphs w/ `op::Result` and legacy graphs w/o it
     // If we are dealing w/ a legacy graph, add op::Result for each output node
@@ -1050,8 +1606,25 @@ shared_ptr<Node> JSONDeserializer::deserialize_node(json node_js)
                 has_key(node_js, "element_type") ? node_js : node_js.at("value_type");
             auto element_type = read_element_type(type_node_js.at("element_type"));
             auto shape = type_node_js.at("shape");
-            auto value = node_js.at("value").get<vector<string>>();
-            node = make_shared<op::Constant>(element_type, shape, value);
+            if (has_key(node_js, "weights_offset"))
+            {
+                auto offset = node_js.at("weights_offset").get<size_t>();
+                auto size = node_js.at("weights_size").get<size_t>();
+                if (!m_weights || offset + size > m_weights->size())
+                {
+                    throw ngraph_error("Constant '" + node_name +
+                                       "' refers to data outside of the weights file");
+                }
+                auto buffer =
+                    make_shared<runtime::SharedBuffer<shared_ptr<runtime::AlignedBuffer>>>(
+                        m_weights->get_ptr<char>() + offset, size, m_weights);
+                node = make_shared<op::Constant>(element_type, shape, buffer);
+            }
+            else
+            {
+                auto value = node_js.at("value").get<vector<string>>();
+                node = make_shared<op::Constant>(element_type, shape, value);
+            }
             break;
         }
         case OP_TYPEID::Convert:
@@ -3359,7 +3932,28 @@ json JSONSerializer::serialize_node(const Node& n)
     case OP_TYPEID::Constant:
     {
         auto tmp = static_cast<const op::Constant*>(&n);
-        if (tmp->get_all_data_elements_bitwise_identical() && shape_size(tmp->get_shape()) > 0)
+        if ((m_weights || m_weights_extents) && !tmp->get_all_data_elements_bitwise_identical())
+        {
+            size_t offset = ceil_div(m_weights_size, s_weights_alignment) * s_weights_alignment;
+            size_t size = shape_size(tmp->get_shape()) * tmp->get_element_type().size();
+            const char* data = static_cast<const char*>(tmp->get_data_ptr());
+            if (m_weights)
+            {
+                for (; m_weights_size < offset; m_weights_size++)
+                {
+                    m_weights->put(0);
+                }
+                m_weights->write(data, size);
+            }
+            else
+            {
+                m_weights_extents->push_back({offset, data, size});
+            }
+            m_weights_size = offset + size;
+            node["weights_offset"] = offset;
+            node["weights_size"] = size;
+        }
+        else if (tmp->get_all_data_elements_bitwise_identical() && shape_size(tmp->get_shape()) > 0)
         {
             vector<string> vs;
             vs.push_back(tmp->convert_value_to_string(0));
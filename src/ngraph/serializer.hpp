@@ -48,12 +48,49 @@ namespace ngraph
     ///    indent level specified.
     void serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func, size_t indent = 0);
 
+    /// \brief Serialize a Function to a json stream, writing the data of non-uniform Constants
+    ///    to a separate weights stream. Each Constant's data starts on a 4096 byte boundary so
+    ///    that the weights can be memory mapped when deserialized.
+    /// \param out The output stream to which the json is serialized.
+    /// \param weights_out The output stream to which the Constant data is written.
+    /// \param func The Function to serialize
+    /// \param indent If 0 then there is no formatting applied and the json is the
+    ///    most compact representation. If non-zero then the json is formatted with the
+    ///    indent level specified.
+    void serialize(std::ostream& out,
+                   std::ostream& weights_out,
+                   std::shared_ptr<ngraph::Function> func,
+                   size_t indent = 0);
+
+    /// \brief Serialize a Function to a compact binary stream. The graph is written as binary
+    ///    records and the Constant data follows in a page aligned section, so a file written
+    ///    this way is memory mapped by deserialize(path) and its Constants use the mapped pages.
+    /// \param out The output stream to which the data is serialized.
+    /// \param func The Function to serialize
+    void serialize_binary(std::ostream& out, std::shared_ptr<ngraph::Function> func);
+
     /// \brief Deserialize a Function
     /// \param in An isteam to the input data
     std::shared_ptr<ngraph::Function> deserialize(std::istream& in);
 
+    /// \brief Deserialize a Function whose Constant data was written to a weights file.
+    ///    The weights file is memory mapped and the Constants refer to the mapped pages
+    ///    directly, so the data is not copied and its pages are shared between processes.
+    /// \param in An isteam to the json data
+    /// \param weights_path The weights file written alongside the json
+    std::shared_ptr<ngraph::Function> deserialize(std::istream& in,
+                                                  const std::string& weights_path);
+
+    /// \brief Deserialize a Function from memory, without copying the data to a stream first.
+    ///    Binary data written by serialize_binary is read in place, except for its Constant
+    ///    data, which is copied once so that the Function does not refer to data.
+    /// \param data The json or binary data to deserialize
+    /// \param size The size of data in bytes
+    std::shared_ptr<ngraph::Function> deserialize(const char* data, size_t size);
+
     /// \brief Deserialize a Function
-    /// \param str The json formatted string to deseriailze.
+    /// \param str The json formatted string to deseriailze, a path to a json or binary file,
+    ///    or binary data written by serialize_binary.
     std::shared_ptr<ngraph::Function> deserialize(const std::string& str);
 
     /// \brief If enabled adds output shapes to the serialized graph
@@ -33,11 +33,35 @@ void ngraph::serialize(std::ostream& out, std::shared_ptr<ngraph::Function> func
     throw std::runtime_error("serializer disabled in build");
 }
 
+void ngraph::serialize(std::ostream& out,
+                       std::ostream& weights_out,
+                       std::shared_ptr<ngraph::Function> func,
+                       size_t indent)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
+void ngraph::serialize_binary(std::ostream& out, std::shared_ptr<ngraph::Function> func)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
 std::shared_ptr<ngraph::Function> ngraph::deserialize(std::istream& in)
 {
     throw std::runtime_error("serializer disabled in build");
 }
 
+std::shared_ptr<ngraph::Function> ngraph::deserialize(std::istream& in,
+                                                      const std::string& weights_path)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
+std::shared_ptr<ngraph::Function> ngraph::deserialize(const char* data, size_t size)
+{
+    throw std::runtime_error("serializer disabled in build");
+}
+
 std::shared_ptr<ngraph::Function> ngraph::deserialize(const std::string& str)
 {
     throw std::runtime_error("serializer disabled in build");
@@ -16,30 +16,40 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <random>
 
+#include "ngraph/state/philox_rng.hpp"
 #include "state.hpp"
 
 namespace ngraph
 {
+    /// \brief State of a Bernoulli random stream, drawn from the counter based generator in the
+    ///    same way as UniformRNGState.
     class BernoulliRNGState : public State
     {
     public:
         BernoulliRNGState(unsigned int seed, double probability)
             : State()
-            , m_generator(seed)
-            , m_distribution(probability)
+            , m_rng(seed)
+            , m_probability(probability)
         {
         }
         virtual void activate() override;
         virtual void deactivate() override;
         virtual ~BernoulliRNGState() override {}
-        std::mt19937& get_generator() { return m_generator; }
-        std::bernoulli_distribution& get_distribution() { return m_distribution; }
+        const PhiloxRNG& get_rng() const { return m_rng; }
+        double get_probability() const { return m_probability; }
+        /// \brief Reserve the next count values of the stream. Calls running concurrently
+        ///    reserve disjoint parts.
+        /// \return The stream position of the first reserved value
+        uint64_t advance(uint64_t count) { return m_offset.fetch_add(count); }
+
     protected:
-        std::mt19937 m_generator;
-        std::bernoulli_distribution m_distribution;
+        PhiloxRNG m_rng;
+        double m_probability;
+        std::atomic<uint64_t> m_offset{0};
     };
 }
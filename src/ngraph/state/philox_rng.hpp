@@ -0,0 +1,100 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ngraph
+{
+    /// \brief Philox4x32-10 counter based random number generator, from "Parallel Random
+    ///    Numbers: As Easy as 1, 2, 3" (Salmon et al., SC11).
+    ///
+    /// Each 128-bit counter is mapped to four random 32-bit words under a 64-bit key, with no
+    /// state carried from one counter to the next. Any range of a random stream can therefore
+    /// be generated on its own, so a tensor can be filled by any number of threads and the
+    /// values only depend on the seed and the position in the stream.
+    class PhiloxRNG
+    {
+    public:
+        using Block = std::array<uint32_t, 4>;
+
+        PhiloxRNG(uint64_t seed)
+            : m_key{{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}}
+        {
+        }
+
+        /// \brief The four random words for a counter
+        Block operator()(Block counter) const
+        {
+            std::array<uint32_t, 2> key = m_key;
+            for (size_t round = 0; round < 10; ++round)
+            {
+                if (round > 0)
+                {
+                    key[0] += 0x9E3779B9;
+                    key[1] += 0xBB67AE85;
+                }
+                uint64_t product0 = static_cast<uint64_t>(0xD2511F53) * counter[0];
+                uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57) * counter[2];
+                counter = {{static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                            static_cast<uint32_t>(product1),
+                            static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                            static_cast<uint32_t>(product0)}};
+            }
+            return counter;
+        }
+
+        /// \brief Calls f(i, u) for each i in [begin, end), where u is the uniform double in
+        ///    [0, 1) at position offset + i of the stream. Each counter gives two values.
+        template <typename F>
+        void for_each_uniform(uint64_t offset, size_t begin, size_t end, const F& f) const
+        {
+            size_t i = begin;
+            while (i < end)
+            {
+                uint64_t position = offset + i;
+                uint64_t index = position / 2;
+                Block block = (*this)(
+                    {{static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), 0, 0}});
+                for (size_t lane = position % 2; lane < 2 && i < end; ++lane, ++i)
+                {
+                    f(i, to_uniform(block[2 * lane], block[2 * lane + 1]));
+                }
+            }
+        }
+
+        /// \brief The uniform double in [0, 1) at a position of the stream
+        double uniform(uint64_t position) const
+        {
+            double rc = 0;
+            for_each_uniform(position, 0, 1, [&](size_t, double u) { rc = u; });
+            return rc;
+        }
+
+    private:
+        static double to_uniform(uint32_t high, uint32_t low)
+        {
+            // The top 53 bits fill the mantissa of a double
+            uint64_t bits = (static_cast<uint64_t>(high) << 32 | low) >> 11;
+            return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+        }
+
+        std::array<uint32_t, 2> m_key;
+    };
+}
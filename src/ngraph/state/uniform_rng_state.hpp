@@ -16,36 +16,42 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <random>
 
+#include "ngraph/state/philox_rng.hpp"
 #include "state.hpp"
 
 namespace ngraph
 {
+    /// \brief State of a uniform random stream. Each use reserves the next part of the stream,
+    ///    which can then be generated in parallel from the counter based generator.
     class UniformRNGState : public State
     {
     public:
-        UniformRNGState(std::mt19937::result_type seed)
+        UniformRNGState(uint64_t seed)
             : State()
-            , m_generator(std::mt19937::result_type(seed))
-            , m_distribution()
+            , m_rng(seed)
         {
         }
         UniformRNGState()
             : State()
-            , m_generator(std::random_device()())
-            , m_distribution()
+            , m_rng(std::random_device()())
         {
         }
         virtual void activate() override {}
         virtual void deactivate() override {}
         virtual ~UniformRNGState() override {}
-        std::mt19937& get_generator() { return m_generator; }
-        std::uniform_real_distribution<double>& get_distribution() { return m_distribution; }
+        const PhiloxRNG& get_rng() const { return m_rng; }
+        /// \brief Reserve the next count values of the stream. Calls running concurrently
+        ///    reserve disjoint parts.
+        /// \return The stream position of the first reserved value
+        uint64_t advance(uint64_t count) { return m_offset.fetch_add(count); }
+
     private:
-        std::mt19937 m_generator;
-        std::uniform_real_distribution<double> m_distribution;
+        PhiloxRNG m_rng;
+        std::atomic<uint64_t> m_offset{0};
     };
 }
@@ -37,6 +37,12 @@
 
 #include "ngraph/type/bfloat16.hpp"
 
+#if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BULK_CONVERT_X86
+#endif
+
 using namespace std;
 using namespace ngraph;
 
@@ -49,19 +55,135 @@ bool float_isnan(const float& x)
 
 std::vector<float> bfloat16::to_float_vector(const std::vector<bfloat16>& v_bf16)
 {
-    std::vector<float> v_f32(v_bf16.begin(), v_bf16.end());
+    std::vector<float> v_f32(v_bf16.size());
+    to_float(v_bf16.data(), v_f32.data(), v_bf16.size());
     return v_f32;
 }
 
 std::vector<bfloat16> bfloat16::from_float_vector(const std::vector<float>& v_f32)
 {
-    std::vector<bfloat16> v_bf16;
-    v_bf16.reserve(v_f32.size());
-    for (float a : v_f32)
+    std::vector<bfloat16> v_bf16(v_f32.size());
+    from_float(v_f32.data(), v_bf16.data(), v_f32.size());
+    return v_bf16;
+}
+
+#ifdef BULK_CONVERT_X86
+static bool cpu_supports_avx2()
+{
+    __builtin_cpu_init();
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+static bool cpu_supports_avx512f()
+{
+    __builtin_cpu_init();
+    static const bool supported = __builtin_cpu_supports("avx512f");
+    return supported;
+}
+
+// The vector loops convert the bits as the scalar code does, returning the number of values
+// converted. The caller converts the rest.
+__attribute__((target("avx512f"))) static size_t
+    from_float_avx512(const float* in, uint16_t* out, size_t count)
+{
+    size_t i = 0;
+#if defined ROUND_MODE_TO_NEAREST_EVEN
+    const __m512i lsb = _mm512_set1_epi32(0x00010000);
+    for (; i + 16 <= count; i += 16)
     {
-        v_bf16.push_back(static_cast<bfloat16>(a));
+        __m512i x = _mm512_loadu_si512(in + i);
+        x = _mm512_add_epi32(x, _mm512_srli_epi32(_mm512_and_si512(x, lsb), 1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm512_cvtepi32_epi16(_mm512_srli_epi32(x, 16)));
+    }
+#endif
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t
+    from_float_avx2(const float* in, uint16_t* out, size_t count)
+{
+    size_t i = 0;
+#if defined ROUND_MODE_TO_NEAREST_EVEN
+    const __m256i lsb = _mm256_set1_epi32(0x00010000);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        x = _mm256_add_epi32(x, _mm256_srli_epi32(_mm256_and_si256(x, lsb), 1));
+        x = _mm256_srli_epi32(x, 16);
+        x = _mm256_permute4x64_epi64(_mm256_packus_epi32(x, x), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(x));
+    }
+#endif
+    return i;
+}
+
+__attribute__((target("avx512f"))) static size_t
+    to_float_avx512(const uint16_t* in, float* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m512i x = _mm512_cvtepu16_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+        _mm512_storeu_si512(out + i, _mm512_slli_epi32(x, 16));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t
+    to_float_avx2(const uint16_t* in, float* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i x =
+            _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_slli_epi32(x, 16));
+    }
+    return i;
+}
+#endif
+
+void bfloat16::from_float(const float* in, bfloat16* out, size_t count)
+{
+    size_t i = 0;
+#ifdef BULK_CONVERT_X86
+    uint16_t* bits = reinterpret_cast<uint16_t*>(out);
+    if (cpu_supports_avx512f())
+    {
+        i = from_float_avx512(in, bits, count);
+    }
+    else if (cpu_supports_avx2())
+    {
+        i = from_float_avx2(in, bits, count);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = bfloat16(in[i]);
+    }
+}
+
+void bfloat16::to_float(const bfloat16* in, float* out, size_t count)
+{
+    size_t i = 0;
+#ifdef BULK_CONVERT_X86
+    const uint16_t* bits = reinterpret_cast<const uint16_t*>(in);
+    if (cpu_supports_avx512f())
+    {
+        i = to_float_avx512(bits, out, count);
+    }
+    else if (cpu_supports_avx2())
+    {
+        i = to_float_avx2(bits, out, count);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = static_cast<float>(in[i]);
     }
-    return v_bf16;
 }
 
 std::string bfloat16::to_string() const
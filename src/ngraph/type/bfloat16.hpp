@@ -65,6 +65,11 @@ namespace ngraph
 
         static std::vector<float> to_float_vector(const std::vector<bfloat16>&);
         static std::vector<bfloat16> from_float_vector(const std::vector<float>&);
+        /// \brief Converts count floats to bfloat16, rounding as bfloat16(float) does. Uses AVX2
+        ///        or AVX-512 when the CPU supports them.
+        static void from_float(const float* in, bfloat16* out, size_t count);
+        /// \brief Converts count bfloat16 values to float
+        static void to_float(const bfloat16* in, float* out, size_t count);
         static constexpr bfloat16 from_bits(uint16_t bits) { return bfloat16(bits, true); }
         uint16_t to_bits() const;
         friend std::ostream& operator<<(std::ostream& out, const bfloat16& obj)
@@ -37,6 +37,12 @@
 
 #include "ngraph/type/float16.hpp"
 
+#if defined(__GNUC__) && !(__GNUC__ == 4 && __GNUC_MINOR__ == 8) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BULK_CONVERT_X86
+#endif
+
 using namespace std;
 using namespace ngraph;
 
@@ -170,3 +176,224 @@ uint16_t float16::to_bits() const
 {
     return m_value;
 }
+
+#ifdef BULK_CONVERT_X86
+static bool cpu_supports_avx2()
+{
+    __builtin_cpu_init();
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+static bool cpu_supports_avx512f()
+{
+    __builtin_cpu_init();
+    static const bool supported = __builtin_cpu_supports("avx512f");
+    return supported;
+}
+
+// The vector loops compute every case of float16(float) and operator float() and select the
+// one each lane takes, so the bits match the scalar code. They return the number of values
+// converted, the caller converts the rest.
+__attribute__((target("avx512f"))) static size_t
+    from_float_avx512(const float* in, uint16_t* out, size_t count)
+{
+    const __m512i frac_mask = _mm512_set1_epi32(0x007FFFFF);
+    const __m512i hidden_one = _mm512_set1_epi32(0x00800000);
+    const __m512i f16_inf = _mm512_set1_epi32(0x7C00);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m512i iv = _mm512_loadu_si512(in + i);
+        __m512i sign = _mm512_srli_epi32(_mm512_and_si512(iv, _mm512_set1_epi32(0x80000000)), 16);
+        __m512i biased_exp = _mm512_and_si512(_mm512_srli_epi32(iv, 23), _mm512_set1_epi32(0xFF));
+        __m512i raw_frac = _mm512_and_si512(iv, frac_mask);
+        __m512i exp = _mm512_sub_epi32(biased_exp, _mm512_set1_epi32(127));
+
+        __m512i normal = _mm512_or_si512(
+            _mm512_srli_epi32(_mm512_add_epi32(raw_frac, _mm512_set1_epi32(0x1000)), 13),
+            _mm512_slli_epi32(_mm512_add_epi32(exp, _mm512_set1_epi32(float16::exp_bias)), 10));
+        __mmask16 overflow =
+            _mm512_cmpgt_epi32_mask(exp, _mm512_set1_epi32(15)) |
+            (_mm512_cmpeq_epi32_mask(exp, _mm512_set1_epi32(15)) &
+             _mm512_cmpgt_epi32_mask(raw_frac, _mm512_set1_epi32(0x7fef00)));
+        __m512i exp_shift = _mm512_sub_epi32(_mm512_set1_epi32(-14), exp);
+        __m512i denorm = _mm512_srlv_epi32(
+            _mm512_add_epi32(
+                _mm512_or_si512(raw_frac, hidden_one),
+                _mm512_srlv_epi32(hidden_one,
+                                  _mm512_sub_epi32(_mm512_set1_epi32(11), exp_shift))),
+            _mm512_add_epi32(exp_shift, _mm512_set1_epi32(13)));
+        __m512i inf_nan = _mm512_or_si512(f16_inf, _mm512_srli_epi32(raw_frac, 13));
+
+        __m512i value = _mm512_mask_blend_epi32(overflow, normal, f16_inf);
+        value = _mm512_mask_blend_epi32(
+            _mm512_cmplt_epi32_mask(exp, _mm512_set1_epi32(-14)), value, denorm);
+        value = _mm512_mask_blend_epi32(
+            _mm512_cmpeq_epi32_mask(biased_exp, _mm512_set1_epi32(0xFF)), value, inf_nan);
+        value = _mm512_mask_blend_epi32(
+            _mm512_cmpeq_epi32_mask(biased_exp, _mm512_setzero_si512()) |
+                _mm512_cmplt_epi32_mask(exp, _mm512_set1_epi32(-14 - int32_t(float16::frac_size))),
+            value,
+            raw_frac);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm512_cvtepi32_epi16(_mm512_or_si512(value, sign)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t
+    from_float_avx2(const float* in, uint16_t* out, size_t count)
+{
+    const __m256i frac_mask = _mm256_set1_epi32(0x007FFFFF);
+    const __m256i hidden_one = _mm256_set1_epi32(0x00800000);
+    const __m256i f16_inf = _mm256_set1_epi32(0x7C00);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i iv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i sign = _mm256_srli_epi32(_mm256_and_si256(iv, _mm256_set1_epi32(0x80000000)), 16);
+        __m256i biased_exp = _mm256_and_si256(_mm256_srli_epi32(iv, 23), _mm256_set1_epi32(0xFF));
+        __m256i raw_frac = _mm256_and_si256(iv, frac_mask);
+        __m256i exp = _mm256_sub_epi32(biased_exp, _mm256_set1_epi32(127));
+
+        __m256i normal = _mm256_or_si256(
+            _mm256_srli_epi32(_mm256_add_epi32(raw_frac, _mm256_set1_epi32(0x1000)), 13),
+            _mm256_slli_epi32(_mm256_add_epi32(exp, _mm256_set1_epi32(float16::exp_bias)), 10));
+        __m256i overflow = _mm256_or_si256(
+            _mm256_cmpgt_epi32(exp, _mm256_set1_epi32(15)),
+            _mm256_and_si256(_mm256_cmpeq_epi32(exp, _mm256_set1_epi32(15)),
+                             _mm256_cmpgt_epi32(raw_frac, _mm256_set1_epi32(0x7fef00))));
+        __m256i exp_shift = _mm256_sub_epi32(_mm256_set1_epi32(-14), exp);
+        __m256i denorm = _mm256_srlv_epi32(
+            _mm256_add_epi32(
+                _mm256_or_si256(raw_frac, hidden_one),
+                _mm256_srlv_epi32(hidden_one,
+                                  _mm256_sub_epi32(_mm256_set1_epi32(11), exp_shift))),
+            _mm256_add_epi32(exp_shift, _mm256_set1_epi32(13)));
+        __m256i inf_nan = _mm256_or_si256(f16_inf, _mm256_srli_epi32(raw_frac, 13));
+
+        __m256i value = _mm256_blendv_epi8(normal, f16_inf, overflow);
+        value = _mm256_blendv_epi8(
+            value, denorm, _mm256_cmpgt_epi32(_mm256_set1_epi32(-14), exp));
+        value = _mm256_blendv_epi8(
+            value, inf_nan, _mm256_cmpeq_epi32(biased_exp, _mm256_set1_epi32(0xFF)));
+        value = _mm256_blendv_epi8(
+            value,
+            raw_frac,
+            _mm256_or_si256(
+                _mm256_cmpeq_epi32(biased_exp, _mm256_setzero_si256()),
+                _mm256_cmpgt_epi32(_mm256_set1_epi32(-14 - int32_t(float16::frac_size)), exp)));
+        // The scalar code keeps the low 16 bits
+        value = _mm256_and_si256(_mm256_or_si256(value, sign), _mm256_set1_epi32(0xFFFF));
+        value = _mm256_permute4x64_epi64(_mm256_packus_epi32(value, value), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(value));
+    }
+    return i;
+}
+
+__attribute__((target("avx512f"))) static size_t
+    to_float_avx512(const uint16_t* in, float* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        __m512i h =
+            _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+        __m512i sign = _mm512_slli_epi32(_mm512_and_si512(h, _mm512_set1_epi32(0x8000)), 16);
+        __m512i exp =
+            _mm512_and_si512(_mm512_srli_epi32(h, float16::frac_size), _mm512_set1_epi32(0x1F));
+        __m512i frac = _mm512_and_si512(h, _mm512_set1_epi32(0x03FF));
+        __m512i shifted_frac = _mm512_slli_epi32(frac, 23 - float16::frac_size);
+
+        __m512i value = _mm512_or_si512(
+            _mm512_slli_epi32(
+                _mm512_add_epi32(exp, _mm512_set1_epi32(127 - float16::exp_bias)), 23),
+            shifted_frac);
+        value = _mm512_mask_blend_epi32(
+            _mm512_cmpeq_epi32_mask(exp, _mm512_set1_epi32(0x1F)),
+            value,
+            _mm512_or_si512(_mm512_set1_epi32(0x7F800000), shifted_frac));
+        // A denormal is frac * 2^-24, which a float holds exactly
+        value = _mm512_mask_blend_epi32(
+            _mm512_cmpeq_epi32_mask(exp, _mm512_setzero_si512()),
+            value,
+            _mm512_castps_si512(
+                _mm512_mul_ps(_mm512_cvtepi32_ps(frac), _mm512_set1_ps(1.0f / (1 << 24)))));
+        _mm512_storeu_si512(out + i, _mm512_or_si512(value, sign));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t
+    to_float_avx2(const uint16_t* in, float* out, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i h =
+            _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        __m256i sign = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0x8000)), 16);
+        __m256i exp =
+            _mm256_and_si256(_mm256_srli_epi32(h, float16::frac_size), _mm256_set1_epi32(0x1F));
+        __m256i frac = _mm256_and_si256(h, _mm256_set1_epi32(0x03FF));
+        __m256i shifted_frac = _mm256_slli_epi32(frac, 23 - float16::frac_size);
+
+        __m256i value = _mm256_or_si256(
+            _mm256_slli_epi32(
+                _mm256_add_epi32(exp, _mm256_set1_epi32(127 - float16::exp_bias)), 23),
+            shifted_frac);
+        value = _mm256_blendv_epi8(value,
+                                   _mm256_or_si256(_mm256_set1_epi32(0x7F800000), shifted_frac),
+                                   _mm256_cmpeq_epi32(exp, _mm256_set1_epi32(0x1F)));
+        // A denormal is frac * 2^-24, which a float holds exactly
+        value = _mm256_blendv_epi8(
+            value,
+            _mm256_castps_si256(
+                _mm256_mul_ps(_mm256_cvtepi32_ps(frac), _mm256_set1_ps(1.0f / (1 << 24)))),
+            _mm256_cmpeq_epi32(exp, _mm256_setzero_si256()));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_or_si256(value, sign));
+    }
+    return i;
+}
+#endif
+
+void float16::from_float(const float* in, float16* out, size_t count)
+{
+    size_t i = 0;
+#ifdef BULK_CONVERT_X86
+    uint16_t* bits = reinterpret_cast<uint16_t*>(out);
+    if (cpu_supports_avx512f())
+    {
+        i = from_float_avx512(in, bits, count);
+    }
+    else if (cpu_supports_avx2())
+    {
+        i = from_float_avx2(in, bits, count);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = float16(in[i]);
+    }
+}
+
+void float16::to_float(const float16* in, float* out, size_t count)
+{
+    size_t i = 0;
+#ifdef BULK_CONVERT_X86
+    const uint16_t* bits = reinterpret_cast<const uint16_t*>(in);
+    if (cpu_supports_avx512f())
+    {
+        i = to_float_avx512(bits, out, count);
+    }
+    else if (cpu_supports_avx2())
+    {
+        i = to_float_avx2(bits, out, count);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = static_cast<float>(in[i]);
+    }
+}
@@ -58,6 +58,11 @@ namespace ngraph
         bool operator>=(const float16& other) const;
         operator float() const;
 
+        /// \brief Converts count floats to float16, rounding as float16(float) does. Uses AVX2
+        ///        or AVX-512 when the CPU supports them.
+        static void from_float(const float* in, float16* out, size_t count);
+        /// \brief Converts count float16 values to float
+        static void to_float(const float16* in, float* out, size_t count);
         static constexpr float16 from_bits(uint16_t bits) { return float16(bits, true); }
         uint16_t to_bits() const;
         friend std::ostream& operator<<(std::ostream& out, const float16& obj)
@@ -16,6 +16,8 @@
 
 #include <array>
 #include <condition_variable>
+#include <deque>
+#include <future>
 #include <mutex>
 #include <thread>
 
@@ -189,3 +191,114 @@ vector<runtime::PerformanceCounter> run_benchmark_pipelined(shared_ptr<Function>
     vector<runtime::PerformanceCounter> perf_data = exec->get_performance_data();
     return perf_data;
 }
+
+vector<runtime::PerformanceCounter> run_benchmark_async(shared_ptr<Function> f,
+                                                        const string& backend_name,
+                                                        size_t iterations,
+                                                        bool timing_detail,
+                                                        int warmup_iterations)
+{
+    stopwatch timer;
+    timer.start();
+    auto backend = runtime::Backend::create(backend_name);
+    auto exec = backend->compile(f, timing_detail);
+    timer.stop();
+    stringstream ss;
+    ss.imbue(locale(""));
+    ss << "compile time: " << timer.get_milliseconds() << "ms" << endl;
+    set_denormals_flush_to_zero();
+
+    size_t pipeline_depth = max<size_t>(exec->get_preferred_pipeline_depth(), 1);
+    vector<TensorCollection> tensor_collections(pipeline_depth);
+    for (size_t i = 0; i < pipeline_depth; i++)
+    {
+        for (shared_ptr<op::Parameter> param : f->get_parameters())
+        {
+            auto tensor_data =
+                make_shared<runtime::HostTensor>(param->get_element_type(), param->get_shape());
+            random_init(tensor_data);
+            tensor_collections[i].parameter_data.push_back(tensor_data);
+        }
+        for (shared_ptr<Node> result : f->get_results())
+        {
+            auto tensor_data =
+                make_shared<runtime::HostTensor>(result->get_element_type(), result->get_shape());
+            tensor_collections[i].result_data.push_back(tensor_data);
+        }
+    }
+    for (size_t input_index = 0; input_index < f->get_parameters().size(); input_index++)
+    {
+        auto input_tensors = exec->create_input_tensor(input_index, pipeline_depth);
+        for (size_t i = 0; i < pipeline_depth; i++)
+        {
+            tensor_collections[i].input_tensors.push_back(input_tensors[i]);
+        }
+    }
+    for (size_t output_index = 0; output_index < f->get_results().size(); output_index++)
+    {
+        auto output_tensors = exec->create_output_tensor(output_index, pipeline_depth);
+        for (size_t i = 0; i < pipeline_depth; i++)
+        {
+            tensor_collections[i].output_tensors.push_back(output_tensors[i]);
+        }
+    }
+
+    // Reading the outputs of an iteration happens after the next one has been started
+    deque<pair<future<bool>, size_t>> in_flight;
+    auto retire = [&]() {
+        in_flight.front().first.get();
+        TensorCollection& tensors = tensor_collections[in_flight.front().second];
+        for (size_t i = 0; i < tensors.output_tensors.size(); i++)
+        {
+            const shared_ptr<runtime::HostTensor>& data = tensors.result_data[i];
+            tensors.output_tensors[i]->wait_for_read_ready();
+            tensors.output_tensors[i]->read(
+                data->get_data_ptr(), data->get_element_count() * data->get_element_type().size());
+        }
+        in_flight.pop_front();
+    };
+
+    stopwatch benchmark_timer;
+    size_t total_iterations = iterations + warmup_iterations;
+    for (size_t iteration = 0; iteration < total_iterations; iteration++)
+    {
+        if (iteration == static_cast<size_t>(warmup_iterations))
+        {
+            while (!in_flight.empty())
+            {
+                retire();
+            }
+            benchmark_timer.start();
+        }
+        size_t stage = iteration % pipeline_depth;
+        if (in_flight.size() == pipeline_depth)
+        {
+            retire();
+        }
+        TensorCollection& tensors = tensor_collections[stage];
+        for (size_t i = 0; i < tensors.input_tensors.size(); i++)
+        {
+            const shared_ptr<runtime::HostTensor>& data = tensors.parameter_data[i];
+            tensors.input_tensors[i]->wait_for_write_ready();
+            tensors.input_tensors[i]->write(
+                data->get_data_ptr(), data->get_element_count() * data->get_element_type().size());
+        }
+        in_flight.emplace_back(exec->call_async(tensors.output_tensors, tensors.input_tensors),
+                               stage);
+        if (in_flight.size() > 1)
+        {
+            retire();
+        }
+    }
+    while (!in_flight.empty())
+    {
+        retire();
+    }
+    benchmark_timer.stop();
+
+    ss << benchmark_timer.get_milliseconds() / static_cast<float>(iterations)
+       << "ms per iteration" << endl;
+    cout << ss.str();
+
+    return exec->get_performance_data();
+}
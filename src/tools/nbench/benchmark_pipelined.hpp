@@ -31,3 +31,12 @@ std::vector<ngraph::runtime::PerformanceCounter>
                             bool timing_detail,
                             int warmup_iterations,
                             bool copy_data);
+
+/// \brief Benchmarks Executable::call_async, writing the inputs of the next iteration and reading
+///        the outputs of the previous one while the current iteration executes.
+std::vector<ngraph::runtime::PerformanceCounter>
+    run_benchmark_async(std::shared_ptr<ngraph::Function> f,
+                        const std::string& backend_name,
+                        size_t iterations,
+                        bool timing_detail,
+                        int warmup_iterations);
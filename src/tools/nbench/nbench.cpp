@@ -154,6 +154,52 @@ void print_times(const multimap<size_t, string>& timing)
     }
 }
 
+// Only backends that collect hardware counters fill these in, e.g. CPU with
+// NGRAPH_CPU_HW_COUNTERS=1
+void print_hw_counters(const vector<PerfShape>& perf_data)
+{
+    map<string, runtime::PerformanceCounter> totals;
+    for (const PerfShape& p : perf_data)
+    {
+        if (p.cycles() == 0)
+        {
+            continue;
+        }
+        string op = p.get_node()->description();
+        auto it = totals.insert({op, runtime::PerformanceCounter(p.get_node(), 0, 0)}).first;
+        runtime::PerformanceCounter& total = it->second;
+        total.m_total_microseconds += p.total_microseconds();
+        total.m_call_count += p.call_count();
+        total.m_cycles += p.cycles();
+        total.m_instructions += p.instructions();
+        total.m_llc_misses += p.llc_misses();
+        total.m_bytes += p.bytes();
+    }
+    if (totals.empty())
+    {
+        return;
+    }
+
+    ios_base::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
+    cout << "\n---- Hardware counters per op type ----\n";
+    cout << setw(24) << left << "op" << right << setw(16) << "cycles" << setw(16)
+         << "instructions" << setw(8) << "IPC" << setw(14) << "LLC misses" << setw(10) << "GB/s"
+         << setw(12) << "inst/byte"
+         << "\n";
+    for (auto& t : totals)
+    {
+        const runtime::PerformanceCounter& p = t.second;
+        cout << setw(24) << left << t.first << right << setw(16) << p.cycles() << setw(16)
+             << p.instructions() << setw(8) << fixed << setprecision(2)
+             << static_cast<double>(p.instructions()) / p.cycles() << setw(14) << p.llc_misses()
+             << setw(10) << p.gigabytes_per_second() << setw(12) << p.instructions_per_byte()
+             << "\n";
+    }
+    cout.flags(flags);
+    cout.precision(precision);
+}
+
 void print_results(vector<PerfShape> perf_data, bool timing_detail)
 {
     sort(perf_data.begin(), perf_data.end(), [](const PerfShape& p1, const PerfShape& p2) {
@@ -169,6 +215,8 @@ void print_results(vector<PerfShape> perf_data, bool timing_detail)
 
         cout << "\n---- Aggregate times per op type/shape/count ----\n";
         print_times(timing_details);
+
+        print_hw_counters(perf_data);
     }
 }
 
@@ -186,6 +234,7 @@ int main(int argc, char** argv)
     bool copy_data = true;
     bool dot_file = false;
     bool double_buffer = false;
+    bool async_call = false;
 
     configure_static_backends();
     for (int i = 1; i < argc; i++)
@@ -239,6 +288,10 @@ int main(int argc, char** argv)
         {
             double_buffer = true;
         }
+        else if (arg == "--async")
+        {
+            async_call = true;
+        }
         else if (arg == "-w" || arg == "--warmup_iterations")
         {
             try
@@ -294,6 +347,7 @@ OPTIONS
         --no_copy_data            Disable copy of input/result data every iteration
         --dot                     Generate Graphviz dot file
         --double_buffer           Double buffer inputs and outputs
+        --async                   Pipeline inputs and outputs with Executable::call_async
 )###";
         return 1;
     }
@@ -439,7 +493,12 @@ OPTIONS
                 ss << t1.get_milliseconds();
                 cout << "deserialize took " << ss.str() << "ms\n";
                 vector<runtime::PerformanceCounter> perf_data;
-                if (double_buffer)
+                if (async_call)
+                {
+                    perf_data = run_benchmark_async(
+                        f, backend, iterations, timing_detail, warmup_iterations);
+                }
+                else if (double_buffer)
                 {
                     perf_data = run_benchmark_pipelined(
                         f, backend, iterations, timing_detail, warmup_iterations, copy_data);
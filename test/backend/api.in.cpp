@@ -14,6 +14,9 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <deque>
+#include <future>
+
 #include "gtest/gtest.h"
 #include "ngraph/ngraph.hpp"
 #include "util/all_close_f.hpp"
@@ -53,6 +56,66 @@ NGRAPH_TEST(${BACKEND_NAME}, create_tensor_1)
     EXPECT_TRUE(test::all_close_f(read_vector<float>(result), expected, MIN_FLOAT_TOLERANCE_BITS));
 }
 
+NGRAPH_TEST(${BACKEND_NAME}, call_async_pipelined)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Multiply>(A, B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}");
+    auto handle = backend->compile(f);
+
+    const size_t pipeline_depth = 2;
+    vector<vector<shared_ptr<runtime::Tensor>>> inputs(pipeline_depth);
+    vector<vector<shared_ptr<runtime::Tensor>>> outputs(pipeline_depth);
+    for (size_t i = 0; i < pipeline_depth; i++)
+    {
+        inputs[i] = {backend->create_tensor(element::f32, shape),
+                     backend->create_tensor(element::f32, shape)};
+        outputs[i] = {backend->create_tensor(element::f32, shape)};
+    }
+
+    // Write iteration N+1 and read iteration N-1 while iteration N runs
+    deque<pair<future<bool>, size_t>> in_flight;
+    vector<vector<float>> results;
+    auto retire = [&]() {
+        EXPECT_TRUE(in_flight.front().first.get());
+        auto& output = outputs[in_flight.front().second][0];
+        output->wait_for_read_ready();
+        results.push_back(read_vector<float>(output));
+        in_flight.pop_front();
+    };
+    const size_t iterations = 6;
+    for (size_t iteration = 0; iteration < iterations; iteration++)
+    {
+        size_t stage = iteration % pipeline_depth;
+        float x = static_cast<float>(iteration);
+        for (auto& input : inputs[stage])
+        {
+            input->wait_for_write_ready();
+        }
+        copy_data(inputs[stage][0], vector<float>{x, x, x, x});
+        copy_data(inputs[stage][1], vector<float>{1, 2, 3, 4});
+        in_flight.emplace_back(handle->call_async(outputs[stage], inputs[stage]), stage);
+        if (in_flight.size() == pipeline_depth)
+        {
+            retire();
+        }
+    }
+    while (!in_flight.empty())
+    {
+        retire();
+    }
+
+    ASSERT_EQ(results.size(), iterations);
+    for (size_t iteration = 0; iteration < iterations; iteration++)
+    {
+        float x = static_cast<float>(iteration);
+        EXPECT_TRUE(test::all_close_f(results[iteration], vector<float>{x, 2 * x, 3 * x, 4 * x}));
+    }
+}
+
 // This tests a backend's implementation of the copy_from for tensor
 NGRAPH_TEST(${BACKEND_NAME}, tensor_copy_from)
 {
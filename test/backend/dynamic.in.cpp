@@ -14,8 +14,11 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/runtime/dynamic/dynamic_backend.hpp"
 #include "util/all_close_f.hpp"
 #include "util/test_control.hpp"
 #include "util/test_tools.hpp"
@@ -292,3 +295,252 @@ NGRAPH_TEST(${BACKEND_NAME}, dynamic_reverse_shape)
                         Shape{8, 2, 8, 2},
                         Shape{2, 3, 4, 5, 2}});
 }
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_shape_buckets)
+{
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{2, Dimension::dynamic(), 3});
+    auto b = make_shared<op::Parameter>(element::f32, PartialShape{2, Dimension::dynamic(), 3});
+    auto f = make_shared<Function>(NodeVector{a * b}, ParameterVector{a, b});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    ASSERT_NE(ex, nullptr);
+    ex->set_shape_buckets({8, 4});
+
+    auto t_r =
+        backend->create_dynamic_tensor(element::f32, PartialShape{2, Dimension::dynamic(), 3});
+
+    for (size_t middle_dim : {1, 3, 4, 5, 9})
+    {
+        Shape shape{2, middle_dim, 3};
+        vector<float> inputs(shape_size(shape));
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            inputs[i] = i + 1;
+        }
+        auto t_a = backend->create_tensor(element::f32, shape);
+        auto t_b = backend->create_tensor(element::f32, shape);
+        copy_data(t_a, inputs);
+        copy_data(t_b, inputs);
+
+        ex->call_with_validate({t_r}, {t_a, t_b});
+
+        // The result is sliced back to the unpadded shape
+        ASSERT_EQ(t_r->get_shape(), shape);
+        auto results = read_vector<float>(t_r);
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            EXPECT_EQ(results[i], inputs[i] * inputs[i]);
+        }
+    }
+
+    auto stats = ex->get_cache_statistics();
+    EXPECT_EQ(stats.m_hits, 2);
+    EXPECT_EQ(stats.m_misses, 3);
+
+    // Precompiling a shape whose bucket is already cached is free
+    ex->precompile({Shape{2, 7, 3}, Shape{2, 7, 3}}).get();
+    EXPECT_EQ(ex->get_cache_statistics().m_misses, 3);
+    ex->precompile({Shape{2, 16, 3}, Shape{2, 16, 3}}).get();
+    EXPECT_EQ(ex->get_cache_statistics().m_misses, 4);
+
+    // Reversing moves the padding to the front, so it cannot be bucketed
+    auto reverse =
+        make_shared<Function>(make_shared<op::Reverse>(a, AxisSet{1}), ParameterVector{a});
+    auto reverse_ex =
+        dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(reverse));
+    ASSERT_NE(reverse_ex, nullptr);
+    EXPECT_ANY_THROW(reverse_ex->set_shape_buckets({8, 4}));
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_shape_buckets_reductions)
+{
+    // Exp makes the padding nonzero, so the sum masks it; the max masks it in any case
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{2, Dimension::dynamic()});
+    auto sum = make_shared<op::Sum>(make_shared<op::Exp>(a), AxisSet{1});
+    auto largest = make_shared<op::Max>(make_shared<op::Negative>(a), AxisSet{1});
+    auto softmax = make_shared<op::Softmax>(a, AxisSet{1});
+    auto f = make_shared<Function>(NodeVector{sum, largest, softmax}, ParameterVector{a});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    ASSERT_NE(ex, nullptr);
+    ex->set_shape_buckets({4, 8});
+
+    auto t_sum = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    auto t_max = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    auto t_softmax = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    for (size_t length : {1, 3, 4, 6})
+    {
+        Shape shape{2, length};
+        vector<float> inputs(shape_size(shape));
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            inputs[i] = 0.25f * i + 1;
+        }
+        auto t_a = backend->create_tensor(element::f32, shape);
+        copy_data(t_a, inputs);
+
+        ex->call_with_validate({t_sum, t_max, t_softmax}, {t_a});
+
+        ASSERT_EQ(t_sum->get_shape(), (Shape{2}));
+        ASSERT_EQ(t_max->get_shape(), (Shape{2}));
+        ASSERT_EQ(t_softmax->get_shape(), shape);
+        vector<float> expected_sum(2, 0);
+        vector<float> expected_max(2, numeric_limits<float>::lowest());
+        vector<float> expected_softmax(inputs.size());
+        for (size_t row = 0; row < 2; row++)
+        {
+            for (size_t i = row * length; i < (row + 1) * length; i++)
+            {
+                expected_sum[row] += exp(inputs[i]);
+                expected_max[row] = max(expected_max[row], -inputs[i]);
+            }
+            for (size_t i = row * length; i < (row + 1) * length; i++)
+            {
+                expected_softmax[i] = exp(inputs[i]) / expected_sum[row];
+            }
+        }
+        EXPECT_TRUE(test::all_close_f(expected_sum, read_vector<float>(t_sum)));
+        EXPECT_TRUE(test::all_close_f(expected_max, read_vector<float>(t_max)));
+        EXPECT_TRUE(test::all_close_f(expected_softmax, read_vector<float>(t_softmax)));
+    }
+    EXPECT_EQ(ex->get_cache_statistics().m_misses, 2);
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_shape_buckets_attention)
+{
+    // softmax(q k^T) v for a variable number of queries and of keys
+    size_t depth = 2;
+    auto q = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 2});
+    auto k = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 2});
+    auto v = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic(), 2});
+    auto k_t = make_shared<op::Transpose>(
+        k, op::Constant::create(element::i64, Shape{2}, vector<int64_t>{1, 0}));
+    auto scores = make_shared<op::Softmax>(make_shared<op::Dot>(q, k_t), AxisSet{1});
+    auto f = make_shared<Function>(make_shared<op::Dot>(scores, v), ParameterVector{q, k, v});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    ASSERT_NE(ex, nullptr);
+    ex->set_shape_buckets({4, 8});
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    for (auto lengths : vector<pair<size_t, size_t>>{{1, 1}, {3, 5}, {2, 8}})
+    {
+        size_t num_queries = lengths.first;
+        size_t num_keys = lengths.second;
+        vector<float> q_data(num_queries * depth);
+        vector<float> k_data(num_keys * depth);
+        vector<float> v_data(num_keys * depth);
+        for (size_t i = 0; i < q_data.size(); i++)
+        {
+            q_data[i] = 0.5f * i - 1;
+        }
+        for (size_t i = 0; i < k_data.size(); i++)
+        {
+            k_data[i] = 0.25f * i;
+            v_data[i] = i + 1.f;
+        }
+        auto t_q = backend->create_tensor(element::f32, Shape{num_queries, depth});
+        auto t_k = backend->create_tensor(element::f32, Shape{num_keys, depth});
+        auto t_v = backend->create_tensor(element::f32, Shape{num_keys, depth});
+        copy_data(t_q, q_data);
+        copy_data(t_k, k_data);
+        copy_data(t_v, v_data);
+
+        ex->call_with_validate({t_r}, {t_q, t_k, t_v});
+
+        ASSERT_EQ(t_r->get_shape(), (Shape{num_queries, depth}));
+        vector<float> expected(num_queries * depth, 0);
+        for (size_t i = 0; i < num_queries; i++)
+        {
+            vector<float> weights(num_keys);
+            float total = 0;
+            for (size_t j = 0; j < num_keys; j++)
+            {
+                float score = 0;
+                for (size_t d = 0; d < depth; d++)
+                {
+                    score += q_data[i * depth + d] * k_data[j * depth + d];
+                }
+                weights[j] = exp(score);
+                total += weights[j];
+            }
+            for (size_t j = 0; j < num_keys; j++)
+            {
+                for (size_t d = 0; d < depth; d++)
+                {
+                    expected[i * depth + d] += weights[j] / total * v_data[j * depth + d];
+                }
+            }
+        }
+        EXPECT_TRUE(test::all_close_f(expected, read_vector<float>(t_r)));
+    }
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_cache_capacity_bytes)
+{
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape{Dimension::dynamic()});
+    auto f = make_shared<Function>(make_shared<op::Negative>(a), ParameterVector{a});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    ASSERT_NE(ex, nullptr);
+    // Room for the parameter and the negation of 16 floats, but not of 32
+    ex->set_cache_capacity_bytes(2 * 16 * sizeof(float));
+
+    auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+    for (size_t length : {16, 8, 16, 32, 16})
+    {
+        auto t_a = backend->create_tensor(element::f32, Shape{length});
+        copy_data(t_a, vector<float>(length, 1));
+        ex->call_with_validate({t_r}, {t_a});
+        EXPECT_EQ(read_vector<float>(t_r), vector<float>(length, -1));
+    }
+    // 16 is evicted to make room for 8, and everything for 32
+    auto stats = ex->get_cache_statistics();
+    EXPECT_EQ(stats.m_hits, 0);
+    EXPECT_EQ(stats.m_misses, 5);
+}
+
+NGRAPH_TEST(${BACKEND_NAME}, dynamic_concurrent_calls_compile_once)
+{
+    auto a = make_shared<op::Parameter>(element::f32, PartialShape::dynamic());
+    auto b = make_shared<op::Parameter>(element::f32, PartialShape::dynamic());
+    auto f = make_shared<Function>(make_shared<op::Add>(a, b), ParameterVector{a, b});
+
+    auto backend = runtime::Backend::create("${BACKEND_NAME}", true);
+    auto ex = dynamic_pointer_cast<runtime::dynamic::DynamicExecutable>(backend->compile(f));
+    ASSERT_NE(ex, nullptr);
+
+    const size_t num_threads = 8;
+    Shape shape{2, 3};
+    vector<float> inputs{1, 2, 3, 4, 5, 6};
+    vector<thread> threads;
+    vector<vector<float>> results(num_threads);
+    for (size_t i = 0; i < num_threads; i++)
+    {
+        threads.emplace_back([&, i]() {
+            auto t_a = backend->create_tensor(element::f32, shape);
+            auto t_b = backend->create_tensor(element::f32, shape);
+            auto t_r = backend->create_dynamic_tensor(element::f32, PartialShape::dynamic());
+            copy_data(t_a, inputs);
+            copy_data(t_b, inputs);
+            ex->call({t_r}, {t_a, t_b});
+            results[i] = read_vector<float>(t_r);
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    for (auto& result : results)
+    {
+        EXPECT_TRUE(test::all_close_f(vector<float>{2, 4, 6, 8, 10, 12}, result));
+    }
+    auto stats = ex->get_cache_statistics();
+    EXPECT_EQ(stats.m_misses, 1);
+    EXPECT_EQ(stats.m_hits, num_threads - 1);
+}
@@ -17,6 +17,7 @@
 #include "gtest/gtest.h"
 #include "ngraph/ngraph.hpp"
 #include "ngraph/runtime/backend.hpp"
+#include "ngraph/runtime/batching_executor.hpp"
 #include "ngraph/util.hpp"
 #include "util/all_close_f.hpp"
 #include "util/test_tools.hpp"
@@ -91,6 +92,51 @@ TEST(backend_api, save_load)
 }
 #endif
 
+TEST(backend_api, batching_executor)
+{
+    PartialShape shape{Dimension::dynamic(), 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Add>(A, B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("INTERPRETER");
+    runtime::BatchingExecutor executor(backend, f, {1, 2, 4}, chrono::milliseconds(200));
+    EXPECT_EQ(executor.get_max_batch_size(), 4);
+
+    vector<future<runtime::BatchingExecutor::Result>> futures;
+    vector<vector<float>> expected;
+    for (size_t batch : {1, 2, 1})
+    {
+        auto a = backend->create_tensor(element::f32, Shape{batch, 2});
+        auto b = backend->create_tensor(element::f32, Shape{batch, 2});
+        vector<float> a_data(batch * 2);
+        vector<float> b_data(batch * 2);
+        vector<float> sum(batch * 2);
+        for (size_t i = 0; i < sum.size(); i++)
+        {
+            a_data[i] = static_cast<float>(futures.size() * 10 + i);
+            b_data[i] = 1.f;
+            sum[i] = a_data[i] + b_data[i];
+        }
+        copy_data(a, a_data);
+        copy_data(b, b_data);
+        futures.push_back(executor.submit({a, b}));
+        expected.push_back(sum);
+    }
+
+    for (size_t i = 0; i < futures.size(); i++)
+    {
+        auto result = futures[i].get();
+        ASSERT_EQ(result.size(), 1);
+        EXPECT_EQ(result[0]->get_shape(), (Shape{expected[i].size() / 2, 2}));
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(result[0]), expected[i]));
+    }
+    EXPECT_LT(executor.get_call_count(), futures.size());
+
+    auto too_big = backend->create_tensor(element::f32, Shape{5, 2});
+    EXPECT_ANY_THROW(executor.submit({too_big, too_big}));
+}
+
 #if defined(NGRAPH_INTERPRETER_ENABLE) && defined(NGRAPH_CPU_ENABLE)
 TEST(backend_api, executable_can_create_tensor)
 {
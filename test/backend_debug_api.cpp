@@ -14,6 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <future>
 #include <random>
 #include <sstream>
 #include <string>
@@ -74,3 +75,48 @@ TEST(INTERPRETER, nan_check_output)
     ihandle->set_nan_check(true);
     EXPECT_ANY_THROW(handle->call_with_validate({result}, {a, b}));
 }
+
+TEST(INTERPRETER, reuse_intermediates_across_calls)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = op::Constant::create(element::f32, shape, {1, 1, 1, 1});
+    auto sum = make_shared<op::Add>(A, B);
+    auto product = make_shared<op::Multiply>(sum, make_shared<op::Add>(sum, C));
+    auto f = make_shared<Function>(NodeVector{product, sum}, ParameterVector{A, B});
+
+    shared_ptr<runtime::Backend> backend = runtime::Backend::create("INTERPRETER");
+    shared_ptr<runtime::Executable> handle = backend->compile(f);
+
+    auto run = [&](float x) {
+        auto a = backend->create_tensor(element::f32, shape);
+        copy_data(a, vector<float>{x, x, x, x});
+        auto b = backend->create_tensor(element::f32, shape);
+        copy_data(b, vector<float>{1, 2, 3, 4});
+        auto r0 = backend->create_tensor(element::f32, shape);
+        auto r1 = backend->create_tensor(element::f32, shape);
+        handle->call_with_validate({r0, r1}, {a, b});
+        vector<float> expected_sum{x + 1, x + 2, x + 3, x + 4};
+        vector<float> expected_product;
+        for (float s : expected_sum)
+        {
+            expected_product.push_back(s * (s + 1));
+        }
+        return read_vector<float>(r0) == expected_product &&
+               read_vector<float>(r1) == expected_sum;
+    };
+
+    EXPECT_TRUE(run(1));
+    EXPECT_TRUE(run(2));
+
+    vector<future<bool>> results;
+    for (size_t i = 0; i < 8; i++)
+    {
+        results.push_back(async(launch::async, run, static_cast<float>(i)));
+    }
+    for (auto& result : results)
+    {
+        EXPECT_TRUE(result.get());
+    }
+}
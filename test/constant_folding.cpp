@@ -19,6 +19,7 @@
 #include "ngraph/ngraph.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "util/all_close_f.hpp"
+#include "util/provenance_enabler.hpp"
 #include "util/test_tools.hpp"
 
 using namespace ngraph;
@@ -2341,3 +2342,109 @@ TEST(constant_folding, pass_property)
     ASSERT_FALSE(pass->get_property(pass::PassProperty::REQUIRE_STATIC_SHAPE));
     ASSERT_TRUE(pass->get_property(pass::PassProperty::CHANGE_DYNAMIC_STATE));
 }
+
+TEST(constant_folding, parallel_independent_subgraphs)
+{
+    Shape shape{4};
+    auto param = make_shared<op::Parameter>(element::f32, shape);
+    NodeVector outputs;
+    for (int i = 0; i < 8; i++)
+    {
+        auto c = op::Constant::create(element::f32, shape, {1.f * i, -2.f, 3.f, -4.f});
+        outputs.push_back(make_shared<op::Add>(param, make_shared<op::Negative>(c)));
+    }
+    auto f = make_shared<Function>(outputs, ParameterVector{param});
+
+    pass::Manager pass_manager;
+    auto folding = pass_manager.register_pass<pass::ConstantFolding>();
+    folding->set_num_threads(4);
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 0);
+    for (int i = 0; i < 8; i++)
+    {
+        auto folded = as_type_ptr<op::Constant>(outputs[i]->get_argument(1));
+        ASSERT_TRUE(folded);
+        EXPECT_EQ(folded->get_vector<float>(), (vector<float>{-1.f * i, 2.f, -3.f, 4.f}));
+    }
+}
+
+TEST(constant_folding, parallel_folding_keeps_provenance_tags)
+{
+    test::ProvenanceEnabler provenance_enabler;
+
+    Shape shape{2};
+    auto param = make_shared<op::Parameter>(element::f32, shape);
+    NodeVector outputs;
+    vector<shared_ptr<Node>> negatives;
+    for (int i = 0; i < 4; i++)
+    {
+        auto c = op::Constant::create(element::f32, shape, {1.f * i, 2.f});
+        c->add_provenance_tag("constant_" + to_string(i));
+        auto negative = make_shared<op::Negative>(c);
+        negative->add_provenance_tag("negative_" + to_string(i));
+        outputs.push_back(make_shared<op::Add>(param, negative));
+    }
+    auto f = make_shared<Function>(outputs, ParameterVector{param});
+
+    pass::Manager pass_manager;
+    auto folding = pass_manager.register_pass<pass::ConstantFolding>();
+    folding->set_num_threads(2);
+    pass_manager.run_passes(f);
+
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 0);
+    for (int i = 0; i < 4; i++)
+    {
+        auto folded = outputs[i]->get_argument(1);
+        EXPECT_EQ(folded->get_provenance_tags(),
+                  (unordered_set<string>{"constant_" + to_string(i), "negative_" + to_string(i)}));
+    }
+}
+
+TEST(constant_folding, max_folded_bytes)
+{
+    auto constant = op::Constant::create(element::f32, Shape{2}, {1, 2});
+    auto broadcast = make_shared<op::Broadcast>(constant, Shape{1000, 2}, AxisSet{0});
+    auto f = make_shared<Function>(broadcast, ParameterVector{});
+
+    pass::Manager pass_manager;
+    auto folding = pass_manager.register_pass<pass::ConstantFolding>();
+    folding->set_max_folded_bytes(1000);
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::Broadcast>(f), 1);
+}
+
+TEST(constant_folding, share_identical_folded_constants)
+{
+    auto make_function = []() {
+        Shape shape{3};
+        auto param = make_shared<op::Parameter>(element::i32, shape);
+        auto a = op::Constant::create(element::i32, shape, {5, 6, 7});
+        auto b = op::Constant::create(element::i32, shape, {5, 6, 7});
+        auto x = make_shared<op::Add>(param, make_shared<op::Negative>(a));
+        auto y = make_shared<op::Multiply>(param, make_shared<op::Negative>(b));
+        return make_shared<Function>(NodeVector{x, y}, ParameterVector{param});
+    };
+    auto f = make_function();
+    auto g = make_function();
+
+    // Separate passes, as on two compiles, share through the process-wide registry
+    pass::Manager f_pass_manager;
+    f_pass_manager.register_pass<pass::ConstantFolding>();
+    f_pass_manager.run_passes(f);
+    pass::Manager g_pass_manager;
+    g_pass_manager.register_pass<pass::ConstantFolding>();
+    g_pass_manager.run_passes(g);
+
+    ASSERT_EQ(count_ops_of_type<op::Negative>(f), 0);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Constant>(g), 1);
+    auto f_constant =
+        as_type_ptr<op::Constant>(f->get_results().at(0)->get_argument(0)->get_argument(1));
+    auto g_constant =
+        as_type_ptr<op::Constant>(g->get_results().at(0)->get_argument(0)->get_argument(1));
+    ASSERT_TRUE(f_constant && g_constant);
+    EXPECT_EQ(f_constant->get_vector<int32_t>(), (vector<int32_t>{-5, -6, -7}));
+    EXPECT_EQ(f_constant->get_data_ptr(), g_constant->get_data_ptr());
+}
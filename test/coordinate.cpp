@@ -305,6 +305,83 @@ TEST(DISABLED_coordinate, dilation)
     EXPECT_TRUE(it == ct.end());
 }
 
+namespace
+{
+    // Checks for_each_offset and for_each_run against the coordinate iterator
+    void check_offsets(const CoordinateTransform& ct)
+    {
+        vector<pair<size_t, size_t>> expected;
+        CoordinateTransform iterated(ct);
+        size_t target_index = 0;
+        for (const Coordinate& c : iterated)
+        {
+            if (ct.has_source_coordinate(c))
+            {
+                expected.push_back({target_index, ct.index(c)});
+            }
+            target_index++;
+        }
+
+        vector<pair<size_t, size_t>> offsets;
+        ct.for_each_offset([&](size_t target_index, size_t source_index) {
+            offsets.push_back({target_index, source_index});
+        });
+        EXPECT_EQ(offsets, expected);
+
+        vector<pair<size_t, size_t>> runs;
+        ct.for_each_run([&](size_t target_index, size_t source_index, size_t count, size_t step) {
+            EXPECT_GT(count, 0);
+            for (size_t i = 0; i < count; i++)
+            {
+                runs.push_back({target_index + i, source_index + i * step});
+            }
+        });
+        EXPECT_EQ(runs, expected);
+    }
+}
+
+TEST(coordinate, for_each_offset)
+{
+    check_offsets(CoordinateTransform(Shape{}));
+    check_offsets(CoordinateTransform(Shape{7}));
+    check_offsets(CoordinateTransform(Shape{3, 0, 2}));
+    check_offsets(CoordinateTransform(Shape{4, 5, 6}));
+    check_offsets(CoordinateTransform(
+        Shape{4, 5, 6}, Coordinate{1, 0, 2}, Coordinate{4, 5, 5}, Strides{2, 3, 1}));
+    check_offsets(CoordinateTransform(Shape{4, 5, 6},
+                                      Coordinate{0, 0, 0},
+                                      Coordinate{4, 5, 6},
+                                      Strides{1, 1, 1},
+                                      AxisVector{2, 0, 1}));
+}
+
+TEST(coordinate, for_each_offset_padding_dilation)
+{
+    // Padded and dilated spaces, as used by convolution and pooling
+    check_offsets(CoordinateTransform(Shape{2, 5, 6},
+                                      Coordinate{0, 0, 0},
+                                      Coordinate{2, 9, 10},
+                                      Strides{1, 1, 1},
+                                      AxisVector{0, 1, 2},
+                                      CoordinateDiff{0, 2, 3},
+                                      CoordinateDiff{0, 2, 1}));
+    check_offsets(CoordinateTransform(Shape{2, 5, 6},
+                                      Coordinate{1, 1, 0},
+                                      Coordinate{2, 12, 13},
+                                      Strides{1, 2, 3},
+                                      AxisVector{0, 1, 2},
+                                      CoordinateDiff{0, 1, 2},
+                                      CoordinateDiff{0, 2, 0},
+                                      Strides{1, 2, 2}));
+    check_offsets(CoordinateTransform(Shape{6, 5},
+                                      Coordinate{0, 0},
+                                      Coordinate{4, 5},
+                                      Strides{1, 1},
+                                      AxisVector{0, 1},
+                                      CoordinateDiff{-2, 0},
+                                      CoordinateDiff{0, 0}));
+}
+
 TEST(benchmark, coordinate)
 {
     Shape source_shape{128, 3, 2000, 1000};
@@ -335,3 +412,68 @@ TEST(benchmark, coordinate)
     timer.stop();
     cout << "time: " << timer.get_milliseconds() << endl;
 }
+
+TEST(benchmark, coordinate_transform_offsets)
+{
+    Shape source_shape{64, 3, 100, 100};
+    size_t n_elements = shape_size(source_shape);
+    vector<pair<string, CoordinateTransform>> transforms{
+        {"identity", CoordinateTransform(source_shape)},
+        {"transposed",
+         CoordinateTransform(source_shape,
+                             Coordinate{0, 0, 0, 0},
+                             Coordinate(source_shape),
+                             Strides{1, 1, 1, 1},
+                             AxisVector{0, 2, 3, 1})},
+        {"padded",
+         CoordinateTransform(source_shape,
+                             Coordinate{0, 0, 0, 0},
+                             Coordinate{64, 3, 102, 102},
+                             Strides{1, 1, 1, 1},
+                             AxisVector{0, 1, 2, 3},
+                             CoordinateDiff{0, 0, 1, 1},
+                             CoordinateDiff{0, 0, 1, 1})}};
+
+    auto rate = [n_elements](stopwatch& timer) {
+        return n_elements * 1000.0 / max(timer.get_milliseconds(), size_t(1));
+    };
+    for (auto& named_transform : transforms)
+    {
+        CoordinateTransform& ct = named_transform.second;
+        size_t checksum_iterator = 0;
+        size_t checksum_offsets = 0;
+        size_t checksum_runs = 0;
+
+        stopwatch iterator_timer;
+        iterator_timer.start();
+        for (const Coordinate& c : ct)
+        {
+            if (ct.has_source_coordinate(c))
+            {
+                checksum_iterator += ct.index(c);
+            }
+        }
+        iterator_timer.stop();
+
+        stopwatch offsets_timer;
+        offsets_timer.start();
+        ct.for_each_offset([&](size_t, size_t source_index) { checksum_offsets += source_index; });
+        offsets_timer.stop();
+
+        stopwatch runs_timer;
+        runs_timer.start();
+        ct.for_each_run([&](size_t, size_t source_index, size_t count, size_t step) {
+            for (size_t i = 0; i < count; i++)
+            {
+                checksum_runs += source_index + i * step;
+            }
+        });
+        runs_timer.stop();
+
+        EXPECT_EQ(checksum_offsets, checksum_iterator);
+        EXPECT_EQ(checksum_runs, checksum_iterator);
+        cout << named_transform.first << " elements/s: iterator " << rate(iterator_timer)
+             << ", for_each_offset " << rate(offsets_timer) << ", for_each_run "
+             << rate(runs_timer) << endl;
+    }
+}
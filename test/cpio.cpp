@@ -107,3 +107,65 @@ TEST(cpio, write)
         }
     }
 }
+
+TEST(cpio, write_v2)
+{
+    string s1 = "this is a test";
+    string s2 = "the quick brown fox jumps over the lazy dog";
+    stringstream archive;
+    {
+        cpio::Writer writer(archive, cpio::Version::V2);
+        writer.write("file1.txt", s1.data(), s1.size());
+        // Write the second file in chunks, through both the writer and its stream
+        ostream& out = writer.begin("file2.txt");
+        writer.write(s2.data(), 10);
+        out << s2.substr(10);
+        writer.end();
+        writer.write("empty.txt", nullptr, 0);
+    }
+    EXPECT_TRUE(cpio::is_cpio(archive));
+
+    cpio::Reader reader(archive);
+    auto file_info = reader.get_file_info();
+    ASSERT_EQ(3, file_info.size());
+    EXPECT_EQ(file_info[0].get_name(), "file1.txt");
+    EXPECT_EQ(file_info[1].get_name(), "file2.txt");
+    EXPECT_EQ(file_info[2].get_name(), "empty.txt");
+    EXPECT_EQ(file_info[0].get_size(), s1.size());
+    EXPECT_EQ(file_info[1].get_size(), s2.size());
+    EXPECT_EQ(file_info[2].get_size(), 0);
+    for (const cpio::FileInfo& info : file_info)
+    {
+        EXPECT_EQ(info.get_offset() % 4096, 0);
+    }
+
+    const cpio::FileInfo* info = reader.find("file2.txt");
+    ASSERT_NE(info, nullptr);
+    vector<char> data = reader.read(*info);
+    EXPECT_EQ(string(data.data(), data.size()), s2);
+    data = reader.read(file_info[0]);
+    EXPECT_EQ(string(data.data(), data.size()), s1);
+    EXPECT_EQ(reader.find("missing.txt"), nullptr);
+}
+
+TEST(cpio, write_v2_errors)
+{
+    stringstream archive;
+    {
+        cpio::Writer writer(archive, cpio::Version::V2);
+        writer.begin("file1.txt");
+        EXPECT_THROW(writer.begin("file2.txt"), runtime_error);
+        writer.end();
+        EXPECT_THROW(writer.end(), runtime_error);
+        EXPECT_THROW(writer.write("data", 4), runtime_error);
+    }
+    stringstream v1;
+    cpio::Writer writer(v1);
+    EXPECT_THROW(writer.begin("file1.txt"), runtime_error);
+
+    // An archive cut short has no directory to read
+    string s = archive.str();
+    stringstream truncated(s.substr(0, s.size() - 1));
+    cpio::Reader reader(truncated);
+    EXPECT_THROW(reader.get_file_info(), runtime_error);
+}
@@ -16,14 +16,18 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <thread>
 
 #include "gtest/gtest.h"
 #include "misc.hpp"
 #include "ngraph/autodiff/adjoints.hpp"
+#include "ngraph/chrome_trace.hpp"
 #include "ngraph/env_util.hpp"
 #include "ngraph/file_util.hpp"
 #include "ngraph/graph_util.hpp"
@@ -40,6 +44,9 @@
 #include "ngraph/pass/visualize_tree.hpp"
 #include "ngraph/runtime/cpu/cpu_backend.hpp"
 #include "ngraph/runtime/cpu/cpu_builder.hpp"
+#include "ngraph/runtime/cpu/cpu_dex_scheduler.hpp"
+#include "ngraph/runtime/cpu/cpu_executor.hpp"
+#include "ngraph/runtime/cpu/cpu_hardware_counters.hpp"
 #include "ngraph/runtime/cpu/cpu_tensor_view.hpp"
 #include "ngraph/runtime/cpu/mkldnn_utils.hpp"
 #include "ngraph/runtime/cpu/op/convert_layout.hpp"
@@ -1052,6 +1059,53 @@ TEST(cpu_test, thread_safe_calls_convolution_2d_2items)
     unset_environment("NGRAPH_CPU_CONCURRENCY");
 }
 
+TEST(cpu_test, MLIR_DISABLE_TEST(streams))
+{
+    if (is_codegen_mode())
+    {
+        // TODO change to skip when there is a new release of gtest
+        NGRAPH_WARN << "This test is skipped for CODEGEN mode.";
+        return;
+    }
+
+    set_environment("NGRAPH_CPU_CONCURRENCY", "2", 1);
+
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Relu>(A * B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = dynamic_pointer_cast<runtime::cpu::CPU_Executable>(backend->compile(f));
+    ASSERT_NE(handle, nullptr);
+    ASSERT_EQ(handle->get_num_streams(), 2);
+
+    auto make_call = [&](size_t stream, float scale) {
+        auto a = backend->create_tensor(element::f32, shape);
+        auto b = backend->create_tensor(element::f32, shape);
+        auto result = backend->create_tensor(element::f32, shape);
+        copy_data(a, vector<float>{1.f, -2.f, 3.f, -4.f});
+        copy_data(b, vector<float>{scale, scale, scale, scale});
+        for (size_t i = 0; i < 10; i++)
+        {
+            handle->call({result}, {a, b}, stream);
+            EXPECT_TRUE(test::all_close_f(read_vector<float>(result),
+                                          vector<float>{scale, 0.f, 3.f * scale, 0.f}));
+        }
+    };
+
+    std::thread call1(make_call, 0, 2.f);
+    std::thread call2(make_call, 1, 3.f);
+    call1.join();
+    call2.join();
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    EXPECT_THROW(handle->call({result}, {a, a}, 2), ngraph_error);
+
+    unset_environment("NGRAPH_CPU_CONCURRENCY");
+}
+
 TEST(cpu_test, constant_convertlayout)
 {
     Shape data_shape{1, 64, 56, 56};
@@ -2310,3 +2364,277 @@ TEST(cpu_test, one_hot_scalar_oob_in_3)
     handle->call_with_validate({result}, {a});
     EXPECT_EQ(r_data[3], 0);
 }
+
+#ifndef NGRAPH_JSON_DISABLE
+TEST(cpu_test, save_load)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Relu>(A + B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU");
+
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1.f, -2.f, 3.f, -4.f});
+    copy_data(b, vector<float>{5.f, -6.f, 7.f, -8.f});
+
+    stringstream file;
+    {
+        pass::PassConfig pass_config;
+        pass_config.set_pass_attribute("CPU_Executable::Saveable", true);
+        auto handle = backend->compile(f, pass_config);
+        handle->save(file);
+    }
+    {
+        auto handle = backend->load(file);
+        ASSERT_NE(handle, nullptr);
+        handle->call_with_validate({result}, {a, b});
+        EXPECT_TRUE(test::all_close_f(read_vector<float>(result), {6.f, 0.f, 10.f, 0.f}));
+    }
+}
+
+TEST(cpu_test, save_requires_saveable)
+{
+    Shape shape{2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Relu>(A), ParameterVector{A});
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->compile(f);
+    stringstream file;
+    EXPECT_THROW(handle->save(file), ngraph_error);
+}
+#endif
+
+TEST(cpu_test, call_async_blocks_tensor_access)
+{
+    Shape shape{64, 64};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Dot>(A, B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU");
+    auto handle = backend->compile(f);
+    auto a = handle->create_input_tensor(0);
+    auto b = handle->create_input_tensor(1);
+    auto result = handle->create_output_tensor(0);
+    copy_data(a, vector<float>(shape_size(shape), 1.f));
+    copy_data(b, vector<float>(shape_size(shape), 2.f));
+
+    auto done = handle->call_async({result}, {a, b});
+    // The write must wait until the queued call has consumed the old contents
+    copy_data(a, vector<float>(shape_size(shape), 0.f));
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result),
+                                  vector<float>(shape_size(shape), 128.f)));
+    EXPECT_TRUE(done.get());
+}
+
+TEST(cpu_test, hardware_counters)
+{
+    runtime::PerformanceCounter p(nullptr, 10, 1);
+    p.m_instructions = 4000;
+    p.m_bytes = 1000;
+    EXPECT_DOUBLE_EQ(p.instructions_per_byte(), 4.0);
+    EXPECT_DOUBLE_EQ(p.gigabytes_per_second(), 0.1);
+
+    auto& counters = runtime::cpu::HardwareCounters::get_thread_counters();
+    if (!counters.is_open())
+    {
+        // perf_event_open is not permitted in this environment
+        return;
+    }
+    auto start = counters.read();
+    volatile float sum = 0;
+    for (int i = 0; i < 100000; i++)
+    {
+        sum = sum + i;
+    }
+    auto end = counters.read();
+    ASSERT_TRUE(start.valid && end.valid);
+    EXPECT_GT(end.cycles, start.cycles);
+    EXPECT_GT(end.instructions - start.instructions, 100000);
+}
+
+TEST(cpu_test, op_trace_events)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Add>(A, B), ParameterVector{A, B});
+
+    auto backend = runtime::Backend::create("CPU");
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+    copy_data(b, vector<float>{5, 6, 7, 8});
+
+    string trace_file = file_util::path_join(file_util::get_temp_directory_path(),
+                                             "cpu_test_op_trace_events.json");
+    bool was_enabled = runtime::event::Manager::is_tracing_enabled();
+    runtime::event::Manager::close();
+    runtime::event::Manager::open(trace_file);
+    runtime::event::Manager::enable_event_tracing();
+    auto handle = backend->compile(f);
+    handle->call_with_validate({result}, {a, b});
+    runtime::event::Manager::close();
+    if (!was_enabled)
+    {
+        runtime::event::Manager::disable_event_tracing();
+    }
+
+    ifstream in(trace_file);
+    string trace((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    EXPECT_NE(trace.find(R"({"name":"Add","ph":"X","cat":"Op")"), string::npos);
+    EXPECT_NE(trace.find(R"("input_bytes":32,"output_bytes":16)"), string::npos);
+    EXPECT_NE(trace.find(R"({"name":"call","cat":"CPU")"), string::npos);
+    file_util::remove_file(trace_file);
+}
+
+TEST(cpu_test, dex_scheduler_tasks)
+{
+    using Scheduler = runtime::cpu::DEXScheduler;
+    auto op = [](vector<Scheduler::Region> reads, vector<Scheduler::Region> writes, size_t bytes) {
+        return Scheduler::OpInfo{reads, writes, {}, bytes, false};
+    };
+    const size_t big = Scheduler::s_default_min_task_bytes;
+    vector<Scheduler::OpInfo> ops{
+        op({{1, 0, big}}, {{0, 0, big}}, big),             // 0: first tower
+        op({{1, 0, big}}, {{0, big, 2 * big}}, big),       // 1: second tower, independent of 0
+        op({{0, 0, big}}, {{0, 2 * big, 2 * big + 8}}, 8), // 2: tiny consumer of 0, fused
+        op({{0, 0, 2 * big}}, {{0, 0, big}}, big),         // 3: joins both, reuses 0's buffer
+        op({{0, 2 * big, 2 * big + 8}}, {{0, big, 2 * big}}, big)}; // 4: overwrites 3's input
+
+    Scheduler scheduler(ops);
+    auto& tasks = scheduler.get_tasks();
+    EXPECT_EQ(tasks.size(), 4);
+    EXPECT_EQ(scheduler.get_task(2), scheduler.get_task(0));
+    EXPECT_NE(scheduler.get_task(1), scheduler.get_task(0));
+    EXPECT_EQ(tasks[scheduler.get_task(3)].predecessors, 2);
+    EXPECT_EQ(tasks[scheduler.get_task(4)].predecessors, 3);
+
+    for (size_t threads : {1, 4})
+    {
+        vector<size_t> order;
+        mutex order_mutex;
+        scheduler.run(
+            [&](size_t i) {
+                lock_guard<mutex> lock(order_mutex);
+                order.push_back(i);
+            },
+            threads);
+        ASSERT_EQ(order.size(), ops.size());
+        auto position = [&](size_t i) { return find(order.begin(), order.end(), i); };
+        EXPECT_LT(position(0), position(2));
+        EXPECT_LT(position(2), position(3));
+        EXPECT_LT(position(1), position(3));
+        EXPECT_LT(position(3), position(4));
+    }
+
+    EXPECT_THROW(scheduler.run(
+                     [](size_t i) {
+                         if (i == 3)
+                         {
+                             throw ngraph_error("op failed");
+                         }
+                     },
+                     4),
+                 ngraph_error);
+}
+
+TEST(cpu_test, dex_scheduler_towers)
+{
+    string saved = getenv_string("NGRAPH_CPU_DEX_SCHEDULER_THREADS");
+    set_environment("NGRAPH_CPU_DEX_SCHEDULER_THREADS", "4", 1);
+
+    Shape shape{16, 64};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    NodeVector towers;
+    for (int i = 0; i < 8; i++)
+    {
+        shared_ptr<Node> t = A;
+        for (int j = 0; j <= i; j++)
+        {
+            t = (j % 2 == 0 ? t + B : t * B);
+        }
+        towers.push_back(make_shared<op::Tanh>(t));
+    }
+    auto sum = towers[0];
+    for (size_t i = 1; i < towers.size(); i++)
+    {
+        sum = sum + towers[i];
+    }
+    auto f = make_shared<Function>(sum, ParameterVector{A, B});
+
+    auto cpu_f = clone_function(*f);
+    auto int_f = clone_function(*f);
+    test::Uniform<float> rng(-1.0f, 1.0f);
+    vector<vector<float>> args;
+    for (auto& param : int_f->get_parameters())
+    {
+        vector<float> tensor_val(shape_size(param->get_shape()));
+        rng.initialize(tensor_val);
+        args.push_back(tensor_val);
+    }
+    auto int_results = execute(int_f, args, "INTERPRETER");
+
+    auto backend = runtime::Backend::create("CPU");
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, args[0]);
+    copy_data(b, args[1]);
+    auto handle = backend->compile(cpu_f);
+    // The first call runs sequentially, the following ones through the scheduler
+    for (int i = 0; i < 3; i++)
+    {
+        handle->call_with_validate({result}, {a, b});
+        EXPECT_TRUE(test::all_close_f(int_results.at(0), read_vector<float>(result)));
+    }
+
+    if (saved.empty())
+    {
+        unset_environment("NGRAPH_CPU_DEX_SCHEDULER_THREADS");
+    }
+    else
+    {
+        set_environment("NGRAPH_CPU_DEX_SCHEDULER_THREADS", saved.c_str(), 1);
+    }
+}
+
+TEST(cpu_test, numa_node_config)
+{
+    auto& cpu_executor = runtime::cpu::executor::GetCPUExecutor();
+    string report = cpu_executor.get_topology_report();
+    EXPECT_NE(report.find("CPU Backend topology"), string::npos);
+    EXPECT_NE(report.find("pool 0:"), string::npos);
+
+    auto backend = runtime::Backend::create("CPU");
+    string error;
+    EXPECT_FALSE(backend->set_config({{"numa_node", "first"}}, error));
+    EXPECT_FALSE(error.empty());
+    EXPECT_TRUE(backend->set_config({{"numa_node", "-1"}}, error));
+    if (!cpu_executor.is_numa_aware())
+    {
+        EXPECT_FALSE(backend->set_config({{"numa_node", "0"}}, error));
+        return;
+    }
+
+    ASSERT_TRUE(backend->set_config({{"numa_node", "0"}}, error));
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>(make_shared<op::Tanh>(A + B), ParameterVector{A, B});
+    auto a = backend->create_tensor(element::f32, shape);
+    auto b = backend->create_tensor(element::f32, shape);
+    auto result = backend->create_tensor(element::f32, shape);
+    copy_data(a, vector<float>{1, 2, 3, 4});
+    copy_data(b, vector<float>{-1, -2, -3, -4});
+    auto handle = backend->compile(f);
+    handle->call_with_validate({result}, {a, b});
+    EXPECT_TRUE(test::all_close_f(read_vector<float>(result), vector<float>{0, 0, 0, 0}));
+    EXPECT_TRUE(backend->set_config({{"numa_node", "-1"}}, error));
+}
@@ -24,6 +24,7 @@
 #include "ngraph/op/abs.hpp"
 #include "ngraph/op/add.hpp"
 #include "ngraph/op/constant.hpp"
+#include "ngraph/op/convert.hpp"
 #include "ngraph/op/divide.hpp"
 #include "ngraph/op/multiply.hpp"
 #include "ngraph/op/product.hpp"
@@ -341,3 +342,92 @@ TEST(CSE, pass_property)
     ASSERT_TRUE(pass->get_property(pass::PassProperty::REQUIRE_STATIC_SHAPE));
     ASSERT_FALSE(pass->get_property(pass::PassProperty::CHANGE_DYNAMIC_STATE));
 }
+
+TEST(CSE, structural_subgraphs)
+{
+    Shape shape{2, 3};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    vector<float> weights{1, 2, 3, 4, 5, 6};
+    auto c1 = op::Constant::create(element::f32, shape, weights);
+    auto c2 = op::Constant::create(element::f32, shape, weights);
+    auto sum1 = make_shared<op::Sum>(make_shared<op::Add>(make_shared<op::Abs>(A), c1), AxisSet{1});
+    auto sum2 = make_shared<op::Sum>(make_shared<op::Add>(c2, make_shared<op::Abs>(A)), AxisSet{1});
+    auto sub1 = make_shared<op::Subtract>(A, B);
+    auto sub2 = make_shared<op::Subtract>(B, A);
+    auto f = make_shared<Function>(NodeVector{sum1, sum2, sub1, sub2}, ParameterVector{A, B});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::StructuralCSE>();
+    pass_manager.run_passes(f);
+    ASSERT_EQ(f->get_results().at(0)->get_argument(0), f->get_results().at(1)->get_argument(0));
+    ASSERT_NE(f->get_results().at(2)->get_argument(0), f->get_results().at(3)->get_argument(0));
+    ASSERT_EQ(count_ops_of_type<op::Abs>(f), 1);
+    ASSERT_EQ(count_ops_of_type<op::Add>(f), 1);
+    // The weights and the reduction axes of the sums
+    ASSERT_EQ(count_ops_of_type<op::Constant>(f), 2);
+}
+
+TEST(CSE, structural_attributes)
+{
+    Shape shape{4};
+    auto A = make_shared<op::Parameter>(element::i32, shape);
+    auto convert1 = make_shared<op::Convert>(A, element::f32);
+    auto convert2 = make_shared<op::Convert>(A, element::f32);
+    auto convert3 = make_shared<op::Convert>(A, element::i64);
+    auto c1 = op::Constant::create(element::f32, shape, {1, 2, 3, 4});
+    auto c2 = op::Constant::create(element::f32, shape, {1, 2, 3, 5});
+    auto add1 = make_shared<op::Add>(convert1, c1);
+    auto add2 = make_shared<op::Add>(convert2, c2);
+    auto f = make_shared<Function>(NodeVector{convert1, convert2, convert3, add1, add2},
+                                   ParameterVector{A});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::StructuralCSE>();
+    pass_manager.run_passes(f);
+    ASSERT_EQ(f->get_results().at(0)->get_argument(0), f->get_results().at(1)->get_argument(0));
+    ASSERT_NE(f->get_results().at(0)->get_argument(0), f->get_results().at(2)->get_argument(0));
+    ASSERT_NE(f->get_results().at(3)->get_argument(0), f->get_results().at(4)->get_argument(0));
+}
+
+TEST(CSE, structural_shared_constants)
+{
+    auto make_function = [](float bias) {
+        Shape shape{3};
+        auto A = make_shared<op::Parameter>(element::f32, shape);
+        auto weights = op::Constant::create(element::f32, shape, {1, 2, 3});
+        auto bias_constant = op::Constant::create(element::f32, shape, {bias, bias, bias});
+        auto node = make_shared<op::Add>(make_shared<op::Multiply>(A, weights), bias_constant);
+        return make_shared<Function>(node, ParameterVector{A});
+    };
+    auto get_constant = [](const shared_ptr<Function>& f, size_t input) {
+        auto add = f->get_results().at(0)->get_argument(0);
+        auto node = input == 0 ? add->get_argument(0)->get_argument(1) : add->get_argument(1);
+        return as_type_ptr<op::Constant>(node);
+    };
+
+    auto registry = make_shared<pass::ConstantRegistry>();
+    auto f1 = make_function(0.5f);
+    auto f2 = make_function(0.5f);
+    auto f3 = make_function(1.5f);
+    for (auto f : {f1, f2, f3})
+    {
+        pass::StructuralCSE(registry).run_on_function(f);
+    }
+
+    EXPECT_EQ(registry->size(), 3);
+    EXPECT_EQ(get_constant(f1, 0)->get_data_ptr(), get_constant(f2, 0)->get_data_ptr());
+    EXPECT_EQ(get_constant(f1, 0)->get_data_ptr(), get_constant(f3, 0)->get_data_ptr());
+    EXPECT_EQ(get_constant(f1, 1)->get_data_ptr(), get_constant(f2, 1)->get_data_ptr());
+    EXPECT_NE(get_constant(f1, 1)->get_data_ptr(), get_constant(f3, 1)->get_data_ptr());
+    EXPECT_EQ(get_constant(f3, 1)->get_vector<float>(), (vector<float>{1.5f, 1.5f, 1.5f}));
+
+    // Each function keeps its own nodes; only the data is shared
+    EXPECT_NE(get_constant(f1, 0), get_constant(f2, 0));
+
+    f1 = nullptr;
+    f2 = nullptr;
+    EXPECT_EQ(registry->size(), 2);
+    f3 = nullptr;
+    EXPECT_EQ(registry->size(), 0);
+}
@@ -0,0 +1,462 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/runtime/reference/avg_pool.hpp"
+#include "ngraph/runtime/reference/broadcast.hpp"
+#include "ngraph/runtime/reference/convolution.hpp"
+#include "ngraph/runtime/reference/dot.hpp"
+#include "ngraph/runtime/reference/gather.hpp"
+#include "ngraph/runtime/reference/max.hpp"
+#include "ngraph/runtime/reference/max_pool.hpp"
+#include "ngraph/runtime/reference/mean.hpp"
+#include "ngraph/runtime/reference/min.hpp"
+#include "ngraph/runtime/reference/product.hpp"
+#include "ngraph/runtime/reference/softmax.hpp"
+#include "ngraph/runtime/reference/sum.hpp"
+#include "util/random.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+namespace fast = ngraph::runtime::reference::fast;
+
+namespace
+{
+    vector<float> random_vector(size_t size, float min = -1.0f, float max = 1.0f)
+    {
+        vector<float> result(size);
+        test::Uniform<float>(min, max, static_cast<float>(size)).initialize(result);
+        return result;
+    }
+
+    // Runs f with the fast reference kernels disabled
+    template <typename F>
+    void run_generic(const F& f)
+    {
+        bool enabled = fast::is_enabled();
+        fast::set_enabled(false);
+        f();
+        fast::set_enabled(enabled);
+    }
+
+    template <typename T>
+    void expect_bit_exact(const vector<T>& expected, const vector<T>& result)
+    {
+        ASSERT_EQ(expected.size(), result.size());
+        EXPECT_EQ(memcmp(expected.data(), result.data(), expected.size() * sizeof(T)), 0);
+    }
+}
+
+TEST(fast_reference, reductions)
+{
+    Shape shape{17, 65, 129};
+    vector<float> arg = random_vector(shape_size(shape));
+    arg[100] = numeric_limits<float>::infinity();
+    arg[2000] = numeric_limits<float>::quiet_NaN();
+    vector<float> product_arg = random_vector(shape_size(shape), 0.9f, 1.1f);
+
+    for (const AxisSet& axes : vector<AxisSet>{{}, {0}, {1}, {2}, {0, 2}, {1, 2}, {0, 1, 2}})
+    {
+        Shape out_shape = reduce(shape, axes);
+        vector<float> expected(shape_size(out_shape));
+        vector<float> result(shape_size(out_shape));
+
+        run_generic([&]() {
+            runtime::reference::sum(arg.data(), expected.data(), shape, out_shape, axes);
+        });
+        EXPECT_TRUE(fast::sum(arg.data(), result.data(), shape, out_shape, axes));
+        expect_bit_exact(expected, result);
+
+        run_generic([&]() {
+            runtime::reference::mean(arg.data(), expected.data(), shape, out_shape, axes);
+        });
+        EXPECT_TRUE(fast::mean(arg.data(), result.data(), shape, out_shape, axes));
+        expect_bit_exact(expected, result);
+
+        run_generic([&]() {
+            runtime::reference::max(arg.data(), expected.data(), shape, out_shape, axes);
+        });
+        EXPECT_TRUE(fast::max(arg.data(), result.data(), shape, out_shape, axes));
+        expect_bit_exact(expected, result);
+
+        run_generic([&]() {
+            runtime::reference::min(arg.data(), expected.data(), shape, out_shape, axes);
+        });
+        EXPECT_TRUE(fast::min(arg.data(), result.data(), shape, out_shape, axes));
+        expect_bit_exact(expected, result);
+
+        run_generic([&]() {
+            runtime::reference::product(
+                product_arg.data(), expected.data(), shape, out_shape, axes);
+        });
+        EXPECT_TRUE(fast::product(product_arg.data(), result.data(), shape, out_shape, axes));
+        expect_bit_exact(expected, result);
+    }
+}
+
+TEST(fast_reference, softmax)
+{
+    Shape shape{9, 65, 257};
+    vector<float> arg = random_vector(shape_size(shape), -10.0f, 10.0f);
+
+    for (const AxisSet& axes : vector<AxisSet>{{1}, {2}, {0, 2}})
+    {
+        vector<float> expected(arg.size());
+        vector<float> result(arg.size());
+        run_generic(
+            [&]() { runtime::reference::softmax(arg.data(), expected.data(), shape, axes); });
+        EXPECT_TRUE(fast::softmax(arg.data(), result.data(), shape, axes));
+        expect_bit_exact(expected, result);
+    }
+}
+
+TEST(fast_reference, broadcast)
+{
+    Shape in_shape{5, 1, 7};
+    Shape out_shape{64, 5, 40, 1, 7};
+    vector<float> arg = random_vector(shape_size(in_shape));
+    vector<float> expected(shape_size(out_shape));
+    vector<float> result(shape_size(out_shape));
+
+    run_generic([&]() {
+        runtime::reference::broadcast(
+            arg.data(), expected.data(), in_shape, out_shape, AxisSet{0, 2});
+    });
+    EXPECT_TRUE(fast::broadcast(arg.data(), result.data(), in_shape, out_shape, AxisSet{0, 2}));
+    expect_bit_exact(expected, result);
+
+    // Broadcasting along the innermost axis
+    in_shape = Shape{3, 5};
+    out_shape = Shape{3, 5, 64};
+    arg = random_vector(shape_size(in_shape));
+    expected.resize(shape_size(out_shape));
+    result.resize(shape_size(out_shape));
+    run_generic([&]() {
+        runtime::reference::broadcast(arg.data(), expected.data(), in_shape, out_shape, AxisSet{2});
+    });
+    EXPECT_TRUE(fast::broadcast(arg.data(), result.data(), in_shape, out_shape, AxisSet{2}));
+    expect_bit_exact(expected, result);
+}
+
+TEST(fast_reference, gather)
+{
+    Shape params_shape{6, 10, 9};
+    Shape indices_shape{4, 3};
+    Shape out_shape{6, 4, 3, 9};
+    vector<float> params = random_vector(shape_size(params_shape));
+    vector<int64_t> indices{0, 9, -1, 3, 3, -10, 5, 1, 2, 8, 7, 0};
+    vector<float> expected(shape_size(out_shape));
+    vector<float> result(shape_size(out_shape));
+
+    run_generic([&]() {
+        runtime::reference::gather(params.data(),
+                                   indices.data(),
+                                   expected.data(),
+                                   params_shape,
+                                   indices_shape,
+                                   out_shape,
+                                   1);
+    });
+    EXPECT_TRUE(fast::gather(
+        params.data(), indices.data(), result.data(), params_shape, indices_shape, out_shape, 1));
+    expect_bit_exact(expected, result);
+
+    // Out of range indices are left to the generic kernel
+    indices[4] = 10;
+    EXPECT_FALSE(fast::gather(
+        params.data(), indices.data(), result.data(), params_shape, indices_shape, out_shape, 1));
+}
+
+TEST(fast_reference, dot)
+{
+    Shape arg0_shape{37, 3, 19};
+    Shape arg1_shape{3, 19, 301};
+    Shape out_shape{37, 301};
+    vector<float> arg0 = random_vector(shape_size(arg0_shape));
+    vector<float> arg1 = random_vector(shape_size(arg1_shape));
+    vector<float> expected(shape_size(out_shape));
+    vector<float> result(shape_size(out_shape));
+
+    run_generic([&]() {
+        runtime::reference::dot(
+            arg0.data(), arg1.data(), expected.data(), arg0_shape, arg1_shape, out_shape, 2);
+    });
+    EXPECT_TRUE((fast::dot<float, float, float, double>(arg0.data(),
+                                                        arg1.data(),
+                                                        result.data(),
+                                                        arg0_shape,
+                                                        arg1_shape,
+                                                        out_shape,
+                                                        2,
+                                                        nullptr,
+                                                        nullptr,
+                                                        nullptr,
+                                                        nullptr,
+                                                        nullptr,
+                                                        nullptr)));
+    expect_bit_exact(expected, result);
+}
+
+TEST(fast_reference, dot_quantized)
+{
+    Shape arg0_shape{9, 40};
+    Shape arg1_shape{40, 23};
+    Shape out_shape{9, 23};
+    vector<uint8_t> arg0(shape_size(arg0_shape));
+    vector<int8_t> arg1(shape_size(arg1_shape));
+    for (size_t i = 0; i < arg0.size(); i++)
+    {
+        arg0[i] = static_cast<uint8_t>(i * 37 % 251);
+    }
+    for (size_t i = 0; i < arg1.size(); i++)
+    {
+        arg1[i] = static_cast<int8_t>(i * 53 % 255 - 127);
+    }
+    float scale0 = 0.02f, scale1 = 0.03f, out_scale = 4.0f;
+    uint8_t zero_point0 = 3;
+    int8_t zero_point1 = -2, out_zero_point = 1;
+    vector<int8_t> expected(shape_size(out_shape));
+    vector<int8_t> result(shape_size(out_shape));
+
+    run_generic([&]() {
+        runtime::reference::dot<uint8_t, int8_t, int8_t, int32_t>(arg0.data(),
+                                                                   arg1.data(),
+                                                                   expected.data(),
+                                                                   arg0_shape,
+                                                                   arg1_shape,
+                                                                   out_shape,
+                                                                   1,
+                                                                   &scale0,
+                                                                   &zero_point0,
+                                                                   &scale1,
+                                                                   &zero_point1,
+                                                                   &out_scale,
+                                                                   &out_zero_point);
+    });
+    EXPECT_TRUE((fast::dot<uint8_t, int8_t, int8_t, int32_t>(arg0.data(),
+                                                             arg1.data(),
+                                                             result.data(),
+                                                             arg0_shape,
+                                                             arg1_shape,
+                                                             out_shape,
+                                                             1,
+                                                             &scale0,
+                                                             &zero_point0,
+                                                             &scale1,
+                                                             &zero_point1,
+                                                             &out_scale,
+                                                             &out_zero_point)));
+    expect_bit_exact(expected, result);
+}
+
+TEST(fast_reference, convolution)
+{
+    auto check = [](const Shape& in_shape,
+                    const Shape& filter_shape,
+                    const Shape& out_shape,
+                    const Strides& stride,
+                    const Strides& filter_dilation,
+                    const CoordinateDiff& pad_below,
+                    const CoordinateDiff& pad_above,
+                    const Strides& in_dilation) {
+        vector<float> in = random_vector(shape_size(in_shape));
+        vector<float> filter = random_vector(shape_size(filter_shape));
+        vector<float> expected(shape_size(out_shape));
+        vector<float> result(shape_size(out_shape));
+
+        run_generic([&]() {
+            runtime::reference::convolution<float, float, float, double>(in.data(),
+                                                                         filter.data(),
+                                                                         expected.data(),
+                                                                         in_shape,
+                                                                         filter_shape,
+                                                                         out_shape,
+                                                                         stride,
+                                                                         filter_dilation,
+                                                                         pad_below,
+                                                                         pad_above,
+                                                                         in_dilation);
+        });
+        EXPECT_TRUE((fast::general_convolution<float, float, float, double>(in.data(),
+                                                                            filter.data(),
+                                                                            result.data(),
+                                                                            in_shape,
+                                                                            filter_shape,
+                                                                            out_shape,
+                                                                            stride,
+                                                                            filter_dilation,
+                                                                            pad_below,
+                                                                            pad_above,
+                                                                            in_dilation,
+                                                                            0,
+                                                                            1,
+                                                                            0,
+                                                                            1,
+                                                                            0,
+                                                                            1,
+                                                                            nullptr,
+                                                                            nullptr,
+                                                                            nullptr,
+                                                                            nullptr,
+                                                                            nullptr,
+                                                                            nullptr)));
+        expect_bit_exact(expected, result);
+    };
+
+    check(Shape{4, 8, 21, 23},
+          Shape{6, 8, 3, 2},
+          Shape{4, 6, 21, 20},
+          Strides{2, 1},
+          Strides{1, 2},
+          CoordinateDiff{1, -1},
+          CoordinateDiff{2, 0},
+          Strides{2, 1});
+    check(Shape{1, 5, 6, 7, 8},
+          Shape{2, 5, 2, 3, 3},
+          Shape{1, 2, 5, 5, 8},
+          Strides{1, 1, 1},
+          Strides{1, 1, 1},
+          CoordinateDiff{0, 0, 1},
+          CoordinateDiff{0, 0, 1},
+          Strides{1, 1, 1});
+}
+
+TEST(fast_reference, pooling)
+{
+    Shape arg_shape{4, 8, 41, 40};
+    Shape out_shape{4, 8, 21, 14};
+    Shape window_shape{3, 4};
+    Strides strides{2, 3};
+    Shape padding{1, 2};
+    vector<float> arg = random_vector(shape_size(arg_shape));
+    vector<float> expected(shape_size(out_shape));
+    vector<float> result(shape_size(out_shape));
+
+    for (bool include_padding : {false, true})
+    {
+        run_generic([&]() {
+            runtime::reference::avg_pool(arg.data(),
+                                         expected.data(),
+                                         arg_shape,
+                                         out_shape,
+                                         window_shape,
+                                         strides,
+                                         padding,
+                                         padding,
+                                         include_padding);
+        });
+        EXPECT_TRUE(fast::avg_pool(arg.data(),
+                                   result.data(),
+                                   arg_shape,
+                                   out_shape,
+                                   window_shape,
+                                   strides,
+                                   padding,
+                                   padding,
+                                   include_padding));
+        expect_bit_exact(expected, result);
+    }
+
+    run_generic([&]() {
+        runtime::reference::max_pool(arg.data(),
+                                     expected.data(),
+                                     arg_shape,
+                                     out_shape,
+                                     window_shape,
+                                     strides,
+                                     padding,
+                                     padding);
+    });
+    EXPECT_TRUE(fast::max_pool(arg.data(),
+                               result.data(),
+                               arg_shape,
+                               out_shape,
+                               window_shape,
+                               strides,
+                               padding,
+                               padding));
+    expect_bit_exact(expected, result);
+}
+
+TEST(fast_reference, parallel_for)
+{
+    // Calls from several threads, each with nested calls, cover every index exactly once
+    const size_t count = 64;
+    const size_t expensive = size_t(1) << 20;
+    vector<vector<atomic<int>>> visits(4);
+    vector<thread> callers;
+    for (auto& caller_visits : visits)
+    {
+        caller_visits = vector<atomic<int>>(count * count);
+        callers.emplace_back([&caller_visits, count, expensive]() {
+            fast::parallel_for(count, expensive, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++)
+                {
+                    fast::parallel_for(
+                        count, expensive, [&](size_t inner_begin, size_t inner_end) {
+                            for (size_t j = inner_begin; j < inner_end; j++)
+                            {
+                                caller_visits[i * count + j]++;
+                            }
+                        });
+                }
+            });
+        });
+    }
+    for (auto& caller : callers)
+    {
+        caller.join();
+    }
+    for (auto& caller_visits : visits)
+    {
+        for (auto& visit : caller_visits)
+        {
+            EXPECT_EQ(visit, 1);
+        }
+    }
+
+    // A thread set serial runs every chunk itself
+    bool was_serial = fast::set_serial_on_this_thread(true);
+    EXPECT_FALSE(was_serial);
+    thread::id caller = this_thread::get_id();
+    atomic<size_t> foreign_chunks{0};
+    fast::parallel_for(count, expensive, [&](size_t begin, size_t end) {
+        if (this_thread::get_id() != caller)
+        {
+            foreign_chunks++;
+        }
+    });
+    EXPECT_EQ(foreign_chunks, 0);
+    EXPECT_TRUE(fast::set_serial_on_this_thread(was_serial));
+
+    // Exceptions thrown by a chunk reach the caller
+    EXPECT_THROW(fast::parallel_for(count,
+                                    expensive,
+                                    [](size_t begin, size_t end) {
+                                        if (end == 64)
+                                        {
+                                            throw runtime_error("last chunk");
+                                        }
+                                    }),
+                 runtime_error);
+}
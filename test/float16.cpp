@@ -15,6 +15,7 @@
 //*****************************************************************************
 
 #include <climits>
+#include <cstring>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -110,3 +111,41 @@ TEST(float16, values)
         EXPECT_EQ(intvals.at(i), fp16val.to_bits());
     }
 }
+
+TEST(float16, bulk_conversions)
+{
+    // Every float16, and float bit patterns spread over the whole range, with a count that is
+    // not a multiple of the vector width
+    vector<float16> values(65536);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = float16::from_bits(static_cast<uint16_t>(i));
+    }
+    vector<float> floats(values.size());
+    float16::to_float(values.data(), floats.data(), values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        float expected = values[i];
+        EXPECT_EQ(0, memcmp(&expected, &floats[i], sizeof(float))) << i;
+    }
+
+    vector<uint32_t> bits;
+    for (uint64_t b = 0; b <= 0xFFFFFFFF; b += 4093)
+    {
+        bits.push_back(static_cast<uint32_t>(b));
+    }
+    for (uint32_t b : {0x00000000u, 0x80000000u, 0x7F800000u, 0xFF800000u, 0x7FC00000u,
+                       0x7F7FFFFFu, 0x477FF000u, 0x33000000u, 0x387FE000u, 0x3F808000u})
+    {
+        bits.push_back(b);
+    }
+    bits.resize(bits.size() / 16 * 16 + 7, 0x3F800000u);
+    floats.resize(bits.size());
+    memcpy(floats.data(), bits.data(), bits.size() * sizeof(float));
+    values.resize(floats.size());
+    float16::from_float(floats.data(), values.data(), floats.size());
+    for (size_t i = 0; i < floats.size(); ++i)
+    {
+        EXPECT_EQ(float16(floats[i]).to_bits(), values[i].to_bits()) << hex << bits[i];
+    }
+}
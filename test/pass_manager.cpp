@@ -23,6 +23,7 @@
 
 #include "ngraph/graph_util.hpp"
 #include "ngraph/ngraph.hpp"
+#include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "util/test_tools.hpp"
 
@@ -67,3 +68,32 @@ TEST(pass_manager, serialize_with_revalidate_does_not_crash)
     auto graph = make_test_graph();
     pass_manager.run_passes(graph);
 }
+
+TEST(pass_manager, profile)
+{
+    Shape shape{2, 2};
+    auto a = op::Constant::create(element::f32, shape, {1, 2, 3, 4});
+    auto b = op::Constant::create(element::f32, shape, {5, 6, 7, 8});
+    auto f = make_shared<Function>(make_shared<op::Add>(a, b), ParameterVector{});
+
+    pass::Manager pass_manager;
+    pass_manager.set_pass_profiling(true);
+    pass_manager.register_pass<pass::ConstantFolding>();
+    pass_manager.run_passes(f);
+
+    // ConstantFolding followed by the per-pass Validate
+    auto& profile = pass_manager.get_profile();
+    ASSERT_EQ(profile.size(), 2);
+    EXPECT_NE(profile[0].name.find("ConstantFolding"), string::npos);
+    EXPECT_EQ(profile[0].nodes_before, 4);
+    EXPECT_EQ(profile[0].nodes_after, 2);
+    EXPECT_EQ(profile[0].rewrites, 1);
+    EXPECT_EQ(profile[0].functions_modified, 1);
+    EXPECT_NE(profile[1].name.find("Validate"), string::npos);
+    EXPECT_EQ(profile[1].nodes_before, 2);
+    EXPECT_EQ(profile[1].rewrites, 0);
+
+    pass_manager.set_pass_profiling(false);
+    pass_manager.run_passes(f);
+    EXPECT_TRUE(pass_manager.get_profile().empty());
+}
@@ -0,0 +1,104 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/liveness.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/memory_aware_scheduling.hpp"
+#include "ngraph/pass/memory_layout.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+static size_t position(const vector<shared_ptr<Node>>& ops, const shared_ptr<Node>& node)
+{
+    return find(ops.begin(), ops.end(), node) - ops.begin();
+}
+
+TEST(memory_aware_scheduling, defer_long_lived_input)
+{
+    // The default order computes a first and holds it while the large temporary t is live
+    auto p = make_shared<op::Parameter>(element::f32, Shape{});
+    auto a = make_shared<op::Broadcast>(p, Shape{100}, AxisSet{0});
+    auto t = make_shared<op::Broadcast>(p, Shape{10, 100}, AxisSet{0, 1});
+    auto s = make_shared<op::Sum>(t, AxisSet{0});
+    auto f = make_shared<Function>(make_shared<op::Add>(a, s), ParameterVector{p});
+
+    auto ops = f->get_ordered_ops();
+    EXPECT_LT(position(ops, a), position(ops, t));
+    EXPECT_EQ(pass::MemoryAwareScheduling::estimate_peak_bytes(ops), 4800);
+
+    pass::Manager pass_manager;
+    auto scheduling = pass_manager.register_pass<pass::MemoryAwareScheduling>();
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(scheduling->get_original_peak_bytes(), 4800);
+    EXPECT_EQ(scheduling->get_peak_bytes(), 4400);
+    ops = f->get_ordered_ops();
+    EXPECT_LT(position(ops, s), position(ops, a));
+    EXPECT_EQ(f->get_temporary_pool_size(), 4400);
+}
+
+TEST(memory_aware_scheduling, keep_default_order)
+{
+    Shape shape{2, 2};
+    auto A = make_shared<op::Parameter>(element::f32, shape);
+    auto B = make_shared<op::Parameter>(element::f32, shape);
+    auto C = make_shared<op::Parameter>(element::f32, shape);
+    auto f = make_shared<Function>((A + B) * C, ParameterVector{A, B, C});
+
+    auto default_ops = f->get_ordered_ops();
+    pass::Manager pass_manager;
+    auto scheduling = pass_manager.register_pass<pass::MemoryAwareScheduling>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(scheduling->get_original_peak_bytes(), scheduling->get_peak_bytes());
+    EXPECT_EQ(f->get_ordered_ops(), default_ops);
+}
+
+TEST(memory_aware_scheduling, reschedule_changed_graph)
+{
+    auto p = make_shared<op::Parameter>(element::f32, Shape{});
+    auto a = make_shared<op::Broadcast>(p, Shape{100}, AxisSet{0});
+    auto t = make_shared<op::Broadcast>(p, Shape{10, 100}, AxisSet{0, 1});
+    auto s = make_shared<op::Sum>(t, AxisSet{0});
+    auto add = make_shared<op::Add>(a, s);
+    auto f = make_shared<Function>(add, ParameterVector{p});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::MemoryAwareScheduling>();
+    pass_manager.run_passes(f);
+
+    // The kept schedule is returned while the graph is unchanged
+    auto ops = f->get_ordered_ops();
+    EXPECT_EQ(f->get_ordered_ops(), ops);
+
+    // A new op is scheduled after its input and before its user
+    auto negative = make_shared<op::Negative>(s);
+    add->input(1).replace_source_output(negative);
+    ops = f->get_ordered_ops();
+    EXPECT_LT(position(ops, s), position(ops, negative));
+    EXPECT_LT(position(ops, negative), position(ops, add));
+    EXPECT_EQ(ops.size(), 8);
+}
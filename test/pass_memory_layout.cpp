@@ -232,3 +232,74 @@ TEST(memory_layout, constant)
     size_t temporary_pool_size = f->get_temporary_pool_size();
     EXPECT_EQ(4, temporary_pool_size);
 }
+
+TEST(memory_manager, greedy_by_size)
+{
+    pass::MemoryManager mm{1, pass::MemoryManager::allocation_scheme::GREEDY_BY_SIZE};
+
+    // Allocations return ids, offsets are assigned by plan()
+    size_t a = mm.allocate(10);
+    size_t b = mm.allocate(20);
+    mm.free(a);
+    size_t c = mm.allocate(20);
+    mm.free(b);
+    mm.free(c);
+    mm.plan();
+
+    // a and c are never live together so they can share memory below or above b
+    EXPECT_EQ(mm.max_allocated(), 40);
+    EXPECT_NE(mm.get_offset(b), mm.get_offset(c));
+    EXPECT_TRUE(mm.get_offset(a) + 10 <= mm.get_offset(b) ||
+                mm.get_offset(b) + 20 <= mm.get_offset(a));
+
+    auto peaks = mm.get_peak_by_scheme();
+    EXPECT_EQ(peaks.at(pass::MemoryManager::allocation_scheme::FIRST_FIT), 50);
+    EXPECT_EQ(peaks.at(pass::MemoryManager::allocation_scheme::NO_REUSE), 50);
+    EXPECT_EQ(peaks.at(pass::MemoryManager::allocation_scheme::GREEDY_BY_SIZE), 40);
+    EXPECT_EQ(peaks.at(pass::MemoryManager::allocation_scheme::OPTIMAL), 40);
+}
+
+TEST(memory_manager, optimal)
+{
+    pass::MemoryManager mm{1, pass::MemoryManager::allocation_scheme::OPTIMAL};
+
+    size_t b0 = mm.allocate(2);
+    size_t b1 = mm.allocate(1);
+    size_t b2 = mm.allocate(2);
+    mm.free(b0);
+    size_t b3 = mm.allocate(2);
+    mm.free(b2);
+    size_t b4 = mm.allocate(1);
+    mm.free(b1);
+    mm.free(b3);
+    size_t b5 = mm.allocate(4);
+    mm.free(b5);
+    mm.free(b4);
+    mm.plan();
+
+    // Both online schemes and greedy by size leave gaps that the optimal packing avoids
+    EXPECT_EQ(mm.max_allocated(), 5);
+    auto peaks = mm.get_peak_by_scheme();
+    EXPECT_EQ(peaks.at(pass::MemoryManager::allocation_scheme::FIRST_FIT), 8);
+    EXPECT_EQ(peaks.at(pass::MemoryManager::allocation_scheme::GREEDY_BY_SIZE), 6);
+    EXPECT_EQ(peaks.at(pass::MemoryManager::allocation_scheme::OPTIMAL), 5);
+}
+
+TEST(memory_manager, offline_bad_free)
+{
+    pass::MemoryManager mm{1, pass::MemoryManager::allocation_scheme::GREEDY_BY_SIZE};
+
+    EXPECT_THROW(mm.free(10), std::runtime_error);
+}
+
+TEST(memory_layout, greedy_by_size)
+{
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>(
+        1, false, pass::MemoryManager::allocation_scheme::GREEDY_BY_SIZE);
+
+    auto graph = make_test_graph();
+    pass_manager.run_passes(graph);
+    EXPECT_LE(graph->get_temporary_pool_size(), 12);
+}
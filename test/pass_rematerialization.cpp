@@ -0,0 +1,148 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/descriptor/layout/dense_tensor_layout.hpp"
+#include "ngraph/ngraph.hpp"
+#include "ngraph/pass/liveness.hpp"
+#include "ngraph/pass/manager.hpp"
+#include "ngraph/pass/memory_layout.hpp"
+#include "ngraph/pass/rematerialization.hpp"
+#include "util/all_close_f.hpp"
+#include "util/autodiff/backprop_function.hpp"
+#include "util/test_tools.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+// Backprop graph of a chain of elementwise ops, whose backward ops read every activation
+static shared_ptr<Function> make_backprop_chain(size_t length)
+{
+    auto x = make_shared<op::Parameter>(element::f32, Shape{1000});
+    shared_ptr<Node> y = x;
+    for (size_t i = 0; i < length; i++)
+    {
+        y = make_shared<op::Tanh>(make_shared<op::Multiply>(y, y));
+    }
+    return autodiff::backprop_function(make_shared<Function>(y, ParameterVector{x}));
+}
+
+TEST(rematerialization, backprop_chain)
+{
+    auto f = make_backprop_chain(8);
+    auto reference = clone_function(*f);
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<pass::Liveness>();
+    pass_manager.register_pass<pass::MemoryLayout>();
+    pass_manager.run_passes(reference);
+
+    const size_t budget = 28000;
+    pass::Manager remat_manager;
+    auto remat = remat_manager.register_pass<pass::Rematerialization>(budget);
+    remat_manager.register_pass<pass::Liveness>();
+    remat_manager.register_pass<pass::MemoryLayout>();
+    remat_manager.run_passes(f);
+
+    EXPECT_GT(remat->get_original_peak_bytes(), budget);
+    EXPECT_LE(remat->get_peak_bytes(), budget);
+    EXPECT_GT(remat->get_recomputed_op_count(), 0);
+    EXPECT_GT(remat->get_recomputed_elements(), 0);
+    EXPECT_LT(f->get_temporary_pool_size(), reference->get_temporary_pool_size());
+
+    // The recomputed values are the same
+    vector<vector<float>> args{vector<float>(1000), vector<float>(1000)};
+    for (size_t i = 0; i < 1000; i++)
+    {
+        args[0][i] = (i % 17) / 17.0f - 0.5f;
+        args[1][i] = (i % 5) / 5.0f;
+    }
+    auto expected = execute(reference, args, "INTERPRETER");
+    auto actual = execute(f, args, "INTERPRETER");
+    EXPECT_TRUE(test::all_close_f(expected.at(0), actual.at(0)));
+}
+
+TEST(rematerialization, within_budget)
+{
+    auto f = make_backprop_chain(2);
+    auto ops = f->get_ordered_ops();
+
+    pass::Manager pass_manager;
+    auto remat = pass_manager.register_pass<pass::Rematerialization>(1 << 20);
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(remat->get_original_peak_bytes(), remat->get_peak_bytes());
+    EXPECT_EQ(remat->get_recomputed_op_count(), 0);
+    EXPECT_EQ(f->get_ordered_ops(), ops);
+}
+
+TEST(rematerialization, state_is_not_recomputed)
+{
+    // A random mask read before and after the peak must not be drawn twice
+    Shape shape{1000};
+    auto x = make_shared<op::Parameter>(element::f32, shape);
+    auto training = op::Constant::create(element::f32, Shape{}, {1});
+    auto mask = make_shared<op::GenerateMask>(training, shape, element::f32, 1, 0.5, false);
+    auto masked = make_shared<op::Multiply>(x, mask);
+    auto big = make_shared<op::Broadcast>(masked, Shape{10, 1000}, AxisSet{0});
+    auto sum = make_shared<op::Sum>(big, AxisSet{0});
+    auto f = make_shared<Function>(make_shared<op::Add>(sum, mask), ParameterVector{x});
+
+    pass::Manager pass_manager;
+    auto remat = pass_manager.register_pass<pass::Rematerialization>(0);
+    pass_manager.run_passes(f);
+
+    size_t masks = 0;
+    for (auto& node : f->get_ops())
+    {
+        masks += is_type<op::GenerateMask>(node) ? 1 : 0;
+    }
+    EXPECT_EQ(masks, 1);
+}
+
+TEST(rematerialization, copies_keep_layouts_and_annotations)
+{
+    // As in the CPU backend, which picks layouts and kernels before this pass runs
+    auto f = make_backprop_chain(8);
+    auto annotations = make_shared<op::util::OpAnnotations>();
+    for (auto& op : f->get_ops())
+    {
+        op->set_op_annotations(annotations);
+        for (size_t i = 0; i < op->get_output_size(); i++)
+        {
+            auto& tensor = op->output(i).get_tensor();
+            tensor.set_tensor_layout(make_shared<descriptor::layout::DenseTensorLayout>(tensor));
+        }
+    }
+
+    pass::Manager pass_manager;
+    auto remat = pass_manager.register_pass<pass::Rematerialization>(28000);
+    pass_manager.run_passes(f);
+
+    ASSERT_GT(remat->get_recomputed_op_count(), 0);
+    for (auto& op : f->get_ops())
+    {
+        EXPECT_EQ(op->get_op_annotations(), annotations);
+        for (size_t i = 0; i < op->get_output_size(); i++)
+        {
+            EXPECT_NE(op->output(i).get_tensor().get_tensor_layout(), nullptr);
+        }
+    }
+}
@@ -295,6 +295,63 @@ TEST(pattern, graph_rewrite)
     }
 }
 
+// Rewrites Abs(x) to Negative(x) and then registers a matcher for Negative(Negative(x)) = x,
+// which only runs near the nodes the first matcher rewrote
+class TestFollowUpGraphRewrite : public ngraph::pass::GraphRewrite
+{
+public:
+    void construct_abs_to_negative()
+    {
+        auto x = std::make_shared<pattern::op::Label>(element::f32, Shape{2});
+        auto abs = std::make_shared<op::Abs>(x);
+        auto callback = [this, x](pattern::Matcher& m) {
+            auto pattern_map = m.get_pattern_map();
+            ngraph::replace_node(m.get_match_root(),
+                                 std::make_shared<op::Negative>(pattern_map[x]));
+            construct_double_negative();
+            return true;
+        };
+        this->add_matcher(make_shared<pattern::Matcher>(abs), callback);
+    }
+
+    void construct_double_negative()
+    {
+        auto x = std::make_shared<pattern::op::Label>(element::f32, Shape{2});
+        auto negative = std::make_shared<op::Negative>(std::make_shared<op::Negative>(x));
+        auto callback = [x](pattern::Matcher& m) {
+            auto pattern_map = m.get_pattern_map();
+            ngraph::replace_node(m.get_match_root(), pattern_map[x]);
+            return true;
+        };
+        this->add_matcher(make_shared<pattern::Matcher>(negative), callback);
+    }
+
+    TestFollowUpGraphRewrite()
+        : GraphRewrite()
+    {
+        construct_abs_to_negative();
+    }
+};
+
+TEST(pattern, graph_rewrite_follow_up_matchers)
+{
+    Shape shape{2};
+    auto a = make_shared<op::Parameter>(element::f32, shape);
+    auto b = make_shared<op::Parameter>(element::f32, shape);
+    auto rewritten = make_shared<op::Negative>(make_shared<op::Abs>(a));
+    auto untouched = make_shared<op::Negative>(make_shared<op::Negative>(b));
+    auto f = make_shared<Function>(NodeVector{rewritten, untouched}, ParameterVector{a, b});
+
+    pass::Manager pass_manager;
+    pass_manager.register_pass<TestFollowUpGraphRewrite>();
+    pass_manager.run_passes(f);
+
+    EXPECT_EQ(count_ops_of_type<op::Abs>(f), 0);
+    EXPECT_EQ(f->get_results().at(0)->get_argument(0), a);
+    // Nothing near b was rewritten so the follow-up matcher never visits it
+    EXPECT_EQ(f->get_results().at(1)->get_argument(0), untouched);
+}
+
 TEST(pattern, matcher)
 {
     Shape shape{};
@@ -0,0 +1,126 @@
+//*****************************************************************************
+// Copyright 2017-2020 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ngraph/runtime/reference/generate_mask.hpp"
+#include "ngraph/runtime/reference/random_uniform.hpp"
+#include "ngraph/state/philox_rng.hpp"
+
+using namespace std;
+using namespace ngraph;
+
+TEST(philox_rng, known_answers)
+{
+    // Known answer vectors from the Random123 distribution
+    EXPECT_EQ(PhiloxRNG(0)({{0, 0, 0, 0}}),
+              (PhiloxRNG::Block{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}));
+    EXPECT_EQ(PhiloxRNG(0xffffffffffffffff)({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}),
+              (PhiloxRNG::Block{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}));
+    EXPECT_EQ(PhiloxRNG(0x299f31d0a4093822)({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}),
+              (PhiloxRNG::Block{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}));
+}
+
+TEST(philox_rng, ranges_are_independent)
+{
+    PhiloxRNG rng(2112);
+    const size_t count = 1001;
+    vector<double> whole(count);
+    rng.for_each_uniform(7, 0, count, [&](size_t i, double u) { whole[i] = u; });
+
+    // Generating the stream in pieces, from odd positions and out of order, gives the
+    // same values
+    vector<double> pieces(count);
+    vector<pair<size_t, size_t>> ranges{{500, 777}, {3, 500}, {0, 3}, {777, count}};
+    for (auto range : ranges)
+    {
+        rng.for_each_uniform(
+            7, range.first, range.second, [&](size_t i, double u) { pieces[i] = u; });
+    }
+    EXPECT_EQ(whole, pieces);
+    EXPECT_EQ(whole[10], rng.uniform(17));
+
+    EXPECT_TRUE(all_of(whole.begin(), whole.end(), [](double u) { return u >= 0 && u < 1; }));
+    double mean = 0;
+    for (double u : whole)
+    {
+        mean += u / count;
+    }
+    EXPECT_NEAR(mean, 0.5, 0.05);
+}
+
+TEST(philox_rng, states_advance)
+{
+    const size_t count = 100;
+    UniformRNGState state(42);
+    vector<float> first(count);
+    vector<float> second(count);
+    runtime::reference::random_uniform<float>(first.data(), 0, 1, count, &state);
+    runtime::reference::random_uniform<float>(second.data(), 0, 1, count, &state);
+    EXPECT_NE(first, second);
+
+    // Two draws of count values are one draw of 2 * count values
+    vector<float> both(2 * count);
+    runtime::reference::random_uniform_with_fixed_seed<float>(both.data(), 0, 1, 2 * count, 42);
+    EXPECT_TRUE(equal(first.begin(), first.end(), both.begin()));
+    EXPECT_TRUE(equal(second.begin(), second.end(), both.begin() + count));
+
+    BernoulliRNGState mask_state(42, 0.25);
+    vector<float> mask(10000);
+    runtime::reference::generate_mask<float>(mask.data(), mask.size(), &mask_state, true);
+    size_t ones = count_if(mask.begin(), mask.end(), [](float m) { return m == 1; });
+    EXPECT_EQ(ones + count_if(mask.begin(), mask.end(), [](float m) { return m == 0; }),
+              mask.size());
+    EXPECT_NEAR(ones, 2500, 150);
+}
+
+TEST(philox_rng, concurrent_advance)
+{
+    // Calls sharing a state from several threads reserve disjoint parts of the stream
+    UniformRNGState state(42);
+    const size_t thread_count = 8;
+    const size_t calls = 1000;
+    vector<vector<uint64_t>> offsets(thread_count);
+    vector<thread> threads;
+    for (size_t t = 0; t < thread_count; t++)
+    {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < calls; i++)
+            {
+                offsets[t].push_back(state.advance(3));
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    vector<uint64_t> all;
+    for (auto& o : offsets)
+    {
+        all.insert(all.end(), o.begin(), o.end());
+    }
+    sort(all.begin(), all.end());
+    for (size_t i = 0; i < all.size(); i++)
+    {
+        EXPECT_EQ(all[i], 3 * i);
+    }
+    EXPECT_EQ(state.advance(0), 3 * thread_count * calls);
+}
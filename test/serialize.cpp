@@ -194,6 +194,114 @@ TEST(serialize, constant)
     EXPECT_TRUE(found);
 }
 
+TEST(serialize, constant_weights_file)
+{
+    const string weights_file = "serialize_constant_weights.bin";
+    Shape shape{2, 2, 2};
+    auto A = op::Constant::create(element::f32, shape, {1, 2, 3, 4, 5, 6, 7, 8});
+    auto B = op::Constant::create(element::i32, shape, {8, 7, 6, 5, 4, 3, 2, 1});
+    auto C = op::Constant::create(element::f32, shape, {3, 3, 3, 3, 3, 3, 3, 3});
+    auto f = make_shared<Function>(OutputVector{A, B, C}, ParameterVector{});
+
+    stringstream model;
+    {
+        ofstream weights(weights_file, ios_base::binary);
+        serialize(model, weights, f);
+    }
+    // Uniform constants stay inline, the others go to the weights file
+    json js = json::parse(model.str());
+    size_t weights_count = 0;
+    for (auto& node : js[0].at("ops"))
+    {
+        weights_count += node.count("weights_offset");
+    }
+    EXPECT_EQ(weights_count, 2);
+
+    auto g = deserialize(model, weights_file);
+    ASSERT_NE(g, nullptr);
+    file_util::remove_file(weights_file);
+
+    auto a = as_type_ptr<op::Constant>(g->get_results().at(0)->get_argument(0));
+    auto b = as_type_ptr<op::Constant>(g->get_results().at(1)->get_argument(0));
+    auto c = as_type_ptr<op::Constant>(g->get_results().at(2)->get_argument(0));
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ((vector<float>{1, 2, 3, 4, 5, 6, 7, 8}), a->get_vector<float>());
+    EXPECT_EQ((vector<int32_t>{8, 7, 6, 5, 4, 3, 2, 1}), b->get_vector<int32_t>());
+    EXPECT_EQ((vector<float>{3, 3, 3, 3, 3, 3, 3, 3}), c->get_vector<float>());
+    EXPECT_EQ(static_cast<const char*>(b->get_data_ptr()) -
+                  static_cast<const char*>(a->get_data_ptr()),
+              4096);
+}
+
+TEST(serialize, binary)
+{
+    const string tmp_file = "serialize_binary.ngb";
+    Shape shape{2, 2, 2};
+    auto P = make_shared<op::Parameter>(element::f32, shape);
+    auto A = op::Constant::create(element::f32, shape, {1, 2, 3, 4, 5, 6, 7, 8});
+    auto B = op::Constant::create(element::i32, shape, {8, 7, 6, 5, 4, 3, 2, -1});
+    auto C = op::Constant::create(element::f32, shape, {-1.5f});
+    auto f = make_shared<Function>(OutputVector{make_shared<op::Multiply>(P + A, C), B},
+                                   ParameterVector{P});
+
+    string data;
+    {
+        stringstream ss;
+        serialize_binary(ss, f);
+        data = ss.str();
+        ofstream out(tmp_file, ios_base::binary);
+        out << data;
+    }
+
+    auto check = [&](shared_ptr<Function> g) {
+        ASSERT_NE(g, nullptr);
+        vector<string> expected;
+        for (auto node : f->get_ordered_ops())
+        {
+            expected.push_back(node->description());
+        }
+        vector<string> actual;
+        for (auto node : g->get_ordered_ops())
+        {
+            actual.push_back(node->description());
+        }
+        EXPECT_EQ(expected, actual);
+        EXPECT_EQ(g->get_parameters().at(0)->get_shape(), shape);
+
+        auto multiply = g->get_results().at(0)->get_argument(0);
+        auto a = as_type_ptr<op::Constant>(multiply->get_argument(0)->get_argument(1));
+        auto b = as_type_ptr<op::Constant>(g->get_results().at(1)->get_argument(0));
+        auto c = as_type_ptr<op::Constant>(multiply->get_argument(1));
+        ASSERT_NE(a, nullptr);
+        ASSERT_NE(b, nullptr);
+        ASSERT_NE(c, nullptr);
+        EXPECT_EQ((vector<float>{1, 2, 3, 4, 5, 6, 7, 8}), a->get_vector<float>());
+        EXPECT_EQ((vector<int32_t>{8, 7, 6, 5, 4, 3, 2, -1}), b->get_vector<int32_t>());
+        EXPECT_EQ(vector<float>(8, -1.5f), c->get_vector<float>());
+        // The weights section is page aligned so the Constants data is too
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(a->get_data_ptr()) % 4096, 0);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(b->get_data_ptr()) % 4096, 0);
+    };
+
+    // The format is detected from the data, whether it is read from a stream, a mapped
+    // file or a string
+    stringstream in(data);
+    check(deserialize(in));
+    check(deserialize(tmp_file));
+    check(deserialize(data));
+    file_util::remove_file(tmp_file);
+
+    // Deserialized from memory, the Function does not refer to the data
+    vector<char> buffer(data.begin(), data.end());
+    auto from_memory = deserialize(buffer.data(), buffer.size());
+    fill(buffer.begin(), buffer.end(), 0);
+    check(from_memory);
+
+    EXPECT_THROW(deserialize(data.substr(0, data.size() / 2)), ngraph_error);
+}
+
 TEST(benchmark, serialize)
 {
     stopwatch timer;